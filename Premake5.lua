@@ -398,6 +398,15 @@ end
 -- Add the User Projects and Sample Projects
 AddProjects("Projects", projects)
 
+-- Projects can have extra tools with their own premake file (ex: benchmarks), these go beside the project's src folder
+for k, proj in pairs(projects) do
+	local benchDir = path.join(proj, "benchmark")
+	if os.isfile(path.join(benchDir, "premake5.lua")) then
+		premake.info(" Adding benchmark: " .. path.getrelative(rootDir, benchDir))
+		include(benchDir)
+	end
+end
+
 for k, proj in pairs(sampleGroups) do
 	local name = path.getbasename(proj);
     local samples = os.matchdirs(proj .. "/*")
@@ -0,0 +1,88 @@
+-- Console app that times the game's engine code against the code it replaced (see src/main.cpp)
+-- This builds all of the game's source except for it's main.cpp, so that the benchmarks run
+-- the exact same code as the game
+
+-- Paths in the shared lists are relative to the workspace, so we need to make them absolute
+function FromWorkspace(items)
+	local result = {}
+	for k, v in pairs(items) do
+		if string.find(v, "/") then
+			table.insert(result, path.join(_MAIN_SCRIPT_DIR, v))
+		else
+			table.insert(result, v)
+		end
+	end
+	return result
+end
+
+local benchIncludes = { "src", "../src" }
+for k, v in pairs(ProjIncludes) do
+	-- The first include is reserved for whichever project was generated last
+	if k > 1 then
+		table.insert(benchIncludes, path.join(_MAIN_SCRIPT_DIR, v))
+	end
+end
+
+project "Frog Frontier Benchmark"
+	location "."
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	-- Sets RuntimLibrary to MultiThreaded (non DLL version for static linking)
+	staticruntime "on"
+
+	targetdir ("%{wks.location}\\bin\\" .. outputdir .. "\\%{prj.name}")
+	objdir ("%{wks.location}\\obj\\" .. outputdir .. "\\%{prj.name}")
+
+	-- The benchmarks run on the game's assets, so we run from the game's resource folder
+	debugdir "../res"
+
+	postbuildcommands {
+		-- The game's dlls need to sit beside the benchmark
+		"(xcopy /Q /E /Y /I /C \"%{wks.location}shared_assets\\dll\" \"%{cfg.targetdir}\")",
+		"(xcopy /Q /E /Y /I /C \"%{wks.location}dependencies\\dll\" \"%{cfg.targetdir}\")"
+	}
+
+	files {
+		"src/**.h",
+		"src/**.cpp",
+		"../src/**.h",
+		"../src/**.cpp",
+		"../src/**.c",
+		"../src/**.hpp"
+	}
+
+	-- We have our own entry point
+	removefiles {
+		"../src/main.cpp"
+	}
+
+	defines {
+		"_CRT_SECURE_NO_WARNINGS"
+	}
+
+	includedirs(benchIncludes)
+
+	links(FromWorkspace(ProjLinks))
+
+	buildoptions { "/bigobj" }
+
+	filter "system:windows"
+		systemversion "latest"
+
+		defines {
+			"GLFW_INCLUDE_NONE",
+			"WINDOWS"
+		}
+
+	filter "configurations:Debug"
+		runtime "Debug"
+		symbols "on"
+
+		links(FromWorkspace(DependenciesDebug))
+
+	filter "configurations:Release"
+		runtime "Release"
+		optimize "on"
+
+		links(FromWorkspace(DependenciesRelease))
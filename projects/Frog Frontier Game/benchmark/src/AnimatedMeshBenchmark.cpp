@@ -0,0 +1,114 @@
+#include "Benchmark.h"
+#include <map>
+#include <set>
+
+#include "Gameplay/AnimatedMeshResource.h"
+#include "Utils/ObjLoader.h"
+#include "Utils/OptimizedObjLoader.h"
+
+using namespace Gameplay;
+
+namespace Benchmark {
+	/// <summary>
+	/// Groups the keyframe OBJs in the working directory into clips by their prefix, the
+	/// keyframes are exported as Name_000001.obj, Name_000002.obj, etc...
+	/// </summary>
+	static std::vector<AnimatedMeshResource::Clip> FindClips() {
+		std::map<std::string, AnimatedMeshResource::Clip> clips;
+		for (const std::string& file : FindFiles(".obj")) {
+			size_t split = file.rfind('_');
+			if (split != std::string::npos && file.find_first_not_of("0123456789", split + 1) == file.size() - 4) {
+				AnimatedMeshResource::Clip& clip = clips[file.substr(0, split)];
+				clip.Name = file.substr(0, split);
+				clip.Frames.push_back(file);
+			}
+		}
+
+		// Some sequences end on a frame from a different model, which AnimatedMeshResource would
+		// skip, so we leave those out to compare against the same frames
+		std::vector<AnimatedMeshResource::Clip> result;
+		for (auto& [name, clip] : clips) {
+			AnimatedMeshResource::Clip& filtered = result.emplace_back();
+			filtered.Name = name;
+			size_t positionCount = 0, uvCount = 0;
+			for (const std::string& file : clip.Frames) {
+				std::vector<glm::vec3> positions, normals;
+				std::vector<glm::vec2> uvs;
+				std::vector<glm::ivec3> vertices;
+				OptimizedObjLoader::ParseAttributes(file, positions, uvs, normals, vertices);
+				if (filtered.Frames.empty()) {
+					positionCount = positions.size();
+					uvCount = uvs.size();
+				} else if (positions.size() != positionCount || uvs.size() != uvCount) {
+					LOG_INFO("Leaving \"{}\" out of \"{}\", it was exported from a different model", file, name);
+					continue;
+				}
+				filtered.Frames.push_back(file);
+			}
+		}
+		return result;
+	}
+
+	/// <summary>
+	/// Gets the number of bytes of GPU memory that ObjLoader would use for each of the given
+	/// keyframes, with every unique file loaded once
+	/// </summary>
+	static size_t MeasureObjMeshBytes(const AnimatedMeshResource::Clip& clip) {
+		size_t result = 0;
+		std::set<std::string> files(clip.Frames.begin(), clip.Frames.end());
+		for (const std::string& file : files) {
+			MeshBuilder<VertexPosNormTexCol> mesh;
+			OptimizedObjLoader::ParseFile(file, mesh);
+			size_t indexSize = mesh.GetVertexCount() <= UINT16_MAX ? sizeof(uint16_t) : sizeof(uint32_t);
+			result += mesh.GetVertexCount() * sizeof(VertexPosNormTexCol) + mesh.GetIndexCount() * indexSize;
+		}
+		return result;
+	}
+
+	void RunAnimatedMesh() {
+		std::vector<AnimatedMeshResource::Clip> clips = FindClips();
+		LOG_INFO("Loading {} keyframe sequences as one mesh per OBJ and as an AnimatedMeshResource", clips.size());
+
+		size_t objTotal = 0;
+		size_t bakedTotal = 0;
+		double baselineTotal = 0.0;
+		double optimizedTotal = 0.0;
+		for (const AnimatedMeshResource::Clip& clip : clips) {
+			// Each sequence is its own model, so each one gets its own resource
+			std::vector<VertexArrayObject::Sptr> frames;
+			double baselineMs = Time([&]() {
+				frames.clear();
+				for (const std::string& file : clip.Frames) {
+					frames.push_back(ObjLoader::LoadFromFile(file));
+				}
+			}, 1);
+			AnimatedMeshResource::Sptr baked;
+			double optimizedMs = Time([&]() {
+				baked = std::make_shared<AnimatedMeshResource>(std::vector<AnimatedMeshResource::Clip>{ clip });
+			}, 1);
+			baselineTotal += baselineMs;
+			optimizedTotal += optimizedMs;
+
+			size_t objBytes = MeasureObjMeshBytes(clip);
+			size_t bakedBytes = baked->GetMemoryUsage();
+			objTotal += objBytes;
+			bakedTotal += bakedBytes;
+
+			if (baked->GetObjMeshBytes() != objBytes) {
+				Fail("AnimatedMeshResource estimated " + std::to_string(baked->GetObjMeshBytes()) + " bytes as one mesh per OBJ for \"" +
+					clip.Name + "\", but the meshes use " + std::to_string(objBytes) + " bytes");
+			}
+			if (baked->Clips[0].FrameCount != clip.Frames.size()) {
+				Fail("AnimatedMeshResource skipped some of the keyframes in \"" + clip.Name + "\"");
+			}
+			if (bakedBytes == 0 || bakedBytes >= objBytes) {
+				Fail("AnimatedMeshResource for \"" + clip.Name + "\" does not use less memory than one mesh per OBJ");
+			}
+
+			Report(clip.Name + " (" + std::to_string(clip.Frames.size()) + " frames)", baselineMs, optimizedMs);
+			ReportMemory(clip.Name, objBytes, bakedBytes);
+		}
+		Report("Total (" + std::to_string(clips.size()) + " clips)", baselineTotal, optimizedTotal);
+		ReportMemory("Total", objTotal, bakedTotal);
+	}
+}
@@ -0,0 +1,154 @@
+#include "Benchmark.h"
+#include <filesystem>
+#include <algorithm>
+
+#include "Utils/ResourceManager/ResourceManager.h"
+#include "Gameplay/Material.h"
+#include "Gameplay/AnimatedMeshResource.h"
+#include "Gameplay/Scene.h"
+#include "Gameplay/Components/Camera.h"
+#include "Gameplay/Components/RotatingBehaviour.h"
+#include "Gameplay/Components/RenderComponent.h"
+#include "Gameplay/Components/MaterialSwapBehaviour.h"
+#include "Gameplay/Components/Animator.h"
+#include "Gameplay/Physics/RigidBody.h"
+#include "Gameplay/Physics/TriggerVolume.h"
+#include "Gameplay/Physics/Colliders/BoxCollider.h"
+
+using namespace Gameplay;
+using namespace Gameplay::Physics;
+
+namespace Benchmark {
+	static bool s_failed = false;
+	static bool s_gameInitialized = false;
+	// The stand-in levels FindLevel has written this run, removed by RemoveGeneratedLevels
+	static std::vector<std::string> s_generatedLevels;
+
+	// The number of objects in the generated level, about as many as our biggest levels
+	static const int GENERATED_LEVEL_OBJECTS = 800;
+
+	void Report(const std::string& name, double baselineMs, double optimizedMs) {
+		LOG_INFO("{:<40} {:>10.3f}ms -> {:>10.3f}ms ({:.2f}x)", name, baselineMs, optimizedMs, optimizedMs > 0.0 ? baselineMs / optimizedMs : 0.0);
+	}
+
+	void ReportMemory(const std::string& name, size_t baselineBytes, size_t optimizedBytes) {
+		LOG_INFO("{:<40} {:>10} bytes -> {:>10} bytes ({:.2f}x smaller)", name, baselineBytes, optimizedBytes, optimizedBytes > 0 ? (double)baselineBytes / optimizedBytes : 0.0);
+	}
+
+	void Fail(const std::string& message) {
+		LOG_ERROR("{}", message);
+		s_failed = true;
+	}
+
+	bool HasFailed() {
+		return s_failed;
+	}
+
+	std::vector<std::string> FindFiles(const std::string& extension) {
+		std::vector<std::string> result;
+		for (const auto& entry : std::filesystem::directory_iterator(".")) {
+			if (entry.is_regular_file() && entry.path().extension() == extension) {
+				result.push_back(entry.path().filename().string());
+			}
+		}
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	void InitGame() {
+		if (s_gameInitialized) {
+			return;
+		}
+		s_gameInitialized = true;
+
+		// These should match the types registered in the game's main.cpp
+		ResourceManager::Init();
+		ResourceManager::RegisterType<Texture2D>();
+		ResourceManager::RegisterType<Material, Shader, Texture2D>();
+		ResourceManager::RegisterType<MeshResource>();
+		ResourceManager::RegisterType<AnimatedMeshResource>();
+		ResourceManager::RegisterType<Shader>();
+
+		ComponentManager::RegisterType<Camera>();
+		ComponentManager::RegisterType<RenderComponent>();
+		ComponentManager::RegisterType<RigidBody>();
+		ComponentManager::RegisterType<TriggerVolume>();
+		ComponentManager::RegisterType<RotatingBehaviour>();
+		ComponentManager::RegisterType<MaterialSwapBehaviour>();
+		ComponentManager::RegisterType<Animator>();
+
+		if (std::filesystem::exists("manifest.json")) {
+			ResourceManager::LoadManifest("manifest.json");
+		}
+	}
+
+	std::string FindLevel(const std::string& name) {
+		InitGame();
+		if (std::filesystem::exists(name) && std::filesystem::exists("manifest.json")) {
+			return name;
+		}
+
+		// The generated level only lives for this run, since it's resources are not in the manifest,
+		// so it goes in the temp directory rather than next to the game's levels
+		std::string path = (std::filesystem::temp_directory_path() / ("frog_frontier_benchmark_" + name)).string();
+		if (std::find(s_generatedLevels.begin(), s_generatedLevels.end(), path) != s_generatedLevels.end()) {
+			return path;
+		}
+		LOG_WARN("\"{}\" has not been saved yet, run the game from res/ to save it. Using a generated level with {} objects", name, GENERATED_LEVEL_OBJECTS);
+
+		Scene::Sptr scene = std::make_shared<Scene>();
+		scene->BaseShader = ResourceManager::CreateAsset<Shader>(std::unordered_map<ShaderPartType, std::string>{
+			{ ShaderPartType::Vertex, "shaders/vertex_shader.glsl" },
+			{ ShaderPartType::Fragment, "shaders/frag_blinn_phong_textured.glsl" }
+		});
+
+		GameObject::Sptr camera = scene->CreateGameObject("Main Camera");
+		{
+			camera->SetPostion(glm::vec3(0.0f, 0.0f, 10.0f));
+			scene->MainCamera = camera->Add<Camera>();
+		}
+
+		// A grid of props, with a mix of the components our levels use
+		for (int ix = 0; ix < GENERATED_LEVEL_OBJECTS; ix++) {
+			GameObject::Sptr object = scene->CreateGameObject("Object " + std::to_string(ix));
+			object->SetPostion(glm::vec3((ix % 40) * 3.0f, (ix / 40) * 3.0f, 0.0f));
+			object->SetRotation(glm::vec3(0.0f, 0.0f, (float)ix));
+			object->Add<RenderComponent>();
+
+			RigidBody::Sptr physics = object->Add<RigidBody>();
+			physics->AddCollider(BoxCollider::Create());
+
+			if (ix % 4 == 0) {
+				RotatingBehaviour::Sptr rotate = object->Add<RotatingBehaviour>();
+				rotate->RotationSpeed = glm::vec3(0.0f, 0.0f, 90.0f);
+			}
+			if (ix % 10 == 0) {
+				TriggerVolume::Sptr volume = object->Add<TriggerVolume>();
+				volume->AddCollider(BoxCollider::Create(glm::vec3(2.0f)));
+			}
+		}
+
+		for (int ix = 0; ix < 8; ix++) {
+			Light& light = scene->Lights.emplace_back();
+			light.Position = glm::vec3(ix * 15.0f, ix * 7.5f, 5.0f);
+			light.Color = glm::vec3(1.0f);
+			light.Range = 20.0f;
+		}
+
+		scene->Save(path);
+		s_generatedLevels.push_back(path);
+		return path;
+	}
+
+	void RemoveGeneratedLevels() {
+		for (const std::string& path : s_generatedLevels) {
+			std::error_code error;
+			std::filesystem::remove(path, error);
+		}
+		s_generatedLevels.clear();
+	}
+
+	void SetQuiet(bool quiet) {
+		Logger::GetLogger()->set_level(quiet ? spdlog::level::warn : spdlog::level::trace);
+	}
+}
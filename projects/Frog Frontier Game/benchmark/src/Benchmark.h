@@ -0,0 +1,122 @@
+#pragma once
+#include <chrono>
+#include <string>
+#include <vector>
+#include <functional>
+#include <Logging.h>
+
+/// <summary>
+/// Helpers shared by the benchmarks. Each benchmark times the game's current code against the
+/// code it replaced on the game's own assets, and checks that both give the same results
+/// </summary>
+namespace Benchmark {
+	/// <summary>
+	/// A named benchmark that can be picked from the command line
+	/// </summary>
+	struct Entry {
+		std::string           Name;
+		std::string           Description;
+		std::function<void()> Run;
+	};
+
+	/// <summary>
+	/// Runs a function a number of times, and returns the fastest run in milliseconds. We take
+	/// the fastest run since anything slower was held up by something other than our code
+	/// </summary>
+	/// <param name="func">The function to time</param>
+	/// <param name="runs">The number of times to run the function</param>
+	template <typename Func>
+	double Time(Func&& func, int runs = 5) {
+		double best = 0.0;
+		for (int ix = 0; ix < runs; ix++) {
+			auto start = std::chrono::high_resolution_clock::now();
+			func();
+			auto end = std::chrono::high_resolution_clock::now();
+			double elapsed = std::chrono::duration<double, std::milli>(end - start).count();
+			best = (ix == 0 || elapsed < best) ? elapsed : best;
+		}
+		return best;
+	}
+
+	/// <summary>
+	/// Logs the timings of the old and new code for a test, and how much faster the new code is
+	/// </summary>
+	/// <param name="name">The name of the test</param>
+	/// <param name="baselineMs">The time taken by the code that was replaced</param>
+	/// <param name="optimizedMs">The time taken by the current code</param>
+	void Report(const std::string& name, double baselineMs, double optimizedMs);
+	/// <summary>
+	/// Logs how much memory the old and new code used for a test, and how much smaller the new code is
+	/// </summary>
+	/// <param name="name">The name of the test</param>
+	/// <param name="baselineBytes">The bytes used by the code that was replaced</param>
+	/// <param name="optimizedBytes">The bytes used by the current code</param>
+	void ReportMemory(const std::string& name, size_t baselineBytes, size_t optimizedBytes);
+
+	/// <summary>
+	/// Logs an error and marks the run as failed, so the benchmark exits with an error code
+	/// </summary>
+	void Fail(const std::string& message);
+	/// <summary>
+	/// Returns true if any benchmark has called Fail
+	/// </summary>
+	bool HasFailed();
+
+	/// <summary>
+	/// Gets the paths of all the files with the given extension in the working directory,
+	/// sorted so that runs are repeatable
+	/// </summary>
+	std::vector<std::string> FindFiles(const std::string& extension);
+
+	/// <summary>
+	/// Registers the game's resource and component types, and loads manifest.json if there is
+	/// one, the same way the game does on startup. Safe to call more than once
+	/// </summary>
+	void InitGame();
+	/// <summary>
+	/// Finds a level to run scene benchmarks on. The levels are built in the game's main.cpp and
+	/// saved into res/ when the game runs, so they are not checked in. If the level has not been
+	/// saved yet, this generates a stand-in level with the same kinds of components in the temp
+	/// directory
+	/// </summary>
+	/// <param name="name">The level to look for (ex: Level1.json)</param>
+	/// <returns>The path of the level, or of the generated level if it was not found</returns>
+	std::string FindLevel(const std::string& name);
+	/// <summary>
+	/// Deletes the stand-in levels that FindLevel generated, should be called before exiting
+	/// </summary>
+	void RemoveGeneratedLevels();
+	/// <summary>
+	/// Hides info and trace logs, for benchmarks that load the same thing many times
+	/// </summary>
+	/// <param name="quiet">True to hide info logs, false to show them again</param>
+	void SetQuiet(bool quiet);
+
+	/// <summary>
+	/// Compares the parsers in ObjLoader and OptimizedObjLoader on every OBJ in res/
+	/// </summary>
+	void RunObjLoader();
+	/// <summary>
+	/// Compares loading each keyframe sequence in res/ as one mesh per OBJ against baking it into
+	/// an AnimatedMeshResource, in both load time and GPU memory
+	/// </summary>
+	void RunAnimatedMesh();
+	/// <summary>
+	/// Compares updating 10k transforms stored per object against updating them in a TransformStore
+	/// </summary>
+	void RunTransformStore();
+	/// <summary>
+	/// Reloads Level1.json 1000 times, and checks that the component pools stay the same size
+	/// and that handles into unloaded scenes stop resolving
+	/// </summary>
+	void RunSceneReload();
+	/// <summary>
+	/// Compares walking 800 render components through the old weak_ptr component store against
+	/// the dense pools in ComponentManager
+	/// </summary>
+	void RunComponentPools();
+	/// <summary>
+	/// Compares loading Level4.json by parsing the whole document against Scene::Load's streaming reader
+	/// </summary>
+	void RunSceneLoad();
+}
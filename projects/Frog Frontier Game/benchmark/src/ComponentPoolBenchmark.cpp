@@ -0,0 +1,80 @@
+#include "Benchmark.h"
+#include <typeindex>
+#include <unordered_map>
+
+#include "Gameplay/Components/ComponentManager.h"
+#include "Gameplay/Components/RenderComponent.h"
+
+using namespace Gameplay;
+
+namespace Benchmark {
+	// The number of components to iterate, about as many renderers as our biggest levels
+	static const int COMPONENT_COUNT = 800;
+	// The number of times the game walks the pools each frame (physics, rendering and the render queue)
+	static const int PASSES_PER_FRAME = 4;
+
+	/// <summary>
+	/// The component store that ComponentManager used before the dense pools, components of each
+	/// type were kept as weak pointers in a map keyed on their type_index
+	/// </summary>
+	class WeakPtrComponentStore {
+	public:
+		template <typename ComponentType>
+		void Add(const std::shared_ptr<ComponentType>& component) {
+			_components[std::type_index(typeid(ComponentType))].push_back(component);
+		}
+
+		template <typename ComponentType>
+		void Each(std::function<void(const std::shared_ptr<ComponentType>&)> callback, bool includeDisabled = false) {
+			std::type_index type = std::type_index(typeid(ComponentType));
+			for (auto& wptr : _components[type]) {
+				std::shared_ptr<IComponent> sptr = wptr.lock();
+				if (sptr && sptr->IsEnabled | includeDisabled) {
+					callback(std::dynamic_pointer_cast<ComponentType>(sptr));
+				}
+			}
+		}
+
+	private:
+		std::unordered_map<std::type_index, std::vector<std::weak_ptr<IComponent>>> _components;
+	};
+
+	void RunComponentPools() {
+		InitGame();
+		LOG_INFO("Walking {} render components {} times per frame with weak_ptr vectors and with the dense pools", COMPONENT_COUNT, PASSES_PER_FRAME);
+
+		// Some disabled components, so that the enabled check has work to do
+		std::vector<RenderComponent::Sptr> components;
+		WeakPtrComponentStore store;
+		for (int ix = 0; ix < COMPONENT_COUNT; ix++) {
+			RenderComponent::Sptr component = ComponentManager::Create<RenderComponent>();
+			component->IsEnabled = ix % 8 != 0;
+			store.Add(component);
+			components.push_back(component);
+		}
+
+		// Both sides count what they visit, so that the loops can't be optimized away
+		size_t baselineVisited = 0;
+		double baselineMs = Time([&]() {
+			for (int pass = 0; pass < PASSES_PER_FRAME; pass++) {
+				store.Each<RenderComponent>([&](const RenderComponent::Sptr& renderer) {
+					baselineVisited += renderer->GetMeshResource() == nullptr ? 1 : 2;
+				});
+			}
+		}, 100);
+
+		size_t optimizedVisited = 0;
+		double optimizedMs = Time([&]() {
+			for (int pass = 0; pass < PASSES_PER_FRAME; pass++) {
+				ComponentManager::Each<RenderComponent>([&](RenderComponent* renderer) {
+					optimizedVisited += renderer->GetMeshResource() == nullptr ? 1 : 2;
+				});
+			}
+		}, 100);
+
+		if (baselineVisited != optimizedVisited) {
+			Fail("The dense pools visited " + std::to_string(optimizedVisited) + " components, the weak_ptr store visited " + std::to_string(baselineVisited));
+		}
+		Report("Each<RenderComponent> (" + std::to_string(COMPONENT_COUNT) + " components)", baselineMs, optimizedMs);
+	}
+}
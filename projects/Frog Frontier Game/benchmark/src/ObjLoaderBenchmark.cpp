@@ -0,0 +1,61 @@
+#include "Benchmark.h"
+#include <cstring>
+
+#include "Utils/ObjLoader.h"
+#include "Utils/OptimizedObjLoader.h"
+
+namespace Benchmark {
+	// The attribute lists read out of an OBJ file
+	struct ObjAttributes {
+		std::vector<glm::vec3>  Positions;
+		std::vector<glm::vec2>  Uvs;
+		std::vector<glm::vec3>  Normals;
+		std::vector<glm::ivec3> Vertices;
+	};
+
+	// Compares two attribute lists bit for bit, both parsers should round to the same floats
+	template <typename T>
+	static bool SameData(const std::vector<T>& a, const std::vector<T>& b) {
+		return a.size() == b.size() && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+	}
+
+	void RunObjLoader() {
+		std::vector<std::string> files = FindFiles(".obj");
+		LOG_INFO("Parsing {} OBJ files with ObjLoader and OptimizedObjLoader", files.size());
+
+		double baselineTotal = 0.0;
+		double optimizedTotal = 0.0;
+		for (const std::string& file : files) {
+			ObjAttributes baseline, optimized;
+			double baselineMs = Time([&]() {
+				baseline = ObjAttributes();
+				ObjLoader::ParseAttributes(file, baseline.Positions, baseline.Uvs, baseline.Normals, baseline.Vertices);
+			});
+			double optimizedMs = Time([&]() {
+				optimized = ObjAttributes();
+				OptimizedObjLoader::ParseAttributes(file, optimized.Positions, optimized.Uvs, optimized.Normals, optimized.Vertices);
+			});
+			baselineTotal += baselineMs;
+			optimizedTotal += optimizedMs;
+
+			if (!SameData(baseline.Positions, optimized.Positions) || !SameData(baseline.Uvs, optimized.Uvs) ||
+				!SameData(baseline.Normals, optimized.Normals) || !SameData(baseline.Vertices, optimized.Vertices)) {
+				Fail("OptimizedObjLoader does not match ObjLoader for \"" + file + "\"");
+			}
+
+			// The merged vertices are built by the same code, but check them anyways in case the
+			// attributes match and something upstream of BuildMesh doesn't
+			MeshBuilder<VertexPosNormTexCol> baselineMesh, optimizedMesh;
+			ObjLoader::BuildMesh(baseline.Positions, baseline.Uvs, baseline.Normals, baseline.Vertices, baselineMesh);
+			OptimizedObjLoader::ParseFile(file, optimizedMesh);
+			if (baselineMesh.GetVertexCount() != optimizedMesh.GetVertexCount() || baselineMesh.GetIndexCount() != optimizedMesh.GetIndexCount() ||
+				memcmp(baselineMesh.GetVertexDataPtr(), optimizedMesh.GetVertexDataPtr(), baselineMesh.GetVertexCount() * sizeof(VertexPosNormTexCol)) != 0 ||
+				memcmp(baselineMesh.GetIndexDataPtr(), optimizedMesh.GetIndexDataPtr(), baselineMesh.GetIndexCount() * sizeof(uint32_t)) != 0) {
+				Fail("OptimizedObjLoader built a different mesh than ObjLoader for \"" + file + "\"");
+			}
+
+			Report(file, baselineMs, optimizedMs);
+		}
+		Report("Total (" + std::to_string(files.size()) + " files)", baselineTotal, optimizedTotal);
+	}
+}
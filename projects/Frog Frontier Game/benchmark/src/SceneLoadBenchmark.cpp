@@ -0,0 +1,40 @@
+#include "Benchmark.h"
+
+#include "Gameplay/Scene.h"
+#include "Utils/FileHelpers.h"
+
+using namespace Gameplay;
+
+namespace Benchmark {
+	void RunSceneLoad() {
+		std::string level = FindLevel("Level4.json");
+		LOG_INFO("Loading \"{}\" with a full JSON document and with the streaming reader", level);
+
+		// Only one copy of the level is loaded at a time, since the main camera is looked up by GUID
+		Scene::Sptr scene = nullptr;
+		SetQuiet(true);
+		double baselineMs = Time([&]() {
+			scene = nullptr;
+			scene = Scene::FromJson(nlohmann::json::parse(FileHelpers::ReadFile(level)));
+		});
+		nlohmann::json baseline = scene->ToJson();
+
+		double optimizedMs = Time([&]() {
+			scene = nullptr;
+			scene = Scene::Load(level);
+		});
+		if (scene == nullptr) {
+			SetQuiet(false);
+			Fail("Scene::Load could not load \"" + level + "\"");
+			return;
+		}
+		nlohmann::json optimized = scene->ToJson();
+		scene = nullptr;
+		SetQuiet(false);
+
+		if (baseline != optimized) {
+			Fail("Scene::Load and Scene::FromJson loaded different scenes from \"" + level + "\"");
+		}
+		Report(level, baselineMs, optimizedMs);
+	}
+}
@@ -0,0 +1,106 @@
+#include "Benchmark.h"
+
+#include "Gameplay/Scene.h"
+#include "Gameplay/Components/Camera.h"
+#include "Gameplay/Components/RotatingBehaviour.h"
+#include "Gameplay/Components/RenderComponent.h"
+#include "Gameplay/Components/MaterialSwapBehaviour.h"
+#include "Gameplay/Components/Animator.h"
+#include "Gameplay/Physics/RigidBody.h"
+#include "Gameplay/Physics/TriggerVolume.h"
+
+using namespace Gameplay;
+using namespace Gameplay::Physics;
+
+namespace Benchmark {
+	// The number of times to reload the level
+	static const int RELOAD_COUNT = 1000;
+
+	/// <summary>
+	/// The number of live components and pool slots for every component type the game registers
+	/// </summary>
+	struct PoolSizes {
+		std::vector<size_t> Counts;
+		std::vector<size_t> Slots;
+
+		bool operator==(const PoolSizes& other) const { return Counts == other.Counts && Slots == other.Slots; }
+		bool operator!=(const PoolSizes& other) const { return !(*this == other); }
+	};
+
+	template <typename ... TComponents>
+	static PoolSizes GetPoolSizes() {
+		PoolSizes result;
+		result.Counts = { ComponentManager::GetCount<TComponents>()... };
+		result.Slots = { ComponentManager::GetSlotCount<TComponents>()... };
+		return result;
+	}
+
+	static PoolSizes GetGamePoolSizes() {
+		return GetPoolSizes<Camera, RenderComponent, RigidBody, TriggerVolume, RotatingBehaviour, MaterialSwapBehaviour, Animator>();
+	}
+
+	/// <summary>
+	/// Gets a handle to the first render component in a scene
+	/// </summary>
+	static ComponentHandle<RenderComponent> GetFirstRenderer(const Scene::Sptr& scene) {
+		ComponentHandle<RenderComponent> result;
+		ComponentManager::Each<RenderComponent>([&](RenderComponent* renderer) {
+			if (result.Get() == nullptr && renderer->GetGameObject()->GetScene() == scene.get()) {
+				result = ComponentManager::GetHandle(renderer);
+			}
+		}, true);
+		return result;
+	}
+
+	void RunSceneReload() {
+		std::string level = FindLevel("Level1.json");
+		LOG_INFO("Reloading \"{}\" {} times, and checking that the component pools stay the same size", level, RELOAD_COUNT);
+
+		// The first load sets how big the pools should be from now on
+		Scene::Sptr scene = Scene::Load(level);
+		if (scene == nullptr) {
+			Fail("Could not load \"" + level + "\"");
+			return;
+		}
+		PoolSizes expected = GetGamePoolSizes();
+		ComponentHandle<RenderComponent> firstHandle = GetFirstRenderer(scene);
+		if (firstHandle.Get() == nullptr) {
+			Fail("\"" + level + "\" has no render components to make handles to");
+		}
+
+		SetQuiet(true);
+		double totalMs = 0.0;
+		for (int ix = 0; ix < RELOAD_COUNT && !HasFailed(); ix++) {
+			ComponentHandle<RenderComponent> oldHandle = GetFirstRenderer(scene);
+			totalMs += Time([&]() {
+				// Free the old scene first, like SceneCache does when it evicts a level
+				scene = nullptr;
+				scene = Scene::Load(level);
+			}, 1);
+
+			// Handles into the unloaded scene must not resolve to the components that took their slots
+			if (oldHandle.Get() != nullptr || firstHandle.Get() != nullptr) {
+				Fail("A handle to a component in an unloaded scene still resolves after " + std::to_string(ix + 1) + " reloads");
+			}
+			ComponentHandle<RenderComponent> newHandle = GetFirstRenderer(scene);
+			if (newHandle.Get() == nullptr || newHandle.Get()->GetGameObject()->GetScene() != scene.get()) {
+				Fail("A handle to a component in the loaded scene does not resolve after " + std::to_string(ix + 1) + " reloads");
+			}
+
+			PoolSizes sizes = GetGamePoolSizes();
+			if (sizes != expected) {
+				Fail("The component pools changed size after " + std::to_string(ix + 1) + " reloads");
+				for (size_t type = 0; type < sizes.Counts.size(); type++) {
+					LOG_ERROR("\tType {}: {} components in {} slots, expected {} in {}", type, sizes.Counts[type], sizes.Slots[type], expected.Counts[type], expected.Slots[type]);
+				}
+			}
+		}
+		SetQuiet(false);
+
+		scene = nullptr;
+		if (GetGamePoolSizes().Counts != std::vector<size_t>(expected.Counts.size(), 0)) {
+			Fail("The component pools are not empty after unloading the level");
+		}
+		LOG_INFO("{:<40} {:>10.3f}ms per reload", "Reload \"" + level + "\"", totalMs / RELOAD_COUNT);
+	}
+}
@@ -0,0 +1,150 @@
+#include "Benchmark.h"
+#include <random>
+
+#include "Gameplay/TransformStore.h"
+#include "GLM/gtc/matrix_transform.hpp"
+
+using namespace Gameplay;
+
+namespace Benchmark {
+	// The number of transforms to update, roughly the size of our biggest levels
+	static const int TRANSFORM_COUNT = 10000;
+
+	/// <summary>
+	/// The transform that every game object used to store, before TransformStore. Each object
+	/// was allocated on it's own and recomputed it's matrix when it was asked for it
+	/// </summary>
+	struct ObjectTransform {
+		typedef std::shared_ptr<ObjectTransform> Sptr;
+
+		glm::quat Rotation = glm::quat(glm::vec3(0.0f));
+		glm::vec3 Position = glm::vec3(0.0f);
+		glm::vec3 Scale = glm::vec3(1.0f);
+		glm::mat4 Transform = glm::mat4(1.0f);
+		bool      IsDirty = true;
+
+		const glm::mat4& GetTransform() {
+			if (IsDirty) {
+				Transform = glm::translate(glm::mat4(1.0f), Position) * glm::mat4_cast(Rotation) * glm::scale(glm::mat4(1.0f), Scale);
+				IsDirty = false;
+			}
+			return Transform;
+		}
+	};
+
+	// Returns true if two matrices are the same, give or take some rounding
+	template <typename T>
+	static bool SameMatrix(const T& a, const T& b) {
+		for (int col = 0; col < T::length(); col++) {
+			for (int row = 0; row < T::length(); row++) {
+				if (glm::abs(a[col][row] - b[col][row]) > 1e-4f * glm::max(1.0f, glm::abs(a[col][row]))) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Times moving some fraction of the transforms then reading every world and normal matrix,
+	/// the way the render loop does
+	/// </summary>
+	/// <param name="name">The name to report the test as</param>
+	/// <param name="moveEvery">Moves every n'th transform each frame</param>
+	static void RunTransformTest(const std::string& name, int moveEvery) {
+		std::mt19937 random(1234);
+		std::uniform_real_distribution<float> range(-100.0f, 100.0f);
+		std::uniform_real_distribution<float> scaleRange(0.5f, 2.0f);
+
+		std::vector<glm::vec3> positions(TRANSFORM_COUNT);
+		std::vector<glm::quat> rotations(TRANSFORM_COUNT);
+		std::vector<glm::vec3> scales(TRANSFORM_COUNT);
+		for (int ix = 0; ix < TRANSFORM_COUNT; ix++) {
+			positions[ix] = glm::vec3(range(random), range(random), range(random));
+			rotations[ix] = glm::quat(glm::radians(glm::vec3(range(random), range(random), range(random))));
+			// Mix uniform and non-uniform scales, since the store handles them differently
+			float uniform = scaleRange(random);
+			scales[ix] = (ix % 2 == 0) ? glm::vec3(uniform) : glm::vec3(scaleRange(random), scaleRange(random), scaleRange(random));
+		}
+
+		std::vector<ObjectTransform::Sptr> objects;
+		TransformStore store;
+		std::vector<TransformStore::Index> indices;
+		for (int ix = 0; ix < TRANSFORM_COUNT; ix++) {
+			objects.push_back(std::make_shared<ObjectTransform>());
+			indices.push_back(store.Allocate());
+		}
+
+		// Writes every transform on both sides, so that both start from the same state
+		auto setAll = [&]() {
+			for (int ix = 0; ix < TRANSFORM_COUNT; ix++) {
+				objects[ix]->Position = positions[ix];
+				objects[ix]->Rotation = rotations[ix];
+				objects[ix]->Scale = scales[ix];
+				objects[ix]->IsDirty = true;
+				store.GetPosition(indices[ix]) = positions[ix];
+				store.GetRotation(indices[ix]) = rotations[ix];
+				store.GetScale(indices[ix]) = scales[ix];
+				store.MarkDirty(indices[ix]);
+			}
+		};
+		setAll();
+
+		// Both sides write their matrices into a sink, so the reads can't be optimized away
+		glm::mat4 worldSink(0.0f);
+		glm::mat3 normalSink(0.0f);
+		int frame = 0;
+		double baselineMs = Time([&]() {
+			for (int ix = frame % moveEvery; ix < TRANSFORM_COUNT; ix += moveEvery) {
+				ObjectTransform& object = *objects[ix];
+				object.Position = positions[ix];
+				object.Rotation = rotations[ix];
+				object.Scale = scales[ix];
+				object.IsDirty = true;
+			}
+			for (const ObjectTransform::Sptr& object : objects) {
+				const glm::mat4& world = object->GetTransform();
+				worldSink += world;
+				normalSink += glm::mat3(glm::transpose(glm::inverse(world)));
+			}
+			frame++;
+		}, 20);
+
+		frame = 0;
+		double optimizedMs = Time([&]() {
+			for (int ix = frame % moveEvery; ix < TRANSFORM_COUNT; ix += moveEvery) {
+				TransformStore::Index index = indices[ix];
+				store.GetPosition(index) = positions[ix];
+				store.GetRotation(index) = rotations[ix];
+				store.GetScale(index) = scales[ix];
+				store.MarkDirty(index);
+			}
+			store.UpdateWorldMatrices();
+			for (TransformStore::Index index : indices) {
+				worldSink += store.GetWorldMatrix(index);
+				normalSink += store.GetNormalMatrix(index);
+			}
+			frame++;
+		}, 20);
+
+		setAll();
+		store.UpdateWorldMatrices();
+		for (int ix = 0; ix < TRANSFORM_COUNT; ix++) {
+			const glm::mat4& world = objects[ix]->GetTransform();
+			if (!SameMatrix(world, store.GetWorldMatrix(indices[ix])) ||
+				!SameMatrix(glm::mat3(glm::transpose(glm::inverse(world))), store.GetNormalMatrix(indices[ix]))) {
+				Fail("TransformStore does not match translate * rotate * scale for transform " + std::to_string(ix));
+				break;
+			}
+		}
+
+		LOG_TRACE("Checksum: {} {}", worldSink[3][3], normalSink[2][2]);
+		Report(name, baselineMs, optimizedMs);
+	}
+
+	void RunTransformStore() {
+		LOG_INFO("Updating {} transforms per frame as separate objects and in a TransformStore", TRANSFORM_COUNT);
+		RunTransformTest("Every transform moving", 1);
+		RunTransformTest("1 in 10 transforms moving", 10);
+	}
+}
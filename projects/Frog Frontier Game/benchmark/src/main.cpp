@@ -0,0 +1,84 @@
+#include <Logging.h>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "Benchmark.h"
+
+// Console app that times the game's engine code against the code it replaced, on the game's
+// own assets. Run it from the game's res folder, optionally with the names of the benchmarks
+// to run (ex: "Frog Frontier Benchmark.exe obj"), by default every benchmark is run
+
+/// <summary>
+/// Creates a hidden window so that benchmarks that create meshes and textures have an OpenGL context
+/// </summary>
+/// <returns>The window, or nullptr if GLFW or GLAD failed to start</returns>
+GLFWwindow* initGL() {
+	if (glfwInit() == GLFW_FALSE) {
+		LOG_ERROR("Failed to initialize GLFW");
+		return nullptr;
+	}
+
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	GLFWwindow* window = glfwCreateWindow(800, 800, "Frog Frontier Benchmark", nullptr, nullptr);
+	if (window == nullptr) {
+		LOG_ERROR("Failed to create a window");
+		return nullptr;
+	}
+	glfwMakeContextCurrent(window);
+
+	if (gladLoadGLLoader((GLADloadproc)glfwGetProcAddress) == 0) {
+		LOG_ERROR("Failed to initialize Glad");
+		return nullptr;
+	}
+	return window;
+}
+
+int main(int argc, char** argv) {
+	Logger::Init();
+
+	std::vector<Benchmark::Entry> benchmarks = {
+		{ "obj", "ObjLoader vs OptimizedObjLoader on every OBJ file", Benchmark::RunObjLoader },
+		{ "vat", "One mesh per keyframe vs AnimatedMeshResource on every animation", Benchmark::RunAnimatedMesh },
+		{ "transforms", "Per-object transforms vs TransformStore on 10k transforms", Benchmark::RunTransformStore },
+		{ "reload", "Component pool sizes across 1000 reloads of Level1.json", Benchmark::RunSceneReload },
+		{ "components", "weak_ptr component store vs dense pools on 800 render components", Benchmark::RunComponentPools },
+		{ "scene", "JSON document vs streaming reader on Level4.json", Benchmark::RunSceneLoad }
+	};
+
+	// Any arguments are the names of the benchmarks to run
+	std::vector<std::string> selected(argv + 1, argv + argc);
+	for (const std::string& name : selected) {
+		auto it = std::find_if(benchmarks.begin(), benchmarks.end(), [&](const Benchmark::Entry& entry) { return entry.Name == name; });
+		if (it == benchmarks.end()) {
+			LOG_ERROR("Unknown benchmark \"{}\", available benchmarks are:", name);
+			for (const Benchmark::Entry& entry : benchmarks) {
+				LOG_ERROR("\t{:<12} {}", entry.Name, entry.Description);
+			}
+			return 1;
+		}
+	}
+
+	GLFWwindow* window = initGL();
+	if (window == nullptr) {
+		return 1;
+	}
+
+	for (const Benchmark::Entry& entry : benchmarks) {
+		if (selected.empty() || std::find(selected.begin(), selected.end(), entry.Name) != selected.end()) {
+			LOG_INFO("==== {} ====", entry.Description);
+			entry.Run();
+		}
+	}
+
+	Benchmark::RemoveGeneratedLevels();
+
+	glfwDestroyWindow(window);
+	glfwTerminate();
+	Logger::Uninitialize();
+
+	return Benchmark::HasFailed() ? 1 : 0;
+}
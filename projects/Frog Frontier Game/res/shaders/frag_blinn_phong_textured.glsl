@@ -1,4 +1,4 @@
-#version 410
+#version 430
 
 
 layout(location = 0) in vec3 inWorldPos;
@@ -13,28 +13,48 @@ layout(location = 0) out vec4 frag_color;
 ///////////// Application Level Uniforms ///////////////////////
 ////////////////////////////////////////////////////////////////
 
-// Global light properties
-uniform vec3  u_AmbientCol;
-
-// Represents a single light source
+// Represents a single light source, see LightUniform in UniformBlocks.h
 struct Light {
 	vec3  Position;
-	vec3  Color;
 	float Attenuation;
+	vec3  Color;
+};
+
+#define MAX_LIGHTS 256
+// Lighting data shared by all shaders, see LightUniforms in UniformBlocks.h
+layout(std140, binding = 1) uniform b_LightData {
+	// Our array of all lights
+	Light u_Lights[MAX_LIGHTS];
+	// Global light properties
+	vec3  u_AmbientCol;
+	// The number of enabled lights
+	int   u_NumLights;
 };
 
-#define MAX_LIGHTS 40
-// Our array of all lights
-uniform Light u_Lights[MAX_LIGHTS];
-// The number of enabled lights
-uniform int u_NumLights;
+#define LIGHT_CLUSTERS 64
+// Lights are split into slices along the X axis, see LightGrid.h
+layout(std430, binding = 0) readonly buffer b_LightClusters {
+	// World space X of the start of the first cluster
+	float u_ClusterMinX;
+	// 1 / the width of a cluster
+	float u_ClusterInvSize;
+	int   u_ClusterCount;
+	// The offset and count for each cluster's lights in u_LightIndices
+	uvec2 u_Clusters[LIGHT_CLUSTERS];
+	// Indices into u_Lights
+	uint  u_LightIndices[];
+};
 
 ////////////////////////////////////////////////////////////////
 /////////////// Frame Level Uniforms ///////////////////////////
 ////////////////////////////////////////////////////////////////
 
-// The position of the camera in world space
-uniform vec3  u_CamPos;
+// Camera data shared by all shaders, see FrameUniforms in UniformBlocks.h
+layout(std140, binding = 0) uniform b_FrameData {
+	mat4 u_ViewProjection;
+	// The position of the camera in world space
+	vec3 u_CamPos;
+};
 
 ////////////////////////////////////////////////////////////////
 /////////////// Instance Level Uniforms ////////////////////////
@@ -46,6 +66,8 @@ uniform vec3  u_CamPos;
 struct Material {
 	sampler2D Diffuse;
 	float     Shininess;
+	// Texels with less alpha than this are discarded, 0 for blended materials
+	float     AlphaCutoff;
 };
 // Create a uniform for the material
 uniform Material u_Material;
@@ -92,14 +114,19 @@ void main() {
 	// Normalize our input normal
 	vec3 normal = normalize(inNormal);
 
-	// Iterate over all lights
-	for(int ix = 0; ix < u_NumLights && ix < MAX_LIGHTS; ix++) {
+	// Find our cluster, and only iterate over the lights that can reach it
+	int cluster = clamp(int(floor((inWorldPos.x - u_ClusterMinX) * u_ClusterInvSize)), 0, u_ClusterCount - 1);
+	uvec2 lights = u_Clusters[cluster];
+	for(uint ix = 0; ix < lights.y; ix++) {
 		// Additive lighting model
-		lightAccumulation += CalcLightContribution(normal, u_Lights[ix]);
+		lightAccumulation += CalcLightContribution(normal, u_Lights[u_LightIndices[lights.x + ix]]);
 	}
 
 	// Get the albedo from the diffuse / albedo map
 	vec4 textureColor = texture(u_Material.Diffuse, inUV);
+	if (textureColor.a < u_Material.AlphaCutoff) {
+		discard;
+	}
 
 	// combine for the final result
 	vec3 result = (u_AmbientCol + lightAccumulation)  * inColor * textureColor.rgb;
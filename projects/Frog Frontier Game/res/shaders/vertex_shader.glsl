@@ -1,4 +1,4 @@
-#version 410
+#version 420
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inColor;
@@ -10,8 +10,12 @@ layout(location = 1) out vec3 outColor;
 layout(location = 2) out vec3 outNormal;
 layout(location = 3) out vec2 outUV;
 
-// Complete MVP
-uniform mat4 u_ModelViewProjection;
+// Camera data shared by all shaders, see FrameUniforms in UniformBlocks.h
+layout(std140, binding = 0) uniform b_FrameData {
+	mat4 u_ViewProjection;
+	vec3 u_CamPos;
+};
+
 // Just the model transform, we'll do worldspace lighting
 uniform mat4 u_Model;
 // Normal Matrix for transforming normals
@@ -19,11 +23,12 @@ uniform mat3 u_NormalMatrix;
 
 void main() {
 
-	gl_Position = u_ModelViewProjection * vec4(inPosition, 1.0);
-
 	// Lecture 5
 	// Pass vertex pos in world space to frag shader
-	outWorldPos = (u_Model * vec4(inPosition, 1.0)).xyz;
+	vec4 worldPos = u_Model * vec4(inPosition, 1.0);
+	outWorldPos = worldPos.xyz;
+
+	gl_Position = u_ViewProjection * worldPos;
 
 	// Normals
 	outNormal = u_NormalMatrix * inNormal;
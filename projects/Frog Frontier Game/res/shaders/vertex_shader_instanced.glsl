@@ -0,0 +1,43 @@
+#version 420
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec3 inColor;
+layout(location = 2) in vec3 inNormal;
+layout(location = 3) in vec2 inUV;
+
+// Per-instance data, see InstanceTransform in VertexTypes.h
+// Takes up locations 4-7
+layout(location = 4) in mat4 inModel;
+// Takes up locations 8-10
+layout(location = 8) in mat3 inNormalMatrix;
+
+layout(location = 0) out vec3 outWorldPos;
+layout(location = 1) out vec3 outColor;
+layout(location = 2) out vec3 outNormal;
+layout(location = 3) out vec2 outUV;
+
+// Camera data shared by all shaders, see FrameUniforms in UniformBlocks.h
+layout(std140, binding = 0) uniform b_FrameData {
+	mat4 u_ViewProjection;
+	vec3 u_CamPos;
+};
+
+void main() {
+
+	// Pass vertex pos in world space to frag shader
+	vec4 worldPos = inModel * vec4(inPosition, 1.0);
+	outWorldPos = worldPos.xyz;
+
+	gl_Position = u_ViewProjection * worldPos;
+
+	// Normals
+	outNormal = inNormalMatrix * inNormal;
+
+	// Pass our UV coords to the fragment shader
+	outUV = inUV;
+
+	///////////
+	outColor = inColor;
+
+}
+
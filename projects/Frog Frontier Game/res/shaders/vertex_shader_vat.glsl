@@ -0,0 +1,91 @@
+#version 420
+
+// The base pose that every frame is stored relative to, see AnimatedMeshResource.h
+layout(location = 0) in vec3 inPosition;
+layout(location = 3) in vec2 inUV;
+
+layout(location = 0) out vec3 outWorldPos;
+layout(location = 1) out vec3 outColor;
+layout(location = 2) out vec3 outNormal;
+layout(location = 3) out vec2 outUV;
+
+// Camera data shared by all shaders, see FrameUniforms in UniformBlocks.h
+layout(std140, binding = 0) uniform b_FrameData {
+	mat4 u_ViewProjection;
+	vec3 u_CamPos;
+};
+
+// One column per vertex and one row per frame. RGB is the offset from the base pose as a
+// fraction of u_DeltaScale, and A is the octahedral encoded normal. Slot 0 is taken by the
+// material's diffuse texture
+layout(binding = 1) uniform sampler2D s_VertexAnimation;
+
+// Just the model transform, we'll do worldspace lighting
+uniform mat4 u_Model;
+// Normal Matrix for transforming normals
+uniform mat3 u_NormalMatrix;
+// The two frames we are blending between, and how far we are from A to B, set by Animator
+uniform int   u_FrameA;
+uniform int   u_FrameB;
+uniform float u_MorphT;
+// The frames of the state we are crossfading out of, and how much of it is left
+uniform int   u_FadeFrameA;
+uniform int   u_FadeFrameB;
+uniform float u_FadeMorphT;
+uniform float u_Fade;
+// The largest offset from the base pose on each axis, set by Animator
+uniform vec3  u_DeltaScale;
+
+// Unpacks the two 8 bit octahedral coordinates in a 16 bit normalized value, and folds the
+// bottom half of the octahedron back down. See EncodeOctahedral in AnimatedMeshResource.cpp
+vec3 DecodeNormal(float encoded) {
+	uint bits = uint(encoded * 65535.0 + 0.5);
+	vec2 oct = vec2(bits & 0xFFu, bits >> 8u) / 255.0 * 2.0 - 1.0;
+	vec3 normal = vec3(oct, 1.0 - abs(oct.x) - abs(oct.y));
+	float fold = max(-normal.z, 0.0);
+	normal.x += normal.x >= 0.0 ? -fold : fold;
+	normal.y += normal.y >= 0.0 ? -fold : fold;
+	return normalize(normal);
+}
+
+// Blends between two keyframes, giving the offset from the base pose and the normal
+void SamplePose(int frameA, int frameB, float t, out vec3 delta, out vec3 normal) {
+	vec4 a = texelFetch(s_VertexAnimation, ivec2(gl_VertexID, frameA), 0);
+	vec4 b = texelFetch(s_VertexAnimation, ivec2(gl_VertexID, frameB), 0);
+	delta = (mix(a.xyz, b.xyz, t) * 2.0 - 1.0) * u_DeltaScale;
+	normal = mix(DecodeNormal(a.w), DecodeNormal(b.w), t);
+}
+
+void main() {
+
+	// Blend between the two keyframes in model space
+	vec3 delta, normal;
+	SamplePose(u_FrameA, u_FrameB, u_MorphT, delta, normal);
+
+	// And then with the state we're fading out of, if there is one
+	if (u_Fade > 0.0) {
+		vec3 fadeDelta, fadeNormal;
+		SamplePose(u_FadeFrameA, u_FadeFrameB, u_FadeMorphT, fadeDelta, fadeNormal);
+		delta = mix(delta, fadeDelta, u_Fade);
+		normal = mix(normal, fadeNormal, u_Fade);
+	}
+
+	vec3 position = inPosition + delta;
+	normal = normalize(normal);
+
+	// Pass vertex pos in world space to frag shader
+	vec4 worldPos = u_Model * vec4(position, 1.0);
+	outWorldPos = worldPos.xyz;
+
+	gl_Position = u_ViewProjection * worldPos;
+
+	// Normals
+	outNormal = u_NormalMatrix * normal;
+
+	// Pass our UV coords to the fragment shader
+	outUV = inUV;
+
+	// Animated meshes don't store vertex colors, OBJ files are always white
+	outColor = vec3(1.0);
+
+}
@@ -0,0 +1,311 @@
+#include "AnimatedMeshResource.h"
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Utils/OptimizedObjLoader.h"
+#include "Utils/JsonGlmHelpers.h"
+
+namespace Gameplay {
+	// The UVs are shared by all frames, and stored in their own buffer
+	static const std::vector<BufferAttribute> UV_DECL = {
+		BufferAttribute(3, 2, AttributeType::Float, sizeof(glm::vec2), 0, AttribUsage::Texture),
+	};
+
+	AnimatedMeshResource::AnimatedMeshResource() :
+		MeshResource(),
+		Clips(std::vector<Clip>()),
+		VertexAnimation(nullptr),
+		DeltaScale(glm::vec3(0.0f)),
+		_objMeshBytes(0)
+	{ }
+
+	AnimatedMeshResource::AnimatedMeshResource(const std::vector<Clip>& clips) :
+		MeshResource(),
+		Clips(clips),
+		VertexAnimation(nullptr),
+		DeltaScale(glm::vec3(0.0f)),
+		_objMeshBytes(0)
+	{
+		BakedData::Sptr data = _Bake(Clips);
+		if (data != nullptr) {
+			_Upload(*data);
+		}
+	}
+
+	AnimatedMeshResource::~AnimatedMeshResource() = default;
+
+	int AnimatedMeshResource::FindClip(const std::string& name) const {
+		for (size_t ix = 0; ix < Clips.size(); ix++) {
+			if (Clips[ix].Name == name) {
+				return static_cast<int>(ix);
+			}
+		}
+		return -1;
+	}
+
+	size_t AnimatedMeshResource::GetMemoryUsage() const {
+		size_t result = 0;
+		if (VertexAnimation != nullptr) {
+			result += (size_t)VertexAnimation->GetWidth() * VertexAnimation->GetHeight() * sizeof(glm::u16vec4);
+		}
+		if (Mesh != nullptr) {
+			// Plus the topology and base pose that are shared by all the frames
+			const VertexArrayObject::VertexBufferBinding* uvs = Mesh->GetBufferBinding(AttribUsage::Texture);
+			const VertexArrayObject::VertexBufferBinding* pose = Mesh->GetBufferBinding(AttribUsage::Position);
+			result += uvs != nullptr ? uvs->Buffer->GetTotalSize() : 0;
+			result += pose != nullptr ? pose->Buffer->GetTotalSize() : 0;
+			result += Mesh->GetIndexBuffer() != nullptr ? Mesh->GetIndexBuffer()->GetTotalSize() : 0;
+		}
+		return result;
+	}
+
+	size_t AnimatedMeshResource::GetObjMeshBytes() const {
+		return _objMeshBytes;
+	}
+
+	/// <summary>
+	/// Reads the list of clips from a resource's JSON blob
+	/// </summary>
+	static std::vector<AnimatedMeshResource::Clip> ClipsFromJson(const nlohmann::json& blob) {
+		std::vector<AnimatedMeshResource::Clip> result;
+		if (blob.contains("clips") && blob["clips"].is_array()) {
+			for (const nlohmann::json& data : blob["clips"]) {
+				AnimatedMeshResource::Clip& clip = result.emplace_back();
+				clip.Name = JsonGet<std::string>(data, "name", "");
+				clip.Frames = JsonGet(data, "frames", std::vector<std::string>());
+				clip.FrameRate = JsonGet(data, "frame_rate", 20.0f);
+			}
+		}
+		return result;
+	}
+
+	nlohmann::json AnimatedMeshResource::ToJson() const {
+		std::vector<nlohmann::json> clips;
+		clips.reserve(Clips.size());
+		for (const Clip& clip : Clips) {
+			clips.push_back({
+				{ "name", clip.Name },
+				{ "frames", clip.Frames },
+				{ "frame_rate", clip.FrameRate }
+			});
+		}
+		return {
+			{ "clips", clips }
+		};
+	}
+
+	AnimatedMeshResource::Sptr AnimatedMeshResource::FromJson(const nlohmann::json& blob) {
+		return std::make_shared<AnimatedMeshResource>(ClipsFromJson(blob));
+	}
+
+	ResourceFinalizer AnimatedMeshResource::PrepareFromJson(const nlohmann::json& blob) {
+		std::vector<Clip> clips = ClipsFromJson(blob);
+		BakedData::Sptr data = _Bake(clips);
+		return [clips, data]() {
+			AnimatedMeshResource::Sptr result = std::make_shared<AnimatedMeshResource>();
+			result->Clips = clips;
+			if (data != nullptr) {
+				result->_Upload(*data);
+			}
+			return result;
+		};
+	}
+
+	/// <summary>
+	/// Packs a unit vector into two 8 bit values, by projecting it onto an octahedron and
+	/// unfolding the bottom half over the top. See DecodeNormal in vertex_shader_vat.glsl
+	/// </summary>
+	static uint16_t EncodeOctahedral(const glm::vec3& normal) {
+		glm::vec2 result = glm::vec2(normal) / (glm::abs(normal.x) + glm::abs(normal.y) + glm::abs(normal.z));
+		if (normal.z < 0.0f) {
+			glm::vec2 sign = glm::vec2(result.x >= 0.0f ? 1.0f : -1.0f, result.y >= 0.0f ? 1.0f : -1.0f);
+			result = (1.0f - glm::abs(glm::vec2(result.y, result.x))) * sign;
+		}
+		glm::uvec2 bytes = glm::uvec2(glm::round(glm::clamp(result * 0.5f + 0.5f, 0.0f, 1.0f) * 255.0f));
+		return static_cast<uint16_t>(bytes.x | (bytes.y << 8));
+	}
+
+	/// <summary>
+	/// Maps a value from [-1, 1] to the full range of a 16 bit unsigned normalized value
+	/// </summary>
+	static uint16_t QuantizeSigned(float value) {
+		return static_cast<uint16_t>(glm::round(glm::clamp(value * 0.5f + 0.5f, 0.0f, 1.0f) * 65535.0f));
+	}
+
+	AnimatedMeshResource::BakedData::Sptr AnimatedMeshResource::_Bake(std::vector<Clip>& clips) {
+		BakedData::Sptr result = nullptr;
+
+		// The OBJ position index for each vertex in the model
+		std::vector<int> vertexPositions;
+		size_t positionCount = 0;
+		size_t uvCount = 0;
+
+		// Re-used between frames so we only allocate once
+		std::vector<glm::vec3> positions;
+		std::vector<glm::vec2> uvs;
+		std::vector<glm::vec3> normals;
+		std::vector<glm::ivec3> corners;
+		std::vector<glm::vec3> smoothNormals;
+		std::unordered_set<uint64_t> objVertices;
+
+		// Every frame at full precision, we need the largest offset from the base pose before we can quantize them
+		std::vector<VertexPosNorm> frames;
+		// Repeated frames would only have been loaded once as meshes
+		std::unordered_set<std::string> objFiles;
+
+		uint32_t frameCount = 0;
+		for (Clip& clip : clips) {
+			clip.FirstFrame = frameCount;
+			clip.FrameCount = 0;
+
+			for (const std::string& filename : clip.Frames) {
+				if (!OptimizedObjLoader::ParseAttributes(filename, positions, uvs, normals, corners)) {
+					continue;
+				}
+
+				// Blender triangulates each frame a bit differently, so the faces don't line up between
+				// frames, but the position and UV lists do. The first frame that loads gives us the
+				// faces for the whole model, with one vertex per unique position and UV pair
+				if (result == nullptr) {
+					result = std::make_shared<BakedData>();
+					std::unordered_map<uint64_t, uint32_t> vertexMap;
+					vertexMap.reserve(corners.size());
+					result->Indices.reserve(corners.size());
+
+					for (const glm::ivec3& attribs : corners) {
+						uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(attribs.x)) << 32) | static_cast<uint32_t>(attribs.y);
+						auto it = vertexMap.find(key);
+						if (it == vertexMap.end()) {
+							it = vertexMap.emplace(key, static_cast<uint32_t>(vertexPositions.size())).first;
+							vertexPositions.push_back(attribs.x);
+							result->UVs.push_back((size_t)attribs.y < uvs.size() ? uvs[attribs.y] : glm::vec2(0.0f));
+						}
+						result->Indices.push_back(it->second);
+					}
+
+					result->VertexCount = static_cast<uint32_t>(vertexPositions.size());
+					positionCount = positions.size();
+					uvCount = uvs.size();
+				}
+				else if (positions.size() != positionCount || uvs.size() != uvCount) {
+					LOG_WARN("Keyframe \"{}\" was not exported from the same model as the first frame, skipping", filename);
+					continue;
+				}
+
+				// ObjLoader would have made a VertexPosNormTexCol for every unique combination of attributes
+				if (objFiles.insert(filename).second) {
+					objVertices.clear();
+					for (const glm::ivec3& attribs : corners) {
+						// Missing attributes are -1, so shift them up to 0 to keep them in their own 21 bits
+						objVertices.insert(
+							(static_cast<uint64_t>((attribs.x + 1) & 0x1FFFFF) << 42) |
+							(static_cast<uint64_t>((attribs.y + 1) & 0x1FFFFF) << 21) |
+							static_cast<uint64_t>((attribs.z + 1) & 0x1FFFFF));
+					}
+					size_t indexSize = objVertices.size() <= UINT16_MAX ? sizeof(uint16_t) : sizeof(uint32_t);
+					result->ObjMeshBytes += objVertices.size() * sizeof(VertexPosNormTexCol) + corners.size() * indexSize;
+				}
+
+				// Add up the normals of every corner that uses each position, the exported normals are
+				// per face, and we need one per vertex since the faces change between frames
+				smoothNormals.assign(positions.size(), glm::vec3(0.0f));
+				for (const glm::ivec3& attribs : corners) {
+					if ((size_t)attribs.x < positions.size() && (size_t)attribs.z < normals.size()) {
+						smoothNormals[attribs.x] += normals[attribs.z];
+					}
+				}
+
+				size_t frameStart = frames.size();
+				frames.resize(frameStart + result->VertexCount, VertexPosNorm(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f)));
+				for (size_t ix = 0; ix < vertexPositions.size(); ix++) {
+					size_t position = static_cast<size_t>(vertexPositions[ix]);
+					if (position < positions.size()) {
+						float length = glm::length(smoothNormals[position]);
+						frames[frameStart + ix].Position = positions[position];
+						frames[frameStart + ix].Normal = length > 0.0f ? smoothNormals[position] / length : glm::vec3(0.0f, 0.0f, 1.0f);
+					}
+				}
+
+				clip.FrameCount++;
+				frameCount++;
+			}
+		}
+
+		if (result == nullptr) {
+			return result;
+		}
+		result->FrameCount = frameCount;
+
+		// The very first frame is the base pose that all the others are stored relative to
+		result->BasePose.assign(frames.begin(), frames.begin() + result->VertexCount);
+		for (size_t ix = 0; ix < frames.size(); ix++) {
+			const glm::vec3& base = result->BasePose[ix % result->VertexCount].Position;
+			result->DeltaScale = glm::max(result->DeltaScale, glm::abs(frames[ix].Position - base));
+		}
+
+		// Keep the scale above zero, so we don't divide by zero on axes that never move
+		glm::vec3 scale = glm::max(result->DeltaScale, glm::vec3(1e-6f));
+		result->Texels.resize(frames.size());
+		for (size_t ix = 0; ix < frames.size(); ix++) {
+			glm::vec3 delta = (frames[ix].Position - result->BasePose[ix % result->VertexCount].Position) / scale;
+			result->Texels[ix] = glm::u16vec4(
+				QuantizeSigned(delta.x),
+				QuantizeSigned(delta.y),
+				QuantizeSigned(delta.z),
+				EncodeOctahedral(frames[ix].Normal)
+			);
+		}
+		result->DeltaScale = scale;
+
+		return result;
+	}
+
+	void AnimatedMeshResource::_Upload(const BakedData& data) {
+		VertexBuffer::Sptr uvs = VertexBuffer::Create();
+		uvs->LoadData(data.UVs.data(), data.UVs.size());
+
+		VertexBuffer::Sptr basePose = VertexBuffer::Create();
+		basePose->LoadData(data.BasePose.data(), data.BasePose.size());
+
+		IndexBuffer::Sptr ebo = IndexBuffer::Create();
+		// Use 16 bit indices if we can, halving the size of the index buffer
+		if (data.VertexCount <= UINT16_MAX) {
+			std::vector<uint16_t> shortIndices(data.Indices.begin(), data.Indices.end());
+			ebo->LoadData(shortIndices.data(), shortIndices.size());
+		} else {
+			ebo->LoadData(data.Indices.data(), data.Indices.size());
+		}
+
+		Mesh = VertexArrayObject::Create();
+		Mesh->AddVertexBuffer(uvs, UV_DECL);
+		Mesh->AddVertexBuffer(basePose, VertexPosNorm::V_DECL);
+		Mesh->SetIndexBuffer(ebo);
+
+		// Colliders look for positions in the vertex declaration, these come from the base pose
+		Mesh->SetVDecl(VertexPosNorm::V_DECL);
+
+		DeltaScale = data.DeltaScale;
+
+		// Every vertex gets a column, so very dense models won't fit in a single texture
+		const int maxSize = ITexture::GetLimits().MAX_TEXTURE_SIZE;
+		if ((int)data.VertexCount > maxSize || (int)data.FrameCount > maxSize) {
+			LOG_WARN("Animated mesh is too large for a vertex animation texture ({} vertices, {} frames), it will only show the base pose", data.VertexCount, data.FrameCount);
+		} else {
+			Texture2DDescription descr;
+			descr.Width = data.VertexCount;
+			descr.Height = data.FrameCount;
+			descr.Format = InternalFormat::RGBA16;
+			descr.HorizontalWrap = WrapMode::ClampToEdge;
+			descr.VerticalWrap = WrapMode::ClampToEdge;
+			VertexAnimation = std::make_shared<Texture2D>(descr);
+			VertexAnimation->LoadData(data.VertexCount, data.FrameCount, PixelFormat::RGBA, PixelType::UShort, (void*)data.Texels.data());
+		}
+
+		_objMeshBytes = data.ObjMeshBytes;
+
+		size_t memoryUsage = GetMemoryUsage();
+		LOG_INFO("Baked animated mesh ({} clips, {} frames, {} vertices): {} bytes, down from {} bytes as one mesh per OBJ ({:.1f}x smaller)",
+			Clips.size(), data.FrameCount, data.VertexCount, memoryUsage, data.ObjMeshBytes,
+			memoryUsage > 0 ? (float)data.ObjMeshBytes / (float)memoryUsage : 0.0f);
+	}
+}
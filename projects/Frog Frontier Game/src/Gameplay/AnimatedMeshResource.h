@@ -0,0 +1,146 @@
+#pragma once
+#include "Gameplay/MeshResource.h"
+#include "Graphics/VertexTypes.h"
+#include "Graphics/Texture2D.h"
+#include <GLM/gtc/type_precision.hpp>
+
+namespace Gameplay {
+	/// <summary>
+	/// A model with keyframe animations that were exported as one OBJ file per frame (ex:
+	/// Running_000001.obj to Running_000018.obj). A resource can hold several clips for the same
+	/// model, which all share a single VAO
+	///
+	/// The VAO holds the UVs, the index buffer, and the first frame as a base pose in the regular
+	/// position and normal slots, which every frame shares. The frames themselves are baked into
+	/// a compressed vertex animation texture (VAT), with one column per vertex and one RGBA16 row
+	/// per frame. RGB is the vertex's offset from the base pose, quantized to 16 bits over the
+	/// range given by DeltaScale, and A is the normal, octahedral encoded into two 8 bit values.
+	/// That's 8 bytes per vertex per frame, compared to the 48 bytes of a VertexPosNormTexCol
+	///
+	/// vertex_shader_vat.glsl decodes the two frames it is blending between by gl_VertexID, so
+	/// playing, switching or blending clips only changes uniforms. See Animator for playing
+	/// these back
+	///
+	/// All of the frames must be exported from the same model. Vertices are matched up between
+	/// frames by their position and UV index in the OBJ files, and the normals are smoothed
+	/// per vertex, since the exported faces and normals can change from frame to frame
+	/// </summary>
+	class AnimatedMeshResource : public MeshResource {
+	public:
+		typedef std::shared_ptr<AnimatedMeshResource> Sptr;
+		MAKE_STATIC_TYPENAME(Gameplay::AnimatedMeshResource)
+
+		/// <summary>
+		/// A single animation for the model
+		/// </summary>
+		struct Clip {
+			/// <summary>
+			/// The name to play the clip by
+			/// </summary>
+			std::string              Name;
+			/// <summary>
+			/// The paths to the OBJ file for each keyframe, in order
+			/// </summary>
+			std::vector<std::string> Frames;
+			/// <summary>
+			/// The number of keyframes to play per second
+			/// </summary>
+			float                    FrameRate = 20.0f;
+
+			/// <summary>
+			/// The frame in the VAT where this clip starts, set when the clip is baked
+			/// </summary>
+			uint32_t                 FirstFrame = 0;
+			/// <summary>
+			/// The number of keyframes that were baked, frames that were not exported from
+			/// the same model as the rest are skipped
+			/// </summary>
+			uint32_t                 FrameCount = 0;
+
+			/// <summary>
+			/// Gets the length of the clip in seconds, when looping back to the first frame
+			/// </summary>
+			float GetDuration() const { return FrameRate > 0.0f ? FrameCount / FrameRate : 0.0f; }
+		};
+
+		// Default constructor
+		AnimatedMeshResource();
+		/// <summary>
+		/// Constructor for loading and baking a list of clips
+		/// </summary>
+		/// <param name="clips">The clips to load, these must all be for the same model</param>
+		AnimatedMeshResource(const std::vector<Clip>& clips);
+
+		virtual ~AnimatedMeshResource();
+
+		/// <summary>
+		/// The clips that this resource contains
+		/// </summary>
+		std::vector<Clip>  Clips;
+		/// <summary>
+		/// The vertex animation texture that all the clips are baked into
+		/// </summary>
+		Texture2D::Sptr    VertexAnimation;
+		/// <summary>
+		/// The largest offset from the base pose on each axis, the offsets in the VAT are
+		/// stored as a fraction of this
+		/// </summary>
+		glm::vec3          DeltaScale;
+
+		/// <summary>
+		/// Gets the index of the clip with the given name, or -1 if there is no such clip
+		/// </summary>
+		int FindClip(const std::string& name) const;
+
+		/// <summary>
+		/// Gets the number of bytes of GPU memory used by this resource
+		/// </summary>
+		size_t GetMemoryUsage() const;
+		/// <summary>
+		/// Gets the number of bytes of GPU memory the keyframes would have used if they were
+		/// loaded as one mesh per OBJ file, to compare against GetMemoryUsage
+		/// </summary>
+		size_t GetObjMeshBytes() const;
+
+		// Inherited from IResource
+
+		virtual nlohmann::json ToJson() const override;
+		static AnimatedMeshResource::Sptr FromJson(const nlohmann::json& blob);
+		/// <summary>
+		/// Parses and bakes all the keyframes on the calling thread, and returns a function to
+		/// upload them to the GPU on the main thread
+		/// </summary>
+		static ResourceFinalizer PrepareFromJson(const nlohmann::json& blob);
+
+	protected:
+		/// <summary>
+		/// The baked contents of all the clips, before they are uploaded
+		/// </summary>
+		struct BakedData {
+			typedef std::shared_ptr<BakedData> Sptr;
+
+			std::vector<glm::vec2>     UVs;
+			std::vector<uint32_t>      Indices;
+			std::vector<VertexPosNorm> BasePose;
+			// One row per frame, with a texel per vertex
+			std::vector<glm::u16vec4>  Texels;
+			glm::vec3                  DeltaScale = glm::vec3(0.0f);
+			uint32_t                   VertexCount = 0;
+			uint32_t                   FrameCount = 0;
+			// How much memory the frames would have used if loaded as one mesh per OBJ file
+			size_t                     ObjMeshBytes = 0;
+		};
+
+		/// <summary>
+		/// Parses the keyframes for the given clips and bakes them without touching OpenGL. The
+		/// clips will have their first frame and frame count filled in
+		/// </summary>
+		static BakedData::Sptr _Bake(std::vector<Clip>& clips);
+		/// <summary>
+		/// Creates the VAO and vertex animation texture from baked data, must be called on the main thread
+		/// </summary>
+		void _Upload(const BakedData& data);
+
+		size_t _objMeshBytes;
+	};
+}
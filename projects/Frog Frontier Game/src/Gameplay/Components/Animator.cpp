@@ -0,0 +1,382 @@
+#include "Gameplay/Components/Animator.h"
+#include <cmath>
+
+#include "Gameplay/GameObject.h"
+#include "Gameplay/Components/RenderComponent.h"
+#include "Gameplay/SceneSnapshot.h"
+#include "Utils/ImGuiHelper.h"
+#include "Utils/JsonGlmHelpers.h"
+
+const std::string Animator::ANY_STATE = "*";
+
+Animator::Animator() :
+	IComponent(),
+	Speed(1.0f),
+	Paused(false),
+	States(std::vector<State>()),
+	Transitions(std::vector<Transition>()),
+	_parameters(std::vector<Parameter>()),
+	_state(-1),
+	_time(0.0f),
+	_previous(-1),
+	_previousTime(0.0f),
+	_fadeElapsed(0.0f),
+	_fadeDuration(0.0f),
+	_uniformShader(),
+	_uniforms({ -1, -1, -1, -1, -1, -1, -1, -1 })
+{ }
+
+Animator::~Animator() = default;
+
+void Animator::SetBool(const std::string& name, bool value) {
+	for (Parameter& param : _parameters) {
+		if (param.Name == name) {
+			param.Value = value;
+			return;
+		}
+	}
+	_parameters.push_back({ name, value });
+}
+
+bool Animator::GetBool(const std::string& name) const {
+	for (const Parameter& param : _parameters) {
+		if (param.Name == name) {
+			return param.Value;
+		}
+	}
+	return false;
+}
+
+void Animator::Play(const std::string& state, float crossfade) {
+	int index = _FindState(state);
+	if (index == -1) {
+		LOG_WARN("Animator does not have a state named \"{}\"", state);
+		return;
+	}
+	_EnterState(index, crossfade);
+}
+
+const Animator::State* Animator::GetState() const {
+	return _state >= 0 && _state < (int)States.size() ? &States[_state] : nullptr;
+}
+
+void Animator::Apply(const Shader::Sptr& shader) {
+	int frameA, frameB;
+	float blend;
+	if (!_Sample(_state, _time, frameA, frameB, blend) || States[_state].Mesh->VertexAnimation == nullptr) {
+		return;
+	}
+	const Gameplay::AnimatedMeshResource::Sptr& mesh = States[_state].Mesh;
+	// Slot 0 is used by the material's diffuse texture
+	mesh->VertexAnimation->Bind(1);
+
+	// The state we're fading out of, _EnterState makes sure it's on the same mesh
+	int fadeFrameA = frameA, fadeFrameB = frameB;
+	float fadeBlend = blend;
+	float fade = 0.0f;
+	if (_previous != -1 && _fadeDuration > 0.0f && _Sample(_previous, _previousTime, fadeFrameA, fadeFrameB, fadeBlend)) {
+		fade = 1.0f - glm::clamp(_fadeElapsed / _fadeDuration, 0.0f, 1.0f);
+	}
+
+	// Other shaders won't have these, they will just draw the base pose
+	if (_uniformShader.lock() != shader) {
+		_uniformShader = shader;
+		_uniforms.FrameA     = shader->GetUniformLocation("u_FrameA");
+		_uniforms.FrameB     = shader->GetUniformLocation("u_FrameB");
+		_uniforms.MorphT     = shader->GetUniformLocation("u_MorphT");
+		_uniforms.FadeFrameA = shader->GetUniformLocation("u_FadeFrameA");
+		_uniforms.FadeFrameB = shader->GetUniformLocation("u_FadeFrameB");
+		_uniforms.FadeMorphT = shader->GetUniformLocation("u_FadeMorphT");
+		_uniforms.Fade       = shader->GetUniformLocation("u_Fade");
+		_uniforms.DeltaScale = shader->GetUniformLocation("u_DeltaScale");
+	}
+	auto setUniform = [&](int location, const auto* value) {
+		if (location != -1) {
+			shader->SetUniform(location, value);
+		}
+	};
+	setUniform(_uniforms.FrameA, &frameA);
+	setUniform(_uniforms.FrameB, &frameB);
+	setUniform(_uniforms.MorphT, &blend);
+	setUniform(_uniforms.FadeFrameA, &fadeFrameA);
+	setUniform(_uniforms.FadeFrameB, &fadeFrameB);
+	setUniform(_uniforms.FadeMorphT, &fadeBlend);
+	setUniform(_uniforms.Fade, &fade);
+	setUniform(_uniforms.DeltaScale, &mesh->DeltaScale);
+}
+
+void Animator::Awake() {
+	// Start in the first state if we haven't been told otherwise
+	if (_state == -1 && !States.empty()) {
+		_EnterState(0, 0.0f);
+	}
+	_ApplyMesh();
+}
+
+void Animator::Update(float deltaTime) {
+	// Take the first transition out of the current state that has all of it's conditions met
+	const State* current = GetState();
+	for (const Transition& transition : Transitions) {
+		if (current != nullptr && transition.To == current->Name) {
+			continue;
+		}
+		if (transition.From != ANY_STATE && (current == nullptr || transition.From != current->Name)) {
+			continue;
+		}
+		bool conditionsMet = true;
+		for (const Condition& condition : transition.Conditions) {
+			if (GetBool(condition.Parameter) != condition.Value) {
+				conditionsMet = false;
+				break;
+			}
+		}
+		if (conditionsMet) {
+			Play(transition.To, transition.Duration);
+			break;
+		}
+	}
+
+	if (Paused) {
+		return;
+	}
+
+	_time = _Advance(_state, _time, deltaTime);
+	if (_previous != -1) {
+		_previousTime = _Advance(_previous, _previousTime, deltaTime);
+		_fadeElapsed += deltaTime * Speed;
+		if (_fadeElapsed >= _fadeDuration) {
+			_previous = -1;
+		}
+	}
+}
+
+void Animator::RenderImGui() {
+	const State* state = GetState();
+	ImGui::Text("State: %s", state != nullptr ? state->Name.c_str() : "None");
+	ImGui::ProgressBar(_time);
+	if (_previous != -1) {
+		ImGui::Text("Fading from %s", States[_previous].Name.c_str());
+	}
+	LABEL_LEFT(ImGui::DragFloat, "Speed", &Speed, 0.01f);
+	ImGui::Checkbox("Paused", &Paused);
+	for (Parameter& param : _parameters) {
+		ImGui::Checkbox(param.Name.c_str(), &param.Value);
+	}
+}
+
+void Animator::WriteSnapshot(Gameplay::SceneSnapshot& snapshot) const {
+	snapshot.Write(_state);
+	snapshot.Write(_time);
+	snapshot.Write(_previous);
+	snapshot.Write(_previousTime);
+	snapshot.Write(_fadeElapsed);
+	snapshot.Write(_fadeDuration);
+	snapshot.Write(Speed);
+	snapshot.Write(Paused);
+	// Parameters are only ever added, so we can store just their values in order
+	snapshot.Write(_parameters.size());
+	for (const Parameter& param : _parameters) {
+		snapshot.Write(param.Value);
+	}
+}
+
+void Animator::ReadSnapshot(Gameplay::SceneSnapshot& snapshot) {
+	snapshot.Read(_state);
+	snapshot.Read(_time);
+	snapshot.Read(_previous);
+	snapshot.Read(_previousTime);
+	snapshot.Read(_fadeElapsed);
+	snapshot.Read(_fadeDuration);
+	snapshot.Read(Speed);
+	snapshot.Read(Paused);
+	size_t paramCount = 0;
+	snapshot.Read(paramCount);
+	for (size_t ix = 0; ix < paramCount; ix++) {
+		bool value = false;
+		snapshot.Read(value);
+		if (ix < _parameters.size()) {
+			_parameters[ix].Value = value;
+		}
+	}
+	// The renderer can't find animated meshes by itself, so make sure it has our mesh
+	_ApplyMesh();
+}
+
+nlohmann::json Animator::ToJson() const {
+	nlohmann::json states = nlohmann::json::array();
+	for (const State& state : States) {
+		states.push_back({
+			{ "name", state.Name },
+			{ "mesh", state.Mesh != nullptr ? state.Mesh->GetGUID().str() : "null" },
+			{ "clip", state.Clip },
+			{ "speed", state.Speed },
+			{ "looping", state.Looping }
+		});
+	}
+
+	nlohmann::json transitions = nlohmann::json::array();
+	for (const Transition& transition : Transitions) {
+		nlohmann::json conditions = nlohmann::json::array();
+		for (const Condition& condition : transition.Conditions) {
+			conditions.push_back({
+				{ "parameter", condition.Parameter },
+				{ "value", condition.Value }
+			});
+		}
+		transitions.push_back({
+			{ "from", transition.From },
+			{ "to", transition.To },
+			{ "conditions", conditions },
+			{ "duration", transition.Duration }
+		});
+	}
+
+	nlohmann::json parameters = nlohmann::json::object();
+	for (const Parameter& param : _parameters) {
+		parameters[param.Name] = param.Value;
+	}
+
+	const State* state = GetState();
+	return {
+		{ "states", states },
+		{ "transitions", transitions },
+		{ "parameters", parameters },
+		{ "state", state != nullptr ? state->Name : "" },
+		{ "time", _time },
+		{ "speed", Speed },
+		{ "paused", Paused }
+	};
+}
+
+Animator::Sptr Animator::FromJson(const nlohmann::json& blob) {
+	Animator::Sptr result = std::make_shared<Animator>();
+	if (blob.contains("states")) {
+		for (const nlohmann::json& data : blob["states"]) {
+			State& state = result->States.emplace_back();
+			state.Name = JsonGet<std::string>(data, "name", "");
+			state.Mesh = ResourceManager::Get<Gameplay::AnimatedMeshResource>(Guid(JsonGet<std::string>(data, "mesh", "null")));
+			state.Clip = JsonGet<std::string>(data, "clip", "");
+			state.Speed = JsonGet(data, "speed", 1.0f);
+			state.Looping = JsonGet(data, "looping", true);
+		}
+	}
+	if (blob.contains("transitions")) {
+		for (const nlohmann::json& data : blob["transitions"]) {
+			Transition& transition = result->Transitions.emplace_back();
+			transition.From = JsonGet<std::string>(data, "from", ANY_STATE);
+			transition.To = JsonGet<std::string>(data, "to", "");
+			transition.Duration = JsonGet(data, "duration", 0.0f);
+			if (data.contains("conditions")) {
+				for (const nlohmann::json& conditionData : data["conditions"]) {
+					Condition& condition = transition.Conditions.emplace_back();
+					condition.Parameter = JsonGet<std::string>(conditionData, "parameter", "");
+					condition.Value = JsonGet(conditionData, "value", true);
+				}
+			}
+		}
+	}
+	if (blob.contains("parameters")) {
+		for (auto& [name, value] : blob["parameters"].items()) {
+			result->SetBool(name, value.get<bool>());
+		}
+	}
+	result->_state = result->_FindState(JsonGet<std::string>(blob, "state", ""));
+	result->_time = JsonGet(blob, "time", 0.0f);
+	result->Speed = JsonGet(blob, "speed", 1.0f);
+	result->Paused = JsonGet(blob, "paused", false);
+	return result;
+}
+
+int Animator::_FindState(const std::string& name) const {
+	for (size_t ix = 0; ix < States.size(); ix++) {
+		if (States[ix].Name == name) {
+			return static_cast<int>(ix);
+		}
+	}
+	return -1;
+}
+
+const Gameplay::AnimatedMeshResource::Clip* Animator::_GetClip(int state) const {
+	if (state < 0 || state >= (int)States.size() || States[state].Mesh == nullptr) {
+		return nullptr;
+	}
+	const Gameplay::AnimatedMeshResource::Sptr& mesh = States[state].Mesh;
+	int clip = mesh->FindClip(States[state].Clip);
+	return clip != -1 ? &mesh->Clips[clip] : nullptr;
+}
+
+float Animator::_Advance(int state, float time, float deltaTime) const {
+	const Gameplay::AnimatedMeshResource::Clip* clip = _GetClip(state);
+	if (clip == nullptr || clip->FrameCount == 0 || clip->FrameRate <= 0.0f) {
+		return 0.0f;
+	}
+
+	// Looping clips blend from the last frame back to the first, so they have an extra frame of length
+	const bool looping = States[state].Looping;
+	float duration = (looping ? clip->FrameCount : clip->FrameCount - 1) / clip->FrameRate;
+	if (duration <= 0.0f) {
+		return 0.0f;
+	}
+
+	time += deltaTime * Speed * States[state].Speed / duration;
+	if (looping) {
+		time -= std::floor(time);
+	} else {
+		time = glm::clamp(time, 0.0f, 1.0f);
+	}
+	return time;
+}
+
+bool Animator::_Sample(int state, float time, int& frameA, int& frameB, float& blend) const {
+	const Gameplay::AnimatedMeshResource::Clip* clip = _GetClip(state);
+	if (clip == nullptr || clip->FrameCount == 0) {
+		return false;
+	}
+
+	uint32_t frameCount = clip->FrameCount;
+	uint32_t current, next;
+	if (States[state].Looping) {
+		float frame = time * frameCount;
+		float wholeFrame = std::floor(frame);
+		blend = frame - wholeFrame;
+		current = static_cast<uint32_t>(wholeFrame) % frameCount;
+		next = (current + 1) % frameCount;
+	} else {
+		float frame = time * (frameCount - 1);
+		float wholeFrame = std::floor(frame);
+		blend = frame - wholeFrame;
+		current = glm::min(static_cast<uint32_t>(wholeFrame), frameCount - 1);
+		next = glm::min(current + 1, frameCount - 1);
+	}
+
+	frameA = static_cast<int>(clip->FirstFrame + current);
+	frameB = static_cast<int>(clip->FirstFrame + next);
+	return true;
+}
+
+void Animator::_EnterState(int state, float crossfade) {
+	// We can only crossfade between clips that share a mesh, otherwise the vertices won't line up
+	if (crossfade > 0.0f && _state != -1 && States[_state].Mesh == States[state].Mesh) {
+		_previous = _state;
+		_previousTime = _time;
+		_fadeElapsed = 0.0f;
+		_fadeDuration = crossfade;
+	} else {
+		_previous = -1;
+		_fadeElapsed = _fadeDuration = 0.0f;
+	}
+	_state = state;
+	_time = 0.0f;
+	_ApplyMesh();
+}
+
+void Animator::_ApplyMesh() {
+	const State* state = GetState();
+	if (state == nullptr || state->Mesh == nullptr || GetGameObject() == nullptr) {
+		return;
+	}
+	RenderComponent::Sptr renderer = GetComponent<RenderComponent>();
+	if (renderer != nullptr && renderer->GetMeshResource() != state->Mesh) {
+		renderer->SetMesh(state->Mesh);
+	}
+}
@@ -0,0 +1,195 @@
+#pragma once
+#include "IComponent.h"
+#include "Gameplay/AnimatedMeshResource.h"
+#include "Graphics/Shader.h"
+
+/// <summary>
+/// Plays the clips of AnimatedMeshResources on the game object's RenderComponent, using a small
+/// state machine. Each state plays a single clip, and transitions move between states when all
+/// of their conditions on the animator's bool parameters are met, so game code only needs to
+/// set parameters (ex: SetBool("flying", true)) and the graph decides what to play
+///
+/// Clips are sampled by normalized time, which is advanced by the frame's delta time, so the
+/// cost is the same every frame and playback speed does not depend on the frame rate. When a
+/// transition has a duration, the old and new states are crossfaded on the GPU, as long as both
+/// clips are on the same mesh (otherwise we have no way to line up their vertices, and the
+/// new state starts right away)
+///
+/// The object's material should use vertex_shader_vat.glsl, any other shader will only draw
+/// the mesh's base pose
+/// </summary>
+class Animator : public Gameplay::IComponent {
+public:
+	typedef std::shared_ptr<Animator> Sptr;
+
+	/// <summary>
+	/// A node in the state graph, which plays a single clip
+	/// </summary>
+	struct State {
+		std::string                          Name;
+		Gameplay::AnimatedMeshResource::Sptr Mesh;
+		/// <summary>
+		/// The name of the clip in Mesh to play
+		/// </summary>
+		std::string                          Clip;
+		/// <summary>
+		/// Multiplier for the clip's frame rate
+		/// </summary>
+		float                                Speed = 1.0f;
+		/// <summary>
+		/// True if the clip should wrap back to the start, otherwise it will hold on the last frame
+		/// </summary>
+		bool                                 Looping = true;
+	};
+
+	/// <summary>
+	/// A check against one of the animator's parameters
+	/// </summary>
+	struct Condition {
+		std::string Parameter;
+		bool        Value = true;
+	};
+
+	/// <summary>
+	/// An edge in the state graph, taken as soon as all it's conditions are met. Transitions are
+	/// checked in order, so earlier transitions win when more than one could be taken
+	/// </summary>
+	struct Transition {
+		/// <summary>
+		/// The name of the state to leave, or ANY_STATE to allow this transition from every state
+		/// </summary>
+		std::string            From;
+		std::string            To;
+		std::vector<Condition> Conditions;
+		/// <summary>
+		/// How long to crossfade between the two states, in seconds
+		/// </summary>
+		float                  Duration = 0.0f;
+	};
+
+	/// <summary>
+	/// Use as the From state for transitions that can be taken from any state
+	/// </summary>
+	static const std::string ANY_STATE;
+
+	Animator();
+	virtual ~Animator();
+
+	/// <summary>
+	/// Multiplier for the playback speed of every state
+	/// </summary>
+	float Speed;
+	/// <summary>
+	/// True to stop advancing the current clip, transitions will still be taken
+	/// </summary>
+	bool  Paused;
+
+	/// <summary>
+	/// The nodes in the state graph, the first state is the one we start in
+	/// </summary>
+	std::vector<State>      States;
+	/// <summary>
+	/// The edges between the states
+	/// </summary>
+	std::vector<Transition> Transitions;
+
+	/// <summary>
+	/// Sets one of the parameters that transitions check against
+	/// </summary>
+	void SetBool(const std::string& name, bool value);
+	/// <summary>
+	/// Gets a parameter's value, parameters that were never set are false
+	/// </summary>
+	bool GetBool(const std::string& name) const;
+
+	/// <summary>
+	/// Moves straight to the given state, starting it's clip from the beginning
+	/// </summary>
+	/// <param name="state">The name of the state to play</param>
+	/// <param name="crossfade">How long to crossfade from the current state, in seconds</param>
+	void Play(const std::string& state, float crossfade = 0.0f);
+	/// <summary>
+	/// Gets the state that is currently playing, or nullptr if there is none
+	/// </summary>
+	const State* GetState() const;
+	/// <summary>
+	/// Gets how far we are through the current state's clip, from 0 to 1
+	/// </summary>
+	float GetNormalizedTime() const { return _time; }
+
+	/// <summary>
+	/// Binds the mesh's vertex animation texture and uploads the keyframes to blend between,
+	/// should be called right before drawing the object
+	/// </summary>
+	/// <param name="shader">The shader that will be used to draw the object</param>
+	void Apply(const Shader::Sptr& shader);
+
+	// Inherited from IComponent
+
+	virtual void Awake() override;
+	virtual void Update(float deltaTime) override;
+	virtual void RenderImGui() override;
+	virtual void WriteSnapshot(Gameplay::SceneSnapshot& snapshot) const override;
+	virtual void ReadSnapshot(Gameplay::SceneSnapshot& snapshot) override;
+	virtual nlohmann::json ToJson() const override;
+	static Animator::Sptr FromJson(const nlohmann::json& blob);
+	MAKE_TYPENAME(Animator);
+
+protected:
+	struct Parameter {
+		std::string Name;
+		bool        Value;
+	};
+	std::vector<Parameter> _parameters;
+
+	// The state we are playing, and how far through it we are
+	int   _state;
+	float _time;
+
+	// The state we are fading out of, if we're part way through a transition
+	int   _previous;
+	float _previousTime;
+	float _fadeElapsed;
+	float _fadeDuration;
+
+	// The locations of our uniforms in the shader we last applied to, so we only have to look
+	// them up again when we're drawn with a different shader. -1 for uniforms it doesn't have
+	struct UniformLocations {
+		int FrameA;
+		int FrameB;
+		int MorphT;
+		int FadeFrameA;
+		int FadeFrameB;
+		int FadeMorphT;
+		int Fade;
+		int DeltaScale;
+	};
+	std::weak_ptr<Shader> _uniformShader;
+	UniformLocations      _uniforms;
+
+	/// <summary>
+	/// Gets the index of the state with the given name, or -1 if there is no such state
+	/// </summary>
+	int _FindState(const std::string& name) const;
+	/// <summary>
+	/// Gets the clip that a state plays, or nullptr if it can't be found
+	/// </summary>
+	const Gameplay::AnimatedMeshResource::Clip* _GetClip(int state) const;
+	/// <summary>
+	/// Advances a normalized time for the given state by the given number of seconds
+	/// </summary>
+	float _Advance(int state, float time, float deltaTime) const;
+	/// <summary>
+	/// Works out the two keyframes in the VAT to blend between, and how far we are between them
+	/// </summary>
+	/// <returns>True if the state has a clip to sample</returns>
+	bool _Sample(int state, float time, int& frameA, int& frameB, float& blend) const;
+	/// <summary>
+	/// Moves to a new state, fading out the current one over the given duration
+	/// </summary>
+	void _EnterState(int state, float crossfade);
+	/// <summary>
+	/// Sets the current state's mesh as the mesh of the game object's renderer
+	/// </summary>
+	void _ApplyMesh();
+};
@@ -5,6 +5,7 @@
 #include "Utils/GlmDefines.h"
 #include "Gameplay/GameObject.h"
 #include "Utils/ImGuiHelper.h"
+#include "Gameplay/SceneSnapshot.h"
 
 namespace Gameplay {
 	void Camera::RenderImGui()
@@ -25,6 +26,23 @@ namespace Gameplay {
 		}
 	}
 
+	void Camera::WriteSnapshot(SceneSnapshot& snapshot) const {
+		snapshot.Write(_nearPlane);
+		snapshot.Write(_farPlane);
+		snapshot.Write(_fovRadians);
+		snapshot.Write(_orthoVerticalScale);
+		snapshot.Write(_isOrtho);
+	}
+
+	void Camera::ReadSnapshot(SceneSnapshot& snapshot) {
+		snapshot.Read(_nearPlane);
+		snapshot.Read(_farPlane);
+		snapshot.Read(_fovRadians);
+		snapshot.Read(_orthoVerticalScale);
+		snapshot.Read(_isOrtho);
+		_isProjectionDirty = true;
+	}
+
 	nlohmann::json Camera::ToJson() const
 	{
 		return {
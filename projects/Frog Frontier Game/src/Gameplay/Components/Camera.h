@@ -20,8 +20,10 @@ namespace Gameplay {
 	// IComponent implementation
 	public:
 		virtual void RenderImGui() override;
+		virtual void WriteSnapshot(SceneSnapshot& snapshot) const override;
+		virtual void ReadSnapshot(SceneSnapshot& snapshot) override;
 
-		MAKE_TYPENAME(Camera);
+		MAKE_TYPENAME(Gameplay::Camera);
 
 		virtual nlohmann::json ToJson() const override;
 		static Camera::Sptr FromJson(const nlohmann::json& data);
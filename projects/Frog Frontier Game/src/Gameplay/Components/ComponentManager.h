@@ -1,10 +1,13 @@
 #pragma once
 #include <functional>
 #include "IComponent.h"
-#include <typeindex>
-#include <optional>
+#include <vector>
+#include <unordered_map>
 
 namespace Gameplay {
+	template <typename T>
+	struct ComponentHandle;
+
 	/// <summary>
 	/// Helper class for component types, this class is what lets us load component types
 	/// from scene files, as well as providing a way to iterate over all active components
@@ -14,6 +17,19 @@ namespace Gameplay {
 	public:
 		typedef std::function<IComponent::Sptr(const nlohmann::json&)> LoadComponentFunc;
 
+		/// <summary>
+		/// Gets the small integer ID for a component type. IDs are handed out the first
+		/// time a type is seen, and are dense so they can be used to index into arrays.
+		/// Note that these are only stable for a single run, use T::TypeHash for anything
+		/// that needs to be saved
+		/// </summary>
+		/// <typeparam name="T">The type of component to get the ID for</typeparam>
+		template <typename T>
+		static IComponent::TypeId GetTypeId() {
+			static const IComponent::TypeId id = _NextTypeId++;
+			return id;
+		}
+
 		/// <summary>
 		/// Loads a component with the given type name from a JSON blob
 		/// If the type name does not correspond to a registered type, will
@@ -23,24 +39,36 @@ namespace Gameplay {
 		/// <param name="blob">The JSON blob to decode</param>
 		/// <returns>The component as decoded from the JSON data, or nullptr</returns>
 		static IComponent::Sptr Load(const std::string& typeName, const nlohmann::json& blob) {
-			// Try and get the type index from the name
-			std::optional<std::type_index> typeIndex = _TypeNameMap[typeName];
+			return Load(const_hash_fnv1a(typeName.c_str()), blob);
+		}
+
+		/// <summary>
+		/// Loads a component with the given type name hash from a JSON blob
+		/// If the hash does not correspond to a registered type, will
+		/// return nullptr
+		/// </summary>
+		/// <param name="typeHash">The hash of the type's name (see MAKE_STATIC_TYPENAME)</param>
+		/// <param name="blob">The JSON blob to decode</param>
+		/// <returns>The component as decoded from the JSON data, or nullptr</returns>
+		static IComponent::Sptr Load(uint32_t typeHash, const nlohmann::json& blob) {
+			// Try and get the type ID from the hash of the name
+			auto it = _TypeNameMap.find(typeHash);
 
-			// If we have a value for type index, this component type was registered!
-			if (typeIndex.has_value()) {
+			// If we have a value for type ID, this component type was registered!
+			if (it != _TypeNameMap.end()) {
 				// Get the load callback and make sure it exists
-				LoadComponentFunc callback = _TypeLoadRegistry[typeIndex.value()];
+				LoadComponentFunc callback = _TypeLoadRegistry[it->second];
 				if (callback) {
 					// Invoke the loader, also load additional component data
 					IComponent::Sptr result = callback(blob);
 					IComponent::LoadBaseJson(result, blob);
 
 					// Make sure the component knows it's own type
-					result->_realType = typeIndex.value();
+					result->_typeId = it->second;
 					result->_weakSelfPtr = result;
 
 					// Add the component to the global pools
-					_Components[result->_realType].push_back(result);
+					_AddToPool(result.get());
 					return result;
 				}
 			}
@@ -59,20 +87,19 @@ namespace Gameplay {
 			typename ... TArgs, 
 			typename = typename std::enable_if<std::is_base_of<IComponent, ComponentType>::value>::type>
 		static std::shared_ptr<ComponentType> Create(TArgs&& ... args) {
-			// We can use typeid and type_index to get a unique ID for our types
-			std::type_index type = std::type_index(typeid(ComponentType));
-			LOG_ASSERT(_TypeLoadRegistry[type] != nullptr, "You must register component types before creating them!");
+			IComponent::TypeId type = GetTypeId<ComponentType>();
+			LOG_ASSERT(_IsRegistered(type), "You must register component types before creating them!");
 
 			// Create component, forwarding arguments
 			std::shared_ptr<ComponentType> component = std::make_shared<ComponentType>(std::forward<TArgs>(args)...);
 
 			// Make sure the component knows it's concrete type
-			component->_realType = type;
+			component->_typeId = type;
 			// Give the component a weak pointer to itself that it can upcast to a shared pointer when needed
 			component->_weakSelfPtr = component;
 
-			// Add to global component list for that type
-			_Components[type].push_back(component);
+			// Add to global component pool for that type
+			_AddToPool(component.get());
 
 			// Return the result
 			return component;
@@ -89,53 +116,169 @@ namespace Gameplay {
 			typename ComponentType,
 			typename = typename std::enable_if<std::is_base_of<IComponent, ComponentType>::value>::type>
 		static std::shared_ptr<ComponentType> GetComponentByGUID(Guid id) {
-			// We can use typeid and type_index to get a unique ID for our types
-			std::type_index type = std::type_index(typeid(ComponentType));
-			LOG_ASSERT(_TypeLoadRegistry[type] != nullptr, "You must register component types before creating them!");
-
-			// Clear any dead weak pointers
-			std::remove_if(_Components[type].begin(), _Components[type].end(), [](const std::weak_ptr<IComponent>& ptr) {
-				return ptr.expired();
-			});
-
-			// Search the component store for a component that matches that ID
-			auto& it = std::find_if(_Components[type].begin(), _Components[type].end(), [&](const std::weak_ptr<IComponent>& ptr) {
-				return (ptr.lock())->GetGUID() == id;
-			});
-
-			// If the component was found, return it. Otherwise return nullptr
-			if (it != _Components[type].end()) {
-				// We need to lock the weak pointer to convert it to a shared ptr
-				return std::dynamic_pointer_cast<ComponentType>((*it).lock());
-			} else {
-				return nullptr;
+			IComponent::TypeId type = GetTypeId<ComponentType>();
+			LOG_ASSERT(_IsRegistered(type), "You must register component types before creating them!");
+
+			// Search the component pool for a component that matches that ID
+			for (IComponent* component : _Pools[type].Dense) {
+				if (component != nullptr && component->GetGUID() == id) {
+					// We need to lock the self pointer to get a shared ptr to hand out
+					return std::static_pointer_cast<ComponentType>(component->_weakSelfPtr.lock());
+				}
 			}
+			return nullptr;
 		}
 
 		/// <summary>
-		/// Iterates over all components of the given type and invokes a method with them
+		/// Iterates over all components of the given type and invokes a method with them. The
+		/// callback is invoked with a raw pointer to the component, and is not type erased, so
+		/// this is a straight walk over the pool for that type. Callbacks may create, destroy,
+		/// attach or detach components of the same type; removals are deferred until the
+		/// outermost Each over the pool returns, so every component is visited exactly once
 		/// </summary>
 		/// <typeparam name="ComponentType">The type of component to iterate on</typeparam>
+		/// <typeparam name="Func">The type of the callback, should be callable with a ComponentType*</typeparam>
 		/// <param name="callback">The callback to invoke with the components</param>
 		/// <param name="includeDisabled">True to include disabled components, false if otherwise</param>
 		template <
 			typename ComponentType,
+			typename Func,
 			typename = typename std::enable_if<std::is_base_of<IComponent, ComponentType>::value>::type>
-		static void Each(std::function<void(const std::shared_ptr<ComponentType>&)> callback, bool includeDisabled = false) {
-			// We can use typeid and type_index to get a unique ID for our types
-			std::type_index type = std::type_index(typeid(ComponentType));
-			LOG_ASSERT(_TypeLoadRegistry[type] != nullptr, "You must register component types before creating them!");
-
-			// Iterate over all the components in the store
-			for (auto& wptr : _Components[type]) {
-				// Lock the weak pointer to get a shared pointer (maybe)
-				std::shared_ptr<IComponent> sptr = wptr.lock();
-				// If the pointer is alive and matches our enabled criteria, invoke the callback
-				if (sptr && sptr->IsEnabled | includeDisabled) {
-					// Upcast to component type and invoke the callback
-					callback(std::dynamic_pointer_cast<ComponentType>(sptr));
+		static void Each(Func&& callback, bool includeDisabled = false) {
+			IComponent::TypeId type = GetTypeId<ComponentType>();
+			LOG_ASSERT(_IsRegistered(type), "You must register component types before creating them!");
+
+			// We iterate by index, since callbacks are allowed to create new components. While
+			// we are iterating, removals leave a hole instead of swapping the last component in
+			Pool& pool = _Pools[type];
+			pool.IterationDepth++;
+			for (size_t ix = 0; ix < pool.Dense.size(); ix++) {
+				IComponent* component = pool.Dense[ix];
+				// If the component matches our enabled criteria, invoke the callback. The pool
+				// only ever holds components of exactly this type, so the static cast is safe
+				if (component != nullptr && (component->IsEnabled | includeDisabled)) {
+					callback(static_cast<ComponentType*>(component));
 				}
 			}
+
+			// Once the outermost iteration is done we can pack the pool again
+			pool.IterationDepth--;
+			if (pool.IterationDepth == 0 && pool.HoleCount > 0) {
+				_Compact(pool);
+			}
+		}
+
+		/// <summary>
+		/// Gets a handle to the given component, which can be held onto without keeping the
+		/// component alive, and will resolve to nullptr once the component has been destroyed
+		/// </summary>
+		/// <typeparam name="ComponentType">The type of component to get a handle for</typeparam>
+		/// <param name="component">The component to get a handle to, or nullptr for an empty handle</param>
+		template <
+			typename ComponentType,
+			typename = typename std::enable_if<std::is_base_of<IComponent, ComponentType>::value>::type>
+		static ComponentHandle<ComponentType> GetHandle(const ComponentType* component) {
+			ComponentHandle<ComponentType> result;
+			if (component != nullptr && component->_typeId != IComponent::InvalidTypeId) {
+				result._slot = component->_slot;
+				result._generation = _Pools[component->_typeId].Slots[component->_slot].Generation;
+			}
+			return result;
+		}
+
+		/// <summary>
+		/// Resolves a handle to the component it refers to
+		/// </summary>
+		/// <typeparam name="ComponentType">The type of component the handle refers to</typeparam>
+		/// <param name="handle">The handle to resolve</param>
+		/// <returns>The component, or nullptr if the handle is empty or the component has been destroyed</returns>
+		template <
+			typename ComponentType,
+			typename = typename std::enable_if<std::is_base_of<IComponent, ComponentType>::value>::type>
+		static ComponentType* Resolve(const ComponentHandle<ComponentType>& handle) {
+			IComponent::TypeId type = GetTypeId<ComponentType>();
+			if (handle._slot == InvalidSlot || !_IsRegistered(type)) {
+				return nullptr;
+			}
+
+			// If the slot has been freed since the handle was made, the generation will have moved on
+			const Pool& pool = _Pools[type];
+			const Slot& slot = pool.Slots[handle._slot];
+			if (slot.Generation != handle._generation || slot.DenseIndex == InvalidSlot) {
+				return nullptr;
+			}
+			return static_cast<ComponentType*>(pool.Dense[slot.DenseIndex]);
+		}
+
+		/// <summary>
+		/// Gets the number of components of the given type in it's pool, not including detached components
+		/// </summary>
+		/// <typeparam name="ComponentType">The type of component to count</typeparam>
+		template <
+			typename ComponentType,
+			typename = typename std::enable_if<std::is_base_of<IComponent, ComponentType>::value>::type>
+		static size_t GetCount() {
+			IComponent::TypeId type = GetTypeId<ComponentType>();
+			return _IsRegistered(type) ? _Pools[type].Dense.size() - _Pools[type].HoleCount : 0;
+		}
+
+		/// <summary>
+		/// Gets the number of handle slots the pool for the given type has allocated, including free
+		/// ones. This is the most components of the type that have been alive at once
+		/// </summary>
+		/// <typeparam name="ComponentType">The type of component to get the pool size for</typeparam>
+		template <
+			typename ComponentType,
+			typename = typename std::enable_if<std::is_base_of<IComponent, ComponentType>::value>::type>
+		static size_t GetSlotCount() {
+			IComponent::TypeId type = GetTypeId<ComponentType>();
+			return _IsRegistered(type) ? _Pools[type].Slots.size() : 0;
+		}
+
+		/// <summary>
+		/// Gets the size of the concrete type of a component in bytes, not including anything it
+		/// allocates itself. Returns 0 for components that were not made by the ComponentManager
+		/// </summary>
+		static size_t GetSize(const IComponent* component) {
+			return component->_typeId < _TypeSizes.size() ? _TypeSizes[component->_typeId] : 0;
+		}
+
+		/// <summary>
+		/// Takes a component out of the pool for it's type without destroying it, so that it is
+		/// skipped by Each and GetComponentByGUID. This is used for scenes that are kept loaded
+		/// but are not being played (see SceneCache). Handles to the component will resolve to
+		/// nullptr until it is attached again
+		/// </summary>
+		/// <param name="component">The component to detach, does nothing if it is already detached</param>
+		static void Detach(IComponent* component) {
+			if (component->_typeId == IComponent::InvalidTypeId) {
+				return;
+			}
+
+			Pool& pool = _Pools[component->_typeId];
+			Slot& slot = pool.Slots[component->_slot];
+			if (slot.DenseIndex != InvalidSlot) {
+				_RemoveFromDense(pool, slot);
+				slot.DenseIndex = InvalidSlot;
+			}
+		}
+
+		/// <summary>
+		/// Puts a component that was removed with Detach back into the pool for it's type. The
+		/// component keeps it's slot, so handles made before it was detached are valid again
+		/// </summary>
+		/// <param name="component">The component to attach, does nothing if it is already attached</param>
+		static void Attach(IComponent* component) {
+			if (component->_typeId == IComponent::InvalidTypeId) {
+				return;
+			}
+
+			Pool& pool = _Pools[component->_typeId];
+			Slot& slot = pool.Slots[component->_slot];
+			if (slot.DenseIndex == InvalidSlot) {
+				slot.DenseIndex = static_cast<uint32_t>(pool.Dense.size());
+				pool.Dense.push_back(component);
+			}
 		}
 
 		/// <summary>
@@ -149,55 +292,196 @@ namespace Gameplay {
 			static_assert(is_valid_component<T>(), "Type is not a valid component type!");
 
 			// We use the type ID to map types to the underlying helpers
-			std::type_index type(typeid(T));
+			IComponent::TypeId type = GetTypeId<T>();
+
+			// Make sure our per-type storage is large enough to hold this type
+			if (_TypeLoadRegistry.size() <= type) {
+				_TypeLoadRegistry.resize(type + 1);
+				_TypeSizes.resize(type + 1);
+				_Pools.resize(type + 1);
+			}
+			_TypeSizes[type] = sizeof(T);
 
 			// if type NOT registered
-			if (_TypeLoadRegistry.find(type) == _TypeLoadRegistry.end()) {
+			if (_TypeLoadRegistry[type] == nullptr) {
+				LOG_ASSERT(_TypeNameMap.find(T::TypeHash) == _TypeNameMap.end(), "Component type name hash collision for {}!", T::TypeName);
+
 				// Store the loading function in the registry, as well as the
-				// name to type index mapping
+				// name hash to type ID mapping
 				_TypeLoadRegistry[type] = &ComponentManager::ParseTypeFromBlob<T>;
-				_TypeNameMap[StringTools::SanitizeClassName(typeid(T).name())] = type;
+				_TypeNameMap[T::TypeHash] = type;
 			}
 		}
 
 	private:
 		// Give component friend access so it can call Remove
 		friend class IComponent;
+		template <typename T>
+		friend struct ComponentHandle;
+
+		// The next ID to hand out in GetTypeId
+		inline static IComponent::TypeId _NextTypeId = 0;
 
-		// This maps a readable type name to it's type_index. We use optional in case we try and access
-		// an element that does not have a type (and unordered_map requires a default constructor, which
-		// std::type_index does not have)
-		inline static std::unordered_map<std::string, std::optional<std::type_index>> _TypeNameMap;
-		// Stores functions to load components from JSON, indexed on the type that they load
-		inline static std::unordered_map<std::type_index, LoadComponentFunc> _TypeLoadRegistry;
+		// This maps the hash of a type's name (see MAKE_TYPENAME) to it's type ID
+		inline static std::unordered_map<uint32_t, IComponent::TypeId> _TypeNameMap;
+		// Stores functions to load components from JSON, indexed on the ID of the type that they load
+		inline static std::vector<LoadComponentFunc> _TypeLoadRegistry;
+		// Stores the sizeof each registered type, indexed on type ID
+		inline static std::vector<size_t> _TypeSizes;
 
-		// Weak pointers let us store a reference to an object stored by a shared pointer, without
-		// actually increasing the reference count. Thus components will be destroyed at the correct
-		// time (when the only reference is the one stored here).
-		inline static std::unordered_map<std::type_index, std::vector<std::weak_ptr<IComponent>>> _Components;  
+		// Marks a handle that does not refer to any slot
+		static constexpr uint32_t InvalidSlot = ~0u;
+
+		/// <summary>
+		/// Maps a handle's slot to the component's position in the dense array. The
+		/// generation is bumped whenever the slot is freed, invalidating old handles.
+		/// DenseIndex is InvalidSlot while the component is detached
+		/// </summary>
+		struct Slot {
+			uint32_t DenseIndex;
+			uint32_t Generation;
+		};
+
+		/// <summary>
+		/// Storage for all live components of a single type. Dense is packed with no gaps so
+		/// it can be walked linearly, and is kept packed by swap and pop removal. Slots give
+		/// handles a stable index, and freed slots are recycled, so neither array grows past
+		/// the most components of this type that have been alive at once. While the pool is
+		/// being walked by Each, removed entries are set to nullptr and counted in HoleCount
+		/// </summary>
+		struct Pool {
+			std::vector<IComponent*> Dense;
+			std::vector<Slot>        Slots;
+			std::vector<uint32_t>    FreeSlots;
+			uint32_t                 IterationDepth = 0;
+			uint32_t                 HoleCount = 0;
+		};
+
+		// Dense per-type pools of live components, indexed on type ID. We store raw pointers here,
+		// the components are owned by their game objects and will remove themselves from the pool
+		// in their destructor, so the pool never holds dead entries (only nullptr holes during Each)
+		inline static std::vector<Pool> _Pools;
 
 		template <typename T>
 		static IComponent::Sptr ParseTypeFromBlob(const nlohmann::json& blob) {
 			return T::FromJson(blob);
 		}
 
+		/// <summary>
+		/// Returns true if the given type ID belongs to a registered type
+		/// </summary>
+		inline static bool _IsRegistered(IComponent::TypeId type) {
+			return type < _TypeLoadRegistry.size() && _TypeLoadRegistry[type] != nullptr;
+		}
+
+		/// <summary>
+		/// Adds a component to the pool for it's type, the component's type ID must be set
+		/// </summary>
+		inline static void _AddToPool(IComponent* component) {
+			Pool& pool = _Pools[component->_typeId];
+
+			// Re-use a free slot if we have one, otherwise make a new one
+			if (pool.FreeSlots.empty()) {
+				component->_slot = static_cast<uint32_t>(pool.Slots.size());
+				pool.Slots.push_back({ 0, 0 });
+			} else {
+				component->_slot = pool.FreeSlots.back();
+				pool.FreeSlots.pop_back();
+			}
+
+			pool.Slots[component->_slot].DenseIndex = static_cast<uint32_t>(pool.Dense.size());
+			pool.Dense.push_back(component);
+		}
+
+		/// <summary>
+		/// Removes the component in the given slot from the dense array by moving the last
+		/// component into it's place, and pointing that component's slot at it's new home. If
+		/// the pool is being iterated, the entry is cleared instead so nothing moves under Each
+		/// </summary>
+		inline static void _RemoveFromDense(Pool& pool, const Slot& slot) {
+			if (pool.IterationDepth > 0) {
+				pool.Dense[slot.DenseIndex] = nullptr;
+				pool.HoleCount++;
+				return;
+			}
+
+			IComponent* last = pool.Dense.back();
+			pool.Dense[slot.DenseIndex] = last;
+			pool.Slots[last->_slot].DenseIndex = slot.DenseIndex;
+			pool.Dense.pop_back();
+		}
+
+		/// <summary>
+		/// Removes the holes left by removals during Each, keeping the order of the remaining
+		/// components and pointing their slots at their new positions
+		/// </summary>
+		inline static void _Compact(Pool& pool) {
+			uint32_t write = 0;
+			for (size_t read = 0; read < pool.Dense.size(); read++) {
+				IComponent* component = pool.Dense[read];
+				if (component != nullptr) {
+					pool.Dense[write] = component;
+					pool.Slots[component->_slot].DenseIndex = write;
+					write++;
+				}
+			}
+			pool.Dense.resize(write);
+			pool.HoleCount = 0;
+		}
+
 		/// <summary>
 		/// Removes a given component from the global pools. To be used in the IComponent destructor
 		/// </summary>
-		/// <typeparam name="ComponentType">The type of component to destroy</typeparam>
 		/// <param name="component">A raw pointer to the component to remove (should be called from IComponent destructor)</param>
-		/// <returns>True if the element was removed, false if not</returns>
 		inline static void Remove(const IComponent* component) {
+			// Components that were never added to a pool have nothing to remove
+			if (component->_typeId == IComponent::InvalidTypeId) {
+				return;
+			}
+
 			// Make sure the component's type was one that was registered
-			LOG_ASSERT(_TypeLoadRegistry[component->_realType] != nullptr, "You must register component types before creating them!");
+			LOG_ASSERT(_IsRegistered(component->_typeId), "You must register component types before creating them!");
 
-			// Get a reference to the vector of components for easy access
-			auto& componentStore = _Components[component->_realType];
+			// Get a reference to the pool of components for easy access
+			Pool& pool = _Pools[component->_typeId];
+			Slot& slot = pool.Slots[component->_slot];
+
+			// Detached components are already out of the dense array
+			if (slot.DenseIndex != InvalidSlot) {
+				LOG_ASSERT(pool.Dense[slot.DenseIndex] == component, "Component pool is out of sync with it's slots!");
+				_RemoveFromDense(pool, slot);
+			}
 
-			// Clear any dead weak pointers
-			std::remove_if(componentStore.begin(), componentStore.end(), [](const std::weak_ptr<IComponent>& ptr) {
-				return ptr.expired();
-			});
+			// Bump the generation so any outstanding handles to this slot are invalidated, and recycle it
+			slot.Generation++;
+			pool.FreeSlots.push_back(component->_slot);
 		}
 	};
-}
\ No newline at end of file
+
+	/// <summary>
+	/// A weak reference to a component that does not keep it alive or touch any reference
+	/// counts. Use ComponentManager::GetHandle to make one, and Get to resolve it, which will
+	/// return nullptr if the component has since been destroyed
+	/// </summary>
+	/// <typeparam name="T">The type of component that this handle refers to</typeparam>
+	template <typename T>
+	struct ComponentHandle {
+		ComponentHandle() :
+			_slot(ComponentManager::InvalidSlot),
+			_generation(0)
+		{ }
+
+		/// <summary>
+		/// Gets the component this handle refers to, or nullptr if it no longer exists
+		/// </summary>
+		T* Get() const {
+			return ComponentManager::Resolve<T>(*this);
+		}
+
+	private:
+		friend class ComponentManager;
+
+		uint32_t _slot;
+		uint32_t _generation;
+	};
+}
@@ -26,7 +26,8 @@ namespace Gameplay {
 	IComponent::IComponent() :
 		IResource(),
 		IsEnabled(true),
-		_realType(typeid(IComponent)),
+		_typeId(InvalidTypeId),
+		_slot(0),
 		_context(nullptr)
 	{ }
 
@@ -10,6 +10,7 @@
 namespace Gameplay {
 	// We pre-declare GameObject to avoid circular dependencies in the headers
 	class GameObject;
+	class SceneSnapshot;
 
 	namespace Physics {
 		class TriggerVolume;
@@ -29,6 +30,12 @@ namespace Gameplay {
 	class IComponent : public IResource {
 	public:
 		typedef std::shared_ptr<IComponent> Sptr;
+		typedef uint32_t TypeId;
+
+		/// <summary>
+		/// The type ID for components that have not been added to the component pools
+		/// </summary>
+		static constexpr TypeId InvalidTypeId = ~0u;
 
 		/// <summary>
 		/// True when this component is enabled and should perform update and 
@@ -85,6 +92,19 @@ namespace Gameplay {
 		/// <param name="deltaTime">The time since the last frame, in seconds</param>
 		virtual void Update(float deltaTime) {};
 
+		/// <summary>
+		/// Writes any state that can change while the scene is playing into a snapshot, so it
+		/// can be restored when leaving play mode. Components with no such state can skip this
+		/// </summary>
+		/// <param name="snapshot">The snapshot to write to</param>
+		virtual void WriteSnapshot(SceneSnapshot& snapshot) const {};
+		/// <summary>
+		/// Restores the state written by WriteSnapshot in place, must read back exactly what
+		/// was written
+		/// </summary>
+		/// <param name="snapshot">The snapshot to read from</param>
+		virtual void ReadSnapshot(SceneSnapshot& snapshot) {};
+
 		/// <summary>
 		/// All components should override this to allow us to render component
 		/// info in ImGui for easy editing
@@ -97,7 +117,7 @@ namespace Gameplay {
 		/// To override in child classes, use MAKE_TYPENAME(Type) instead of
 		/// manually implementing, otherwise serialization may have isues
 		/// </summary>
-		virtual std::string ComponentTypeName() const = 0;
+		virtual const char* ComponentTypeName() const = 0;
 
 		/// <summary>
 		/// Gets the gameobject that this component is attached to
@@ -144,8 +164,12 @@ namespace Gameplay {
 	private:
 		friend class ComponentManager;
 		friend class GameObject;
+		// Snapshots need to check component types
+		friend class Scene;
 
-		std::type_index _realType;
+		TypeId _typeId;
+		// Our slot in the component pool for our type, see ComponentManager
+		uint32_t _slot;
 		GameObject* _context;
 
 		// By storing a weak pointer to ourselves, we can pass a pointer to this
@@ -166,7 +190,8 @@ namespace Gameplay {
 	}
 }
 
-// Defines the ComponentTypeName interface to match those used elsewhere by other systems
+// Defines the ComponentTypeName interface to match those used elsewhere by other systems,
+// T should be the fully qualified name of the component type
 #define MAKE_TYPENAME(T) \
-	inline virtual std::string ComponentTypeName() const { \
-		static std::string name = StringTools::SanitizeClassName(typeid(T).name()); return name; }
+	MAKE_STATIC_TYPENAME(T) \
+	inline virtual const char* ComponentTypeName() const { return TypeName; }
@@ -2,6 +2,7 @@
 #include <GLFW/glfw3.h>
 #include "Gameplay/GameObject.h"
 #include "Gameplay/Scene.h"
+#include "Gameplay/SceneSnapshot.h"
 #include "Utils/ImGuiHelper.h"
 
 void JumpBehaviour::Awake()
@@ -16,6 +17,20 @@ void JumpBehaviour::RenderImGui() {
 	LABEL_LEFT(ImGui::DragFloat, "Impulse", &_impulse, 1.0f);
 }
 
+void JumpBehaviour::WriteSnapshot(Gameplay::SceneSnapshot& snapshot) const {
+	snapshot.Write(currentHeight);
+	snapshot.Write(_isPressed);
+	snapshot.Write(_isUPPressed);
+	snapshot.Write(fly);
+}
+
+void JumpBehaviour::ReadSnapshot(Gameplay::SceneSnapshot& snapshot) {
+	snapshot.Read(currentHeight);
+	snapshot.Read(_isPressed);
+	snapshot.Read(_isUPPressed);
+	snapshot.Read(fly);
+}
+
 nlohmann::json JumpBehaviour::ToJson() const {
 	return {
 		{ "impulse", _impulse }
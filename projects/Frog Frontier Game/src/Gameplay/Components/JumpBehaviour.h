@@ -22,6 +22,8 @@ public:
 
 public:
 	virtual void RenderImGui() override;
+	virtual void WriteSnapshot(Gameplay::SceneSnapshot& snapshot) const override;
+	virtual void ReadSnapshot(Gameplay::SceneSnapshot& snapshot) override;
 	MAKE_TYPENAME(JumpBehaviour);
 	virtual nlohmann::json ToJson() const override;
 	static JumpBehaviour::Sptr FromJson(const nlohmann::json& blob);
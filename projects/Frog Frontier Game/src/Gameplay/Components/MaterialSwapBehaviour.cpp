@@ -1,6 +1,7 @@
 #include "Gameplay/Components/MaterialSwapBehaviour.h"
 #include "Gameplay/Components/ComponentManager.h"
 #include "Gameplay/GameObject.h"
+#include "Gameplay/SceneSnapshot.h"
 
 MaterialSwapBehaviour::MaterialSwapBehaviour() :
 	IComponent(),
@@ -30,6 +31,17 @@ void MaterialSwapBehaviour::Awake() {
 
 void MaterialSwapBehaviour::RenderImGui() { }
 
+void MaterialSwapBehaviour::WriteSnapshot(Gameplay::SceneSnapshot& snapshot) const {
+	// The renderer's current material is saved by the RenderComponent itself
+	snapshot.WriteResource(EnterMaterial);
+	snapshot.WriteResource(ExitMaterial);
+}
+
+void MaterialSwapBehaviour::ReadSnapshot(Gameplay::SceneSnapshot& snapshot) {
+	EnterMaterial = snapshot.ReadResource(EnterMaterial);
+	ExitMaterial = snapshot.ReadResource(ExitMaterial);
+}
+
 nlohmann::json MaterialSwapBehaviour::ToJson() const {
 	return {
 		{ "enter_material", EnterMaterial != nullptr ? EnterMaterial->GetGUID().str() : "null" },
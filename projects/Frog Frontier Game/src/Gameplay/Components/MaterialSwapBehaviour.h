@@ -24,6 +24,8 @@ public:
 	virtual void OnLeavingTrigger(const std::shared_ptr<Gameplay::Physics::TriggerVolume>& trigger) override;
 	virtual void Awake() override;
 	virtual void RenderImGui() override;
+	virtual void WriteSnapshot(Gameplay::SceneSnapshot& snapshot) const override;
+	virtual void ReadSnapshot(Gameplay::SceneSnapshot& snapshot) override;
 	virtual nlohmann::json ToJson() const override;
 	static MaterialSwapBehaviour::Sptr FromJson(const nlohmann::json& blob);
 	MAKE_TYPENAME(MaterialSwapBehaviour);
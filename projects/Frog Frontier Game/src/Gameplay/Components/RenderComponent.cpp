@@ -1,6 +1,8 @@
 #include "Gameplay/Components/RenderComponent.h"
 
 #include "Utils/ResourceManager/ResourceManager.h"
+#include "Gameplay/SceneSnapshot.h"
+#include "Gameplay/AnimatedMeshResource.h"
 
 
 RenderComponent::RenderComponent(const Gameplay::MeshResource::Sptr& mesh, const Gameplay::Material::Sptr& material) :
@@ -35,6 +37,17 @@ const Gameplay::Material::Sptr& RenderComponent::GetMaterial() const {
 	return _material;
 }
 
+void RenderComponent::WriteSnapshot(Gameplay::SceneSnapshot& snapshot) const {
+	// Behaviours like MaterialSwapBehaviour change these while playing
+	snapshot.WriteResource(_mesh);
+	snapshot.WriteResource(_material);
+}
+
+void RenderComponent::ReadSnapshot(Gameplay::SceneSnapshot& snapshot) {
+	_mesh = snapshot.ReadResource(_mesh);
+	_material = snapshot.ReadResource(_material);
+}
+
 nlohmann::json RenderComponent::ToJson() const {
 	nlohmann::json result;
 	result["mesh"] = _mesh ? _mesh->GetGUID().str() : "null";
@@ -44,7 +57,12 @@ nlohmann::json RenderComponent::ToJson() const {
 
 RenderComponent::Sptr RenderComponent::FromJson(const nlohmann::json& data) {
 	RenderComponent::Sptr result = std::make_shared<RenderComponent>();
-	result->_mesh = ResourceManager::Get<Gameplay::MeshResource>(Guid(data["mesh"].get<std::string>()));
+	Guid meshId = Guid(data["mesh"].get<std::string>());
+	result->_mesh = ResourceManager::Get<Gameplay::MeshResource>(meshId);
+	// Animated meshes are stored under their own type in the resource manager
+	if (result->_mesh == nullptr) {
+		result->_mesh = ResourceManager::Get<Gameplay::AnimatedMeshResource>(meshId);
+	}
 	result->_material = ResourceManager::Get<Gameplay::Material>(Guid(data["material"].get<std::string>()));
 
 	return result;
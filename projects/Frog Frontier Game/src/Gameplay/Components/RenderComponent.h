@@ -45,6 +45,8 @@ public:
 	// Inherited from IComponent
 
 	virtual void RenderImGui() override;
+	virtual void WriteSnapshot(Gameplay::SceneSnapshot& snapshot) const override;
+	virtual void ReadSnapshot(Gameplay::SceneSnapshot& snapshot) override;
 	virtual nlohmann::json ToJson() const override;
 	static RenderComponent::Sptr FromJson(const nlohmann::json& data);
 	MAKE_TYPENAME(RenderComponent);
@@ -4,6 +4,7 @@
 
 #include "Utils/ImGuiHelper.h"
 #include "Utils/JsonGlmHelpers.h"
+#include "Gameplay/SceneSnapshot.h"
 
 void RotatingBehaviour::Update(float deltaTime) {
 	GetGameObject()->SetRotation(GetGameObject()->GetRotationEuler() + RotationSpeed * deltaTime);
@@ -13,6 +14,14 @@ void RotatingBehaviour::RenderImGui() {
 	LABEL_LEFT(ImGui::DragFloat3, "Speed", &RotationSpeed.x);
 }
 
+void RotatingBehaviour::WriteSnapshot(Gameplay::SceneSnapshot& snapshot) const {
+	snapshot.Write(RotationSpeed);
+}
+
+void RotatingBehaviour::ReadSnapshot(Gameplay::SceneSnapshot& snapshot) {
+	snapshot.Read(RotationSpeed);
+}
+
 nlohmann::json RotatingBehaviour::ToJson() const {
 	return {
 		{ "speed", GlmToJson(RotationSpeed) }
@@ -14,6 +14,8 @@ public:
 	virtual void Update(float deltaTime) override;
 
 	virtual void RenderImGui() override;
+	virtual void WriteSnapshot(Gameplay::SceneSnapshot& snapshot) const override;
+	virtual void ReadSnapshot(Gameplay::SceneSnapshot& snapshot) override;
 
 	virtual nlohmann::json ToJson() const override;
 	static RotatingBehaviour::Sptr FromJson(const nlohmann::json& data);
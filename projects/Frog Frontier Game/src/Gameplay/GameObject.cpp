@@ -13,20 +13,23 @@
 #include "Gameplay/Scene.h"
 
 namespace Gameplay {
-	GameObject::GameObject() :
+	GameObject::GameObject(Scene* scene) :
 		Name("Unknown"),
 		GUID(Guid::New()),
+		_transforms(scene->_transforms),
+		_transformIndex(0),
 		_components(std::vector<IComponent::Sptr>()),
-		_scene(nullptr),
-		_position(ZERO),
-		_rotation(glm::quat(glm::vec3(0.0f))),
-		_scale(ONE),
-		_transform(MAT4_IDENTITY),
-		_isTransformDirty(true)
-	{ }
+		_scene(scene)
+	{
+		_transformIndex = _transforms->Allocate();
+	}
+
+	GameObject::~GameObject() {
+		_transforms->Free(_transformIndex);
+	}
 
 	void GameObject::LookAt(const glm::vec3& point) {
-		glm::mat3 rot = glm::lookAt(_position, point, glm::vec3(0.0f, 0.0f, 1.0f));
+		glm::mat3 rot = glm::lookAt(GetPosition(), point, glm::vec3(0.0f, 0.0f, 1.0f));
 		SetRotation(glm::quat(rot));
 	}
 
@@ -56,48 +59,51 @@ namespace Gameplay {
 	}
 
 	void GameObject::SetPostion(const glm::vec3& position) {
-		_position = position;
-		_isTransformDirty = true;
+		_transforms->GetPosition(_transformIndex) = position;
+		_transforms->MarkDirty(_transformIndex);
 	}
 
-	const glm::vec3& GameObject::GetPosition() const {
-		return _position;
+	glm::vec3 GameObject::GetPosition() const {
+		return _transforms->GetPosition(_transformIndex);
 	}
 
 	void GameObject::SetRotation(const glm::quat& value) {
-		_rotation = value;
-		_isTransformDirty = true;
+		_transforms->GetRotation(_transformIndex) = value;
+		_transforms->MarkDirty(_transformIndex);
 	}
 
-	const glm::quat& GameObject::GetRotation() const {
-		return _rotation;
+	glm::quat GameObject::GetRotation() const {
+		return _transforms->GetRotation(_transformIndex);
 	}
 
 	void GameObject::SetRotation(const glm::vec3& eulerAngles) {
-		_rotation = glm::quat(glm::radians(eulerAngles));
-		_isTransformDirty = true;
+		_transforms->GetRotation(_transformIndex) = glm::quat(glm::radians(eulerAngles));
+		_transforms->MarkDirty(_transformIndex);
 	}
 
-	const glm::vec3& GameObject::GetRotationEuler() const {
-		return glm::degrees(glm::eulerAngles(_rotation));
+	glm::vec3 GameObject::GetRotationEuler() const {
+		return glm::degrees(glm::eulerAngles(GetRotation()));
 	}
 
 	void GameObject::SetScale(const glm::vec3& value) {
-		_scale = value;
-		_isTransformDirty = true;
+		_transforms->GetScale(_transformIndex) = value;
+		_transforms->MarkDirty(_transformIndex);
 	}
 
-	const glm::vec3& GameObject::GetScale() const {
-		return _scale;
+	glm::vec3 GameObject::GetScale() const {
+		return _transforms->GetScale(_transformIndex);
 	}
 
 	const glm::mat4& GameObject::GetTransform() const
 	{
-		if (_isTransformDirty) {
-			_transform = glm::translate(MAT4_IDENTITY, _position) * glm::mat4_cast(_rotation) * glm::scale(MAT4_IDENTITY, _scale);
-			_isTransformDirty = false;
-		}
-		return _transform;
+		// Normally the scene will have updated this already in it's batch pass, but if
+		// the object has moved since then this will recalculate just our transform
+		return _transforms->GetWorldMatrix(_transformIndex);
+	}
+
+	const glm::mat3& GameObject::GetNormalMatrix() const
+	{
+		return _transforms->GetNormalMatrix(_transformIndex);
 	}
 
 
@@ -125,16 +131,19 @@ namespace Gameplay {
 			ImGui::Indent();
 
 			// Render position label
-			_isTransformDirty |= LABEL_LEFT(ImGui::DragFloat3, "Position", &_position.x, 0.01f);
+			glm::vec3& position = _transforms->GetPosition(_transformIndex);
+			if (LABEL_LEFT(ImGui::DragFloat3, "Position", &position.x, 0.01f)) {
+				_transforms->MarkDirty(_transformIndex);
+			}
 			
 			// Get the ImGui storage state so we can avoid gimbal locking issues by storing euler angles in the editor
 			glm::vec3 euler = GetRotationEuler();
 			ImGuiStorage* guiStore = ImGui::GetStateStorage();
 
 			// Extract the angles from the storage, note that we're only using the address of the position for unique IDs
-			euler.x = guiStore->GetFloat(ImGui::GetID(&_position.x), euler.x);
-			euler.y = guiStore->GetFloat(ImGui::GetID(&_position.y), euler.y);
-			euler.z = guiStore->GetFloat(ImGui::GetID(&_position.z), euler.z);
+			euler.x = guiStore->GetFloat(ImGui::GetID(&position.x), euler.x);
+			euler.y = guiStore->GetFloat(ImGui::GetID(&position.y), euler.y);
+			euler.z = guiStore->GetFloat(ImGui::GetID(&position.z), euler.z);
 
 			//Draw the slider for angles
 			if (LABEL_LEFT(ImGui::DragFloat3, "Rotation", &euler.x, 1.0f)) {
@@ -142,16 +151,18 @@ namespace Gameplay {
 				euler = Wrap(euler, -180.0f, 180.0f);
 
 				// Update the editor state with our new values
-				guiStore->SetFloat(ImGui::GetID(&_position.x), euler.x);
-				guiStore->SetFloat(ImGui::GetID(&_position.y), euler.y);
-				guiStore->SetFloat(ImGui::GetID(&_position.z), euler.z);
+				guiStore->SetFloat(ImGui::GetID(&position.x), euler.x);
+				guiStore->SetFloat(ImGui::GetID(&position.y), euler.y);
+				guiStore->SetFloat(ImGui::GetID(&position.z), euler.z);
 
 				//Send new rotation to the gameobject
 				SetRotation(euler);
 			}
 			
 			// Draw the scale
-			_isTransformDirty |= LABEL_LEFT(ImGui::DragFloat3, "Scale   ", &_scale.x, 0.01f, 0.0f);
+			if (LABEL_LEFT(ImGui::DragFloat3, "Scale   ", &_transforms->GetScale(_transformIndex).x, 0.01f, 0.0f)) {
+				_transforms->MarkDirty(_transformIndex);
+			}
 
 			ImGui::Separator();
 			ImGui::TextUnformatted("Components");
@@ -159,7 +170,7 @@ namespace Gameplay {
 
 			// Render each component under it's own header
 			for (auto& component : _components) {
-				if (ImGui::CollapsingHeader(component->ComponentTypeName().c_str())) {
+				if (ImGui::CollapsingHeader(component->ComponentTypeName())) {
 					ImGui::PushID(component.get()); 
 					component->RenderImGui();
 					ImGui::PopID();
@@ -174,41 +185,50 @@ namespace Gameplay {
 	{
 		// We need to manually construct since the GameObject constructor is
 		// protected. We can call it here since Scene is a friend class of GameObjects
-		GameObject::Sptr result(new GameObject());
-		result->_scene = scene;
+		GameObject::Sptr result(new GameObject(scene));
 
 		// Load in basic info
 		result->Name = data["name"];
 		result->GUID = Guid(data["guid"]);
-		result->_position = ParseJsonVec3(data["position"]);
-		result->_rotation = ParseJsonQuat(data["rotation"]);
-		result->_scale    = ParseJsonVec3(data["scale"]);
-		result->_isTransformDirty = true;
+		result->SetPostion(ParseJsonVec3(data["position"]));
+		result->SetRotation(ParseJsonQuat(data["rotation"]));
+		result->SetScale(ParseJsonVec3(data["scale"]));
 
 		// Since our components are stored based on the type name, we iterate
 		// on the keys and values from the components object
-		nlohmann::json components = data["components"];
+		const nlohmann::json& components = data["components"];
 		for (auto& [typeName, value] : components.items()) {
 			// We need to reference the component registry to load our components
 			// based on the type name (note that all component types need to be
 			// registered at the start of the application)
-			IComponent::Sptr component = ComponentManager::Load(typeName, value);
-			component->_context = result.get();
-
-			// Add component to object and allow it to perform self initialization
-			result->_components.push_back(component);
-			component->OnLoad();
+			result->_AttachLoadedComponent(ComponentManager::Load(typeName, value));
 		}
 		return result;
 	}
 
+	void GameObject::_AttachLoadedComponent(const IComponent::Sptr& component) {
+		component->_context = this;
+
+		// Add component to object and allow it to perform self initialization
+		_AttachComponent(component);
+		component->OnLoad();
+	}
+
+	void GameObject::_AttachComponent(const IComponent::Sptr& component) {
+		LOG_ASSERT(component->_typeId < MaxComponentTypes, "Too many component types, increase GameObject::MaxComponentTypes");
+
+		_components.push_back(component);
+		_componentSlots[component->_typeId] = component;
+		_componentMask.set(component->_typeId);
+	}
+
 	nlohmann::json GameObject::ToJson() const {
 		nlohmann::json result = {
 			{ "name", Name },
 			{ "guid", GUID.str() },
-			{ "position", GlmToJson(_position) },
-			{ "rotation", GlmToJson(_rotation) },
-			{ "scale",    GlmToJson(_scale) },
+			{ "position", GlmToJson(GetPosition()) },
+			{ "rotation", GlmToJson(GetRotation()) },
+			{ "scale",    GlmToJson(GetScale()) },
 		};
 		result["components"] = nlohmann::json();
 		for (auto& component : _components) {
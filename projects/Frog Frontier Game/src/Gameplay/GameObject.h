@@ -1,5 +1,7 @@
 #pragma once
 #include <string>
+#include <array>
+#include <bitset>
 
 // Utils
 #include "Utils/GUID.hpp"
@@ -9,6 +11,7 @@
 #include "GLM/gtx/common.hpp"
 
 // Others
+#include "Gameplay/TransformStore.h"
 #include "Gameplay/Components/IComponent.h"
 #include "Gameplay/Components/ComponentManager.h"
 
@@ -28,6 +31,11 @@ namespace Gameplay {
 	struct GameObject {
 		typedef std::shared_ptr<GameObject> Sptr;
 
+		/// <summary>
+		/// The most component types we can look up by type slot, see ComponentManager::GetTypeId
+		/// </summary>
+		static constexpr size_t MaxComponentTypes = 32;
+
 		// Human readable name for the object
 		std::string             Name;
 		// Unique ID for the object
@@ -70,9 +78,10 @@ namespace Gameplay {
 		/// <param name="position">The new position for the object in world space</param>
 		void SetPostion(const glm::vec3& position);
 		/// <summary>
-		/// Gets the object's position in world space
+		/// Gets the object's position in world space. The transform getters return copies, since
+		/// the values live in the scene's TransformStore and move whenever it grows
 		/// </summary>
-		const glm::vec3& GetPosition() const;
+		glm::vec3 GetPosition() const;
 
 		/// <summary>
 		/// Sets the rotation of this object to a quaternion value
@@ -82,7 +91,7 @@ namespace Gameplay {
 		/// <summary>
 		/// Gets the object's rotation as a quaternion value
 		/// </summary>
-		const glm::quat& GetRotation() const;
+		glm::quat GetRotation() const;
 
 		/// <summary>
 		/// Sets the rotation of the object in euler degrees (yaw, pitch, roll)
@@ -92,7 +101,7 @@ namespace Gameplay {
 		/// <summary>
 		/// Gets the euler angles from this object in degrees
 		/// </summary>
-		const glm::vec3& GetRotationEuler() const;
+		glm::vec3 GetRotationEuler() const;
 
 		/// <summary>
 		/// Sets the scaling factor for the game object, should be non-zero
@@ -102,12 +111,19 @@ namespace Gameplay {
 		/// <summary>
 		/// Gets the scaling factor for the game object
 		/// </summary>
-		const glm::vec3& GetScale() const;
+		glm::vec3 GetScale() const;
 
 		/// <summary>
-		/// Gets or recalculates and gets the object's world transform
+		/// Gets or recalculates and gets the object's world transform. The reference points into
+		/// the scene's TransformStore, so don't hold onto it across creating new game objects
 		/// </summary>
 		const glm::mat4& GetTransform() const;
+		/// <summary>
+		/// Gets the object's normal matrix, this is cached alongside the world transform
+		/// </summary>
+		const glm::mat3& GetNormalMatrix() const;
+
+		~GameObject();
 
 		/// <summary>
 		/// Returns a pointer to the scene that this GameObject belongs to
@@ -131,14 +147,9 @@ namespace Gameplay {
 		/// <typeparam name="T">The type of component to search for</typeparam>
 		template <typename T, typename = typename std::enable_if<std::is_base_of<IComponent, T>::value>::type>
 		bool Has() {
-			// Iterate over all the pointers in the components list
-			for (const auto& ptr : _components) {
-				// If the pointer type matches T, we return true
-				if (std::type_index(typeid(*ptr.get())) == std::type_index(typeid(T))) {
-					return true;
-				}
-			}
-			return false;
+			// Each component type has a bit in our mask, so this is just a bit test
+			IComponent::TypeId type = ComponentManager::GetTypeId<T>();
+			return type < MaxComponentTypes && _componentMask[type];
 		}
 
 		/// <summary>
@@ -147,14 +158,10 @@ namespace Gameplay {
 		/// <typeparam name="T">The type of component to search for</typeparam>
 		template <typename T, typename = typename std::enable_if<std::is_base_of<IComponent, T>::value>::type>
 		std::shared_ptr<T> Get() {
-			// Iterate over all the pointers in the binding list
-			for (const auto& ptr : _components) {
-				// If the pointer type matches T, we return that behaviour, making sure to cast it back to the requested type
-				if (std::type_index(typeid(*ptr.get())) == std::type_index(typeid(T))) {
-					return std::dynamic_pointer_cast<T>(ptr);
-				}
-			}
-			return nullptr;
+			// Components are stored in the slot for their type, so we know the concrete type
+			// matches T and can skip the dynamic cast
+			IComponent::TypeId type = ComponentManager::GetTypeId<T>();
+			return type < MaxComponentTypes ? std::static_pointer_cast<T>(_componentSlots[type]) : nullptr;
 		}
 
 		/// <summary>
@@ -174,7 +181,7 @@ namespace Gameplay {
 			component->_context = this;
 
 			// Append it to the binding component's storage, and invoke the OnLoad
-			_components.push_back(component);
+			_AttachComponent(component);
 			component->OnLoad();
 
 			if (_scene->GetIsAwake()) {
@@ -201,19 +208,18 @@ namespace Gameplay {
 	private:
 		friend class Scene;
 
-		// Rotation of the object as a quaternion
-		glm::quat _rotation;
-		// Position of the object
-		glm::vec3 _position;
-		// The scale of the object
-		glm::vec3 _scale;
-
-		// The object's world transform
-		mutable glm::mat4 _transform;
-		mutable bool _isTransformDirty;
+		// The scene's transform store, which holds our position, rotation, scale and
+		// world transform. We hold a reference so it outlives us even if the scene doesn't
+		TransformStore::Sptr  _transforms;
+		// The index of our transform in the store
+		TransformStore::Index _transformIndex;
 
 		// The components that this game object has attached to it
 		std::vector<IComponent::Sptr> _components;
+		// The same components, stored in the slot for their type ID for quick lookups,
+		// and a mask of which slots are filled
+		std::array<IComponent::Sptr, MaxComponentTypes> _componentSlots;
+		std::bitset<MaxComponentTypes> _componentMask;
 
 		// Pointer to the scene, we use raw pointers since 
 		// this will always be set by the scene on creation
@@ -223,6 +229,18 @@ namespace Gameplay {
 		/// <summary>
 		/// Only scenes will be allowed to create gameobjects
 		/// </summary>
-		GameObject();
+		/// <param name="scene">The scene that the object belongs to</param>
+		GameObject(Scene* scene);
+
+		/// <summary>
+		/// Adds a component to our component list and to the slot for it's type
+		/// </summary>
+		/// <param name="component">The component to attach, should already be in the component pools</param>
+		void _AttachComponent(const IComponent::Sptr& component);
+		/// <summary>
+		/// Attaches a component that has just been loaded from a scene file, and lets it initialize
+		/// </summary>
+		/// <param name="component">The component to attach, as returned by ComponentManager::Load</param>
+		void _AttachLoadedComponent(const IComponent::Sptr& component);
 	};
 }
\ No newline at end of file
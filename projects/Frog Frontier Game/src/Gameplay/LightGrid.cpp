@@ -0,0 +1,94 @@
+#include "Gameplay/LightGrid.h"
+
+#include <cstring>
+#include <cfloat>
+
+namespace Gameplay {
+	// We treat a light as out of range once it's attenuation drops below this, which is
+	// less than one step of an 8 bit color channel
+	static constexpr float LIGHT_CUTOFF = 1.0f / 256.0f;
+
+	// Our shaders use 1 / (1 + a * d^2) for attenuation, so solve for the distance where
+	// that reaches the cutoff
+	static inline float LightRadius(const LightUniform& light) {
+		return sqrtf((1.0f / LIGHT_CUTOFF - 1.0f) / glm::max(light.Attenuation, 1e-6f));
+	}
+
+	static_assert(sizeof(LightClusterHeader) % sizeof(uint32_t) == 0, "Light cluster header must be a whole number of words");
+
+	LightGrid::LightGrid() :
+		_buffer(ShaderStorageBuffer::Create()),
+		_header(LightClusterHeader()),
+		_indices(std::vector<uint32_t>()),
+		_uploadData(std::vector<uint32_t>()),
+		_lightRanges(std::vector<glm::ivec2>())
+	{ }
+
+	void LightGrid::Build(const LightUniforms& lights) {
+		const int numLights = lights.NumLights;
+
+		// A light affects the slice [x - r, x + r] along X, find the range covered by all of them
+		float minX = FLT_MAX;
+		float maxX = -FLT_MAX;
+		for (int ix = 0; ix < numLights; ix++) {
+			const LightUniform& light = lights.Lights[ix];
+			float radius = LightRadius(light);
+			minX = glm::min(minX, light.Position.x - radius);
+			maxX = glm::max(maxX, light.Position.x + radius);
+		}
+		if (numLights == 0 || maxX <= minX) {
+			minX = 0.0f;
+			maxX = 1.0f;
+		}
+
+		_header.MinX = minX;
+		_header.InvClusterSize = LIGHT_CLUSTER_COUNT / (maxX - minX);
+		_header.ClusterCount = LIGHT_CLUSTER_COUNT;
+		for (glm::uvec2& cluster : _header.Clusters) {
+			cluster = glm::uvec2(0);
+		}
+
+		// First pass works out which clusters each light touches, and counts the lights
+		// in each cluster
+		_lightRanges.resize(numLights);
+		for (int ix = 0; ix < numLights; ix++) {
+			const LightUniform& light = lights.Lights[ix];
+			float radius = LightRadius(light);
+			int first = (int)floorf((light.Position.x - radius - minX) * _header.InvClusterSize);
+			int last  = (int)floorf((light.Position.x + radius - minX) * _header.InvClusterSize);
+			_lightRanges[ix] = glm::ivec2(
+				glm::clamp(first, 0, LIGHT_CLUSTER_COUNT - 1),
+				glm::clamp(last, 0, LIGHT_CLUSTER_COUNT - 1)
+			);
+			for (int cluster = _lightRanges[ix].x; cluster <= _lightRanges[ix].y; cluster++) {
+				_header.Clusters[cluster].y++;
+			}
+		}
+
+		// Turn the counts into offsets into the index list
+		uint32_t total = 0;
+		for (glm::uvec2& cluster : _header.Clusters) {
+			cluster.x = total;
+			total += cluster.y;
+			cluster.y = 0;
+		}
+
+		// Second pass fills in the indices, lights stay in order within each cluster
+		_indices.resize(total);
+		for (int ix = 0; ix < numLights; ix++) {
+			for (int cluster = _lightRanges[ix].x; cluster <= _lightRanges[ix].y; cluster++) {
+				glm::uvec2& range = _header.Clusters[cluster];
+				_indices[range.x + range.y++] = (uint32_t)ix;
+			}
+		}
+
+		// Pack it all into one block and send it off
+		const size_t headerWords = sizeof(LightClusterHeader) / sizeof(uint32_t);
+		_uploadData.resize(headerWords + _indices.size());
+		memcpy(_uploadData.data(), &_header, sizeof(LightClusterHeader));
+		if (!_indices.empty()) {
+			memcpy(_uploadData.data() + headerWords, _indices.data(), _indices.size() * sizeof(uint32_t));
+		}
+		_buffer->Update(_uploadData.data(), _uploadData.size() * sizeof(uint32_t));
+	}
+}
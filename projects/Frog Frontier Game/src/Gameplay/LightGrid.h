@@ -0,0 +1,59 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "Gameplay/UniformBlocks.h"
+#include "Graphics/ShaderStorageBuffer.h"
+
+namespace Gameplay {
+	/// <summary>
+	/// Assigns lights to clusters so that fragments only need to evaluate the lights that
+	/// can actually reach them. Our levels scroll along the X axis, so rather than a full
+	/// 3D froxel grid the world is split into equal slices along X that cover the range of
+	/// all the lights in the scene
+	///
+	/// The cluster ranges and the packed light index lists are uploaded to a shader storage
+	/// buffer, see b_LightClusters in frag_blinn_phong_textured.glsl
+	/// </summary>
+	class LightGrid {
+	public:
+		typedef std::shared_ptr<LightGrid> Sptr;
+
+		LightGrid();
+		~LightGrid() = default;
+
+		LightGrid(const LightGrid& other) = delete;
+		LightGrid(LightGrid&& other) = delete;
+		LightGrid& operator=(const LightGrid& other) = delete;
+		LightGrid& operator=(LightGrid&& other) = delete;
+
+		/// <summary>
+		/// Re-assigns all the lights to clusters and uploads the result, should be called
+		/// whenever the lights change
+		/// </summary>
+		/// <param name="lights">The light data that was uploaded to the light block</param>
+		void Build(const LightUniforms& lights);
+
+		/// <summary>
+		/// Binds the cluster data to the given shader storage binding slot
+		/// </summary>
+		void Bind(int slot) const { _buffer->Bind(slot); }
+
+		/// <summary>
+		/// Gets the total number of light references across all clusters, useful for
+		/// seeing how much work the culling is saving
+		/// </summary>
+		size_t GetLightReferenceCount() const { return _indices.size(); }
+
+	protected:
+		ShaderStorageBuffer::Sptr _buffer;
+		LightClusterHeader        _header;
+		// The light indices for each cluster, packed back to back
+		std::vector<uint32_t>     _indices;
+		// Header and indices packed together for upload
+		std::vector<uint32_t>     _uploadData;
+		// The first and last cluster touched by each light
+		std::vector<glm::ivec2>   _lightRanges;
+	};
+}
@@ -3,11 +3,17 @@
 
 namespace Gameplay {
 	void Material::Apply() {
+		Apply(MatShader);
+	}
+
+	void Material::Apply(const Shader::Sptr& shader) {
 		// Material properties
-		MatShader->SetUniform("u_Material.Shininess", Shininess);
+		shader->SetUniform("u_Material.Shininess", Shininess);
+		// Blended materials keep all their texels, opaque ones are alpha tested
+		shader->SetUniform("u_Material.AlphaCutoff", Transparent ? 0.0f : 0.5f);
 
 		// For textures, we pass the *slot* that the texture sure draw from
-		MatShader->SetUniform("u_Material.Diffuse", 0);
+		shader->SetUniform("u_Material.Diffuse", 0);
 
 		// Bind the texture
 		if (Texture != nullptr) {
@@ -15,6 +21,10 @@ namespace Gameplay {
 		}
 	}
 
+	bool Material::IsTransparent() const {
+		return Transparent;
+	}
+
 	Material::Sptr Material::FromJson(const nlohmann::json& data) {
 		Material::Sptr result = std::make_shared<Material>();
 		result->OverrideGUID(Guid(data["guid"]));
@@ -24,6 +34,7 @@ namespace Gameplay {
 		// material specific parameters
 		result->Texture = ResourceManager::Get<Texture2D>(Guid(data["texture"]));
 		result->Shininess = data["shininess"].get<float>();
+		result->Transparent = data.contains("transparent") && data["transparent"].get<bool>();
 		return result;
 	}
 
@@ -35,6 +46,7 @@ namespace Gameplay {
 
 			{ "texture", Texture ? Texture->IResource::GetGUID().str() : "null" },
 			{ "shininess", Shininess },
+			{ "transparent", Transparent },
 		};
 	}
 }
\ No newline at end of file
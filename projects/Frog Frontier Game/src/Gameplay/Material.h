@@ -11,6 +11,7 @@ namespace Gameplay {
 	struct Material : public IResource {
 	public:
 		typedef std::shared_ptr<Material> Sptr;
+		MAKE_STATIC_TYPENAME(Gameplay::Material)
 		/// <summary>
 		/// A human readable name for the material
 		/// </summary>
@@ -28,12 +29,29 @@ namespace Gameplay {
 		/// How reflective the material is, controls specular power
 		/// </summary>
 		float           Shininess;
+		/// <summary>
+		/// True if objects using this material should be blended, these are drawn back to front
+		/// after all opaque objects. Opaque materials discard texels that are mostly transparent,
+		/// so cutouts like text and UV atlas padding don't need blending
+		/// </summary>
+		bool            Transparent = false;
 
 		/// <summary>
 		/// Handles applying this material's state to the OpenGL pipeline
 		/// Will bind the shader, update material uniforms, and bind textures
 		/// </summary>
 		virtual void Apply();
+		/// <summary>
+		/// Applies this material's state to the given shader instead of MatShader, for when
+		/// we're drawing with a variant of the material's shader (ex: for instancing)
+		/// </summary>
+		/// <param name="shader">The shader to apply the material parameters to</param>
+		virtual void Apply(const Shader::Sptr& shader);
+
+		/// <summary>
+		/// Returns true if objects using this material need to be blended
+		/// </summary>
+		bool IsTransparent() const;
 
 		/// <summary>
 		/// Loads a material from a JSON blob
@@ -2,8 +2,49 @@
 #include <filesystem>
 
 #include "Utils/ObjLoader.h"
+#include "Utils/OptimizedObjLoader.h"
+#include "Utils/MeshCache.h"
+
+// Use the memory mapped OBJ loader, comment out to fall back to the streaming loader
+#define OPTIMIZED_OBJ_LOADER
+// Store loaded meshes in a binary cache next to the source, so we only parse them once
+#define USE_MESH_CACHE
 
 namespace Gameplay {
+	// Loads a mesh from a file, using the mesh cache if there's an up to date version
+	static VertexArrayObject::Sptr LoadMeshFile(const std::string& filename) {
+		VertexArrayObject::Sptr result = nullptr;
+
+		#ifdef USE_MESH_CACHE
+		result = MeshCache::Load(filename);
+		if (result != nullptr) {
+			return result;
+		}
+		#endif
+
+		// Parse into a builder rather than straight to a VAO, so we can cache the CPU side copy
+		MeshBuilder<VertexPosNormTexCol> mesh;
+		#ifdef OPTIMIZED_OBJ_LOADER
+		if (!OptimizedObjLoader::ParseFile(filename, mesh)) {
+			return nullptr;
+		}
+		#else
+		std::vector<glm::vec3> positions, normals;
+		std::vector<glm::vec2> uvs;
+		std::vector<glm::ivec3> vertices;
+		if (!ObjLoader::ParseAttributes(filename, positions, uvs, normals, vertices)) {
+			return nullptr;
+		}
+		ObjLoader::BuildMesh(positions, uvs, normals, vertices, mesh);
+		#endif
+		result = mesh.Bake();
+
+		#ifdef USE_MESH_CACHE
+		MeshCache::Save(filename, mesh);
+		#endif
+		return result;
+	}
+
 	MeshResource::MeshResource() :
 		IResource(),
 		Filename(""),
@@ -19,7 +60,7 @@ namespace Gameplay {
 		Mesh(nullptr),
 		BulletTriMesh(nullptr)
 	{
-		Mesh = ObjLoader::LoadFromFile(filename);
+		Mesh = LoadMeshFile(filename);
 	}
 
 	MeshResource::~MeshResource() = default;
@@ -54,17 +95,51 @@ namespace Gameplay {
 		} else {
 			result->Filename = JsonGet<std::string>(blob, "filename", "null");
 			if (result->Filename != "null" && std::filesystem::exists(result->Filename)) {
-				#ifdef OPTIMIZED_OBJ_LOADER
-				result->Mesh = OptimizedObjLoader::LoadFromFile(result->Filename);
-				#else
-				result->Mesh = ObjLoader::LoadFromFile(result->Filename);
-				#endif
-
+				result->Mesh = LoadMeshFile(result->Filename);
 			}
 		}
 		return result;
 	}
 
+	ResourceFinalizer MeshResource::PrepareFromJson(const nlohmann::json& blob)
+	{
+		// Generated meshes are cheap to build, so we just do them on the main thread
+		std::string filename = JsonGet<std::string>(blob, "filename", "null");
+		if (blob.contains("params") || filename == "null" || !std::filesystem::exists(filename)) {
+			return [blob]() { return FromJson(blob); };
+		}
+
+		#ifdef USE_MESH_CACHE
+		MeshCache::CachedMesh::Sptr cached = MeshCache::Read(filename);
+		if (cached != nullptr) {
+			return [filename, cached]() {
+				MeshResource::Sptr result = std::make_shared<MeshResource>();
+				result->Filename = filename;
+				result->Mesh = MeshCache::Upload(*cached);
+				return result;
+			};
+		}
+		#endif
+
+		#ifdef OPTIMIZED_OBJ_LOADER
+		std::shared_ptr<MeshBuilder<VertexPosNormTexCol>> mesh = std::make_shared<MeshBuilder<VertexPosNormTexCol>>();
+		if (OptimizedObjLoader::ParseFile(filename, *mesh)) {
+			// Writing the cache doesn't need OpenGL, so we can do it here on the worker
+			#ifdef USE_MESH_CACHE
+			MeshCache::Save(filename, *mesh);
+			#endif
+			return [filename, mesh]() {
+				MeshResource::Sptr result = std::make_shared<MeshResource>();
+				result->Filename = filename;
+				result->Mesh = mesh->Bake();
+				return result;
+			};
+		}
+		#endif
+
+		return [blob]() { return FromJson(blob); };
+	}
+
 	void MeshResource::GenerateMesh() {
 		MeshBuilder<VertexPosNormTexCol> mesh;
 		for (auto& param : MeshBuilderParams) {
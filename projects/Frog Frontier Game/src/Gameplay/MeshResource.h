@@ -15,6 +15,7 @@ namespace Gameplay {
 	class MeshResource : public IResource {
 	public:
 		typedef std::shared_ptr<MeshResource> Sptr;
+		MAKE_STATIC_TYPENAME(Gameplay::MeshResource)
 
 		// Default constructor
 		MeshResource();
@@ -65,5 +66,10 @@ namespace Gameplay {
 
 		virtual nlohmann::json ToJson() const override;
 		static MeshResource::Sptr FromJson(const nlohmann::json& blob);
+		/// <summary>
+		/// Reads or parses the mesh file on the calling thread, and returns a function
+		/// to upload it to the GPU on the main thread
+		/// </summary>
+		static ResourceFinalizer PrepareFromJson(const nlohmann::json& blob);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "Gameplay/Physics/CollisionWorld2D.h"
+#include <algorithm>
+#include <cmath>
+
+// rectOverlap rounds the edges of the rects to floats, so we look a little further than we
+// need to, to make sure we never skip a rect that it would report a hit for
+static constexpr double QUERY_MARGIN = 0.01;
+
+CollisionWorld2D::CollisionWorld2D() :
+	_static(std::vector<Entry>()),
+	_dynamic(std::vector<Entry>()),
+	_maxStaticWidth(0.0f),
+	_nextOrder(0),
+	_isSorted(true),
+	_candidates(std::vector<Entry*>())
+{ }
+
+void CollisionWorld2D::AddStatic(const CollisionRect& rect) {
+	_static.push_back({ rect, _nextOrder++ });
+	_maxStaticWidth = std::max(_maxStaticWidth, rect.width);
+	_isSorted = false;
+}
+
+size_t CollisionWorld2D::AddDynamic(const CollisionRect& rect) {
+	_dynamic.push_back({ rect, _nextOrder++ });
+	return _dynamic.size() - 1;
+}
+
+void CollisionWorld2D::Clear() {
+	_static.clear();
+	_dynamic.clear();
+	_maxStaticWidth = 0.0f;
+	_nextOrder = 0;
+	_isSorted = true;
+}
+
+void CollisionWorld2D::Query(const CollisionRect& body, std::vector<CollisionRect*>& results) {
+	results.clear();
+	_candidates.clear();
+
+	// Levels are built all at once, so we only end up sorting once after they've loaded
+	if (!_isSorted) {
+		std::stable_sort(_static.begin(), _static.end(), [](const Entry& a, const Entry& b) {
+			return a.Rect.x < b.Rect.x;
+		});
+		_isSorted = true;
+	}
+
+	// Any static rect that overlaps the body has to start within the widest rect's width of it
+	double minX = body.x - _maxStaticWidth - QUERY_MARGIN;
+	double maxX = body.x + _maxStaticWidth + QUERY_MARGIN;
+	auto it = std::lower_bound(_static.begin(), _static.end(), minX, [](const Entry& entry, double x) {
+		return entry.Rect.x < x;
+	});
+	for (; it != _static.end() && it->Rect.x <= maxX; it++) {
+		if (_OverlapsX(body, it->Rect)) {
+			_candidates.push_back(&*it);
+		}
+	}
+
+	// There's only ever a handful of moving bodies, so we just check all of them
+	for (Entry& entry : _dynamic) {
+		if (_OverlapsX(body, entry.Rect)) {
+			_candidates.push_back(&entry);
+		}
+	}
+
+	// Hand the rects back in the order they were added, since rectOverlap remembers the last rect it hit
+	std::sort(_candidates.begin(), _candidates.end(), [](const Entry* a, const Entry* b) {
+		return a->Order < b->Order;
+	});
+	results.reserve(_candidates.size());
+	for (Entry* entry : _candidates) {
+		results.push_back(&entry->Rect);
+	}
+}
+
+bool CollisionWorld2D::_OverlapsX(const CollisionRect& body, const CollisionRect& rect) {
+	// rectOverlap uses the second rect's width for both rects
+	return std::abs(body.x - rect.x) <= rect.width + QUERY_MARGIN;
+}
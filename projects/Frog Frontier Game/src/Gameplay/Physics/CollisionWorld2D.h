@@ -0,0 +1,82 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "Gameplay/Physics/CollisionRect.h"
+
+/// <summary>
+/// Broadphase for the CollisionRects in a level, so that we only run the full overlap test
+/// against rects that are close to the body we're checking
+///
+/// Static rects are kept sorted by X, and a query binary searches for the range of X that
+/// could overlap, so a query only touches the rects near the body instead of every rect in
+/// every level. Bodies that move (the player, moving obstacles) are kept in a separate short
+/// list that is checked every query, and can be updated in place without re-sorting
+///
+/// Queries return rects in the order they were added, so that CollisionRect::rectOverlap sees
+/// them in the same order as it would walking the whole list
+/// </summary>
+class CollisionWorld2D {
+public:
+	CollisionWorld2D();
+	~CollisionWorld2D() = default;
+
+	/// <summary>
+	/// Adds a rect that will never move, the list is re-sorted on the next query
+	/// </summary>
+	void AddStatic(const CollisionRect& rect);
+	/// <summary>
+	/// Adds a rect that can be moved with GetDynamic
+	/// </summary>
+	/// <returns>The index of the body, for use with GetDynamic</returns>
+	size_t AddDynamic(const CollisionRect& rect);
+
+	/// <summary>
+	/// Gets one of the moving bodies, it can be updated freely
+	/// </summary>
+	CollisionRect& GetDynamic(size_t index) { return _dynamic[index].Rect; }
+	/// <summary>
+	/// Gets the number of moving bodies in the world
+	/// </summary>
+	size_t GetDynamicCount() const { return _dynamic.size(); }
+	/// <summary>
+	/// Gets the total number of rects in the world
+	/// </summary>
+	size_t GetCount() const { return _static.size() + _dynamic.size(); }
+
+	/// <summary>
+	/// Removes all rects from the world
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// Finds all the rects that overlap the given body along X, this is a superset of the
+	/// rects that CollisionRect::rectOverlap would report a hit for
+	/// </summary>
+	/// <param name="body">The body to find the neighbours of</param>
+	/// <param name="results">Filled with the rects near the body, in the order they were added. Pointers are valid until the next rect is added</param>
+	void Query(const CollisionRect& body, std::vector<CollisionRect*>& results);
+
+protected:
+	struct Entry {
+		CollisionRect Rect;
+		// The order the rect was added in, so queries can return rects in that order
+		uint32_t      Order;
+	};
+
+	// Sorted by X when _isSorted is true
+	std::vector<Entry> _static;
+	std::vector<Entry> _dynamic;
+	// The widest static rect, a query needs to look this far to either side of the body
+	float              _maxStaticWidth;
+	uint32_t           _nextOrder;
+	bool               _isSorted;
+
+	// Re-used between queries, so we don't allocate every frame
+	std::vector<Entry*> _candidates;
+
+	/// <summary>
+	/// Returns true if the rect would pass the X part of CollisionRect::rectOverlap with body
+	/// </summary>
+	static bool _OverlapsX(const CollisionRect& body, const CollisionRect& rect);
+};
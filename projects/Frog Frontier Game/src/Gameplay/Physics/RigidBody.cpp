@@ -205,6 +205,26 @@ namespace Gameplay::Physics {
 		_RenderImGuiBase();
 	}
 
+	void RigidBody::WriteSnapshot(SceneSnapshot& snapshot) const {
+		snapshot.Write(_body != nullptr ? ToGlm(_body->getLinearVelocity()) : glm::vec3(0.0f));
+		snapshot.Write(_body != nullptr ? ToGlm(_body->getAngularVelocity()) : glm::vec3(0.0f));
+	}
+
+	void RigidBody::ReadSnapshot(SceneSnapshot& snapshot) {
+		glm::vec3 linearVelocity, angularVelocity;
+		snapshot.Read(linearVelocity);
+		snapshot.Read(angularVelocity);
+
+		// The body's transform is copied from the game object in the next pre-step, so we
+		// only need to reset it's motion
+		if (_body != nullptr) {
+			_body->setLinearVelocity(ToBt(linearVelocity));
+			_body->setAngularVelocity(ToBt(angularVelocity));
+			_body->clearForces();
+			_body->activate();
+		}
+	}
+
 	nlohmann::json RigidBody::ToJson() const {
 		nlohmann::json result;
 		// Write out RigidBody data
@@ -133,9 +133,11 @@ namespace Gameplay::Physics {
 		// Inherited from IComponent
 		virtual void Awake() override;
 		virtual void RenderImGui() override;
+		virtual void WriteSnapshot(SceneSnapshot& snapshot) const override;
+		virtual void ReadSnapshot(SceneSnapshot& snapshot) override;
 		virtual nlohmann::json ToJson() const override;
 		static RigidBody::Sptr FromJson(const nlohmann::json& data);
-		MAKE_TYPENAME(RigidBody)
+		MAKE_TYPENAME(Gameplay::Physics::RigidBody)
 
 
 	protected:
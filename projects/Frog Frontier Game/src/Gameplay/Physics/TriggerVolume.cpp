@@ -6,6 +6,7 @@
 
 #include "Gameplay/GameObject.h"
 #include "Gameplay/Scene.h"
+#include "Gameplay/SceneSnapshot.h"
 
 
 namespace Gameplay::Physics {
@@ -175,6 +176,37 @@ namespace Gameplay::Physics {
 		_RenderImGuiBase();
 	}
 
+	void TriggerVolume::WriteSnapshot(SceneSnapshot& snapshot) const {
+		// We store the bodies inside the volume by their object's GUID, so that enter and leave
+		// events fire the same way after the snapshot is restored
+		uint32_t count = 0;
+		for (const auto& weakPtr : _currentCollisions) {
+			count += weakPtr.expired() ? 0 : 1;
+		}
+		snapshot.Write(count);
+		for (const auto& weakPtr : _currentCollisions) {
+			RigidBody::Sptr body = weakPtr.lock();
+			if (body != nullptr) {
+				snapshot.Write(body->GetGameObject()->GUID);
+			}
+		}
+	}
+
+	void TriggerVolume::ReadSnapshot(SceneSnapshot& snapshot) {
+		uint32_t count;
+		snapshot.Read(count);
+		_currentCollisions.clear();
+		for (uint32_t ix = 0; ix < count; ix++) {
+			Guid id;
+			snapshot.Read(id);
+			GameObject::Sptr object = GetGameObject()->GetScene()->FindObjectByGUID(id);
+			RigidBody::Sptr body = object != nullptr ? object->Get<RigidBody>() : nullptr;
+			if (body != nullptr) {
+				_currentCollisions.push_back(body);
+			}
+		}
+	}
+
 	nlohmann::json TriggerVolume::ToJson() const {
 		nlohmann::json result;
 		ToJsonBase(result);
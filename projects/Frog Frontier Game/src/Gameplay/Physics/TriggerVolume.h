@@ -35,9 +35,11 @@ namespace Gameplay::Physics {
 
 		virtual void Awake() override;
 		virtual void RenderImGui() override;
+		virtual void WriteSnapshot(SceneSnapshot& snapshot) const override;
+		virtual void ReadSnapshot(SceneSnapshot& snapshot) override;
 		virtual nlohmann::json ToJson() const override;
 		static TriggerVolume::Sptr FromJson(const nlohmann::json& data);
-		MAKE_TYPENAME(TriggerVolume);
+		MAKE_TYPENAME(Gameplay::Physics::TriggerVolume);
 
 	protected:
 		btPairCachingGhostObject*   _ghost;
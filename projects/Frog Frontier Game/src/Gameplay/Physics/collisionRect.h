@@ -1,3 +1,4 @@
+#pragma once
 // GLM math library
 #include <GLM/glm.hpp>
 #include <GLM/gtc/matrix_transform.hpp>
@@ -0,0 +1,142 @@
+#include "Gameplay/RenderQueue.h"
+
+#include <cstring>
+
+#define GLM_ENABLE_EXPERIMENTAL
+#include "GLM/gtx/norm.hpp"
+
+#include "Gameplay/GameObject.h"
+
+namespace Gameplay {
+	// Number of bits for each section of the sort key
+	static constexpr uint64_t SHADER_BITS   = 10;
+	static constexpr uint64_t MATERIAL_BITS = 14;
+	static constexpr uint64_t MESH_BITS     = 15;
+	static constexpr uint64_t DEPTH_BITS    = 24;
+
+	static constexpr uint64_t SHADER_MASK   = (1ull << SHADER_BITS) - 1;
+	static constexpr uint64_t MATERIAL_MASK = (1ull << MATERIAL_BITS) - 1;
+	static constexpr uint64_t MESH_MASK     = (1ull << MESH_BITS) - 1;
+	static constexpr uint64_t DEPTH_MASK    = (1ull << DEPTH_BITS) - 1;
+
+	// The top bit of the key selects the pass, so all opaque draws come first
+	static constexpr uint64_t TRANSPARENT_BIT = 1ull << 63;
+
+	RenderQueue::RenderQueue() :
+		_drawCalls(std::vector<DrawCall>()),
+		_sortBuffer(std::vector<DrawCall>()),
+		_batches(std::vector<Batch>()),
+		_shaderIds(std::unordered_map<const void*, uint32_t>()),
+		_materialIds(std::unordered_map<const void*, uint32_t>()),
+		_meshIds(std::unordered_map<const void*, uint32_t>())
+	{ }
+
+	void RenderQueue::Clear() {
+		_drawCalls.clear();
+		_batches.clear();
+		_shaderIds.clear();
+		_materialIds.clear();
+		_meshIds.clear();
+	}
+
+	void RenderQueue::Submit(RenderComponent* renderer, const glm::vec3& cameraPos) {
+		const Material::Sptr& material = renderer->GetMaterial();
+		const VertexArrayObject::Sptr& mesh = renderer->GetMesh();
+		if (material == nullptr || mesh == nullptr) {
+			return;
+		}
+
+		// Positive floats keep their ordering when compared as integers, so the top bits of
+		// the squared distance make for a cheap fixed point depth
+		float distance = glm::length2(renderer->GetGameObject()->GetPosition() - cameraPos);
+		uint32_t distanceBits;
+		memcpy(&distanceBits, &distance, sizeof(float));
+		uint64_t depth = (distanceBits >> (32 - DEPTH_BITS)) & DEPTH_MASK;
+
+		uint64_t shaderId   = _GetId(_shaderIds, material->MatShader.get(), SHADER_MASK);
+		uint64_t materialId = _GetId(_materialIds, material.get(), MATERIAL_MASK);
+		uint64_t meshId     = _GetId(_meshIds, mesh.get(), MESH_MASK);
+
+		uint64_t key;
+		if (material->IsTransparent()) {
+			// Transparent objects are sorted back to front first, then by state
+			key = TRANSPARENT_BIT |
+				((DEPTH_MASK - depth) << (SHADER_BITS + MATERIAL_BITS + MESH_BITS)) |
+				(shaderId << (MATERIAL_BITS + MESH_BITS)) |
+				(materialId << MESH_BITS) |
+				meshId;
+		} else {
+			// Opaque objects are grouped by state, and drawn front to back within a group
+			key =
+				(shaderId << (MATERIAL_BITS + MESH_BITS + DEPTH_BITS)) |
+				(materialId << (MESH_BITS + DEPTH_BITS)) |
+				(meshId << DEPTH_BITS) |
+				depth;
+		}
+
+		_drawCalls.push_back({ key, renderer });
+	}
+
+	void RenderQueue::Sort() {
+		const size_t count = _drawCalls.size();
+		_sortBuffer.resize(count);
+
+		// LSD radix sort, one byte of the key at a time. Passes where every key has the same
+		// byte are skipped, which is common for the high bits of the key
+		DrawCall* source = _drawCalls.data();
+		DrawCall* dest = _sortBuffer.data();
+		for (uint32_t shift = 0; shift < 64; shift += 8) {
+			size_t offsets[256] = { 0 };
+			for (size_t ix = 0; ix < count; ix++) {
+				offsets[(source[ix].SortKey >> shift) & 0xFF]++;
+			}
+			if (count == 0 || offsets[(source[0].SortKey >> shift) & 0xFF] == count) {
+				continue;
+			}
+
+			// Convert our counts into starting offsets for each bucket
+			size_t total = 0;
+			for (size_t& offset : offsets) {
+				size_t bucketSize = offset;
+				offset = total;
+				total += bucketSize;
+			}
+
+			for (size_t ix = 0; ix < count; ix++) {
+				dest[offsets[(source[ix].SortKey >> shift) & 0xFF]++] = source[ix];
+			}
+			std::swap(source, dest);
+		}
+
+		// If we ended on the scratch buffer, swap it into place
+		if (source != _drawCalls.data()) {
+			_drawCalls.swap(_sortBuffer);
+		}
+
+		// Group runs of opaque draws with the same mesh and material, since these are adjacent
+		// in the sorted list we only need to compare against the start of the current batch.
+		// Transparent draws are always drawn one at a time, in back to front order
+		_batches.clear();
+		for (size_t ix = 0; ix < count; ix++) {
+			if (!_batches.empty() && (_drawCalls[ix].SortKey & TRANSPARENT_BIT) == 0) {
+				RenderComponent* first = _drawCalls[_batches.back().First].Renderer;
+				RenderComponent* current = _drawCalls[ix].Renderer;
+				if (first->GetMaterial() == current->GetMaterial() && first->GetMesh() == current->GetMesh()) {
+					_batches.back().Count++;
+					continue;
+				}
+			}
+			_batches.push_back({ ix, 1 });
+		}
+	}
+
+	uint64_t RenderQueue::_GetId(std::unordered_map<const void*, uint32_t>& ids, const void* resource, uint64_t mask) {
+		auto it = ids.find(resource);
+		if (it == ids.end()) {
+			it = ids.emplace(resource, static_cast<uint32_t>(ids.size())).first;
+		}
+		// If we ever have more unique resources than fit in the key we wrap around, this
+		// only costs us some state changes, the draws are still correct
+		return it->second & mask;
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+#include "Gameplay/Components/RenderComponent.h"
+
+namespace Gameplay {
+	/// <summary>
+	/// Collects all the objects that need to be drawn in a frame, and sorts them so that
+	/// we change shader and material state as little as possible
+	///
+	/// Each draw gets a 64 bit sort key, with the pass in the highest bit so opaque
+	/// objects are drawn before transparent ones. Opaque draws are then grouped by shader,
+	/// material and mesh and drawn front to back within a group, while transparent draws are
+	/// sorted back to front so that blending works regardless of the order objects were
+	/// created in
+	///
+	/// After sorting, runs of opaque draws that share a mesh and material are grouped into
+	/// batches, which can be drawn with a single instanced draw call. Each transparent draw is
+	/// a batch of it's own
+	/// </summary>
+	class RenderQueue {
+	public:
+		/// <summary>
+		/// A single draw in the queue
+		/// </summary>
+		struct DrawCall {
+			uint64_t         SortKey;
+			RenderComponent* Renderer;
+		};
+
+		/// <summary>
+		/// A run of consecutive opaque draws in the sorted queue that share a mesh and material
+		/// </summary>
+		struct Batch {
+			size_t First;
+			size_t Count;
+		};
+
+		RenderQueue();
+		~RenderQueue() = default;
+
+		/// <summary>
+		/// Removes all the draws from the queue, should be called at the start of each frame
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Adds a render component to the queue. Components without a mesh or material
+		/// are skipped
+		/// </summary>
+		/// <param name="renderer">The render component to draw</param>
+		/// <param name="cameraPos">The position of the camera in world space, used for depth sorting</param>
+		void Submit(RenderComponent* renderer, const glm::vec3& cameraPos);
+
+		/// <summary>
+		/// Sorts all submitted draws by their sort key, and groups them into batches
+		/// </summary>
+		void Sort();
+
+		/// <summary>
+		/// Gets the draws in the queue, this will be in sorted order after Sort has been called
+		/// </summary>
+		const std::vector<DrawCall>& GetDrawCalls() const { return _drawCalls; }
+		/// <summary>
+		/// Gets the batches of draws that share state, only valid after Sort has been called
+		/// </summary>
+		const std::vector<Batch>& GetBatches() const { return _batches; }
+
+	protected:
+		std::vector<DrawCall> _drawCalls;
+		// Scratch space for the radix sort, kept around so we don't re-allocate every frame
+		std::vector<DrawCall> _sortBuffer;
+		std::vector<Batch>    _batches;
+
+		// Map shaders, materials and meshes to small IDs for packing into sort keys. Each has
+		// it's own map so IDs are dense within their section of the key. These are re-assigned
+		// each frame, so we don't hang on to pointers for deleted resources
+		std::unordered_map<const void*, uint32_t> _shaderIds;
+		std::unordered_map<const void*, uint32_t> _materialIds;
+		std::unordered_map<const void*, uint32_t> _meshIds;
+
+		/// <summary>
+		/// Gets the sort ID for a resource, masked to fit in it's section of the sort key
+		/// </summary>
+		/// <param name="ids">The IDs that have been handed out for this section of the key</param>
+		/// <param name="resource">The resource to get the ID for</param>
+		/// <param name="mask">The mask for this section of the key</param>
+		static uint64_t _GetId(std::unordered_map<const void*, uint32_t>& ids, const void* resource, uint64_t mask);
+	};
+}
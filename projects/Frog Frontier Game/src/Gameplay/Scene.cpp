@@ -2,30 +2,431 @@
 
 #include <GLFW/glfw3.h>
 
+#include <fstream>
+#include <cstring>
+#include <unordered_set>
+
 #include "Utils/FileHelpers.h"
 #include "Utils/GlmBulletConversions.h"
+#include "Utils/JsonGlmHelpers.h"
+#include "Utils/MappedFile.h"
 
 #include "Gameplay/Physics/RigidBody.h"
 #include "Gameplay/Physics/TriggerVolume.h"
+#include "LinearMath/btPoolAllocator.h"
 
 #include "Graphics/DebugDraw.h"
 
 namespace Gameplay {
+	// Bump this whenever the layout of binary scene files changes
+	static constexpr uint32_t SCENE_FILE_VERSION = 1;
+	static constexpr char     SCENE_FILE_MAGIC[4] = { 'F', 'F', 'S', 'C' };
+
+	// The binary scene header, followed by the object, light and component tables, then a blob
+	// holding the object names and component data. All offsets are from the start of the file
+	struct SceneFileHeader {
+		char     Magic[4];
+		uint32_t Version;
+		uint8_t  DefaultShader[16];
+		uint8_t  MainCamera[16];
+		uint32_t ObjectCount;
+		uint32_t LightCount;
+		uint32_t ComponentCount;
+		uint32_t ObjectOffset;
+		uint32_t LightOffset;
+		uint32_t ComponentOffset;
+		uint32_t BlobOffset;
+		uint32_t BlobSize;
+	};
+
+	// A game object, it's components are the ComponentCount entries in the component table
+	// starting at FirstComponent
+	struct SceneFileObject {
+		uint8_t  Guid[16];
+		float    Position[3];
+		float    Rotation[4];
+		float    Scale[3];
+		uint32_t NameOffset;
+		uint32_t NameLength;
+		uint32_t FirstComponent;
+		uint32_t ComponentCount;
+	};
+
+	struct SceneFileLight {
+		float Position[3];
+		float Color[3];
+		float Range;
+	};
+
+	// A component's data is stored as CBOR, keyed on the hash of it's type name
+	struct SceneFileComponent {
+		uint32_t TypeHash;
+		uint32_t DataOffset;
+		uint32_t DataSize;
+		uint32_t _padding0;
+	};
+
+	// Returns true if the path should be saved and loaded as a binary scene
+	static bool IsBinaryScenePath(const std::string& path) {
+		const size_t extensionLength = strlen(Scene::BINARY_EXTENSION);
+		return path.size() >= extensionLength && path.compare(path.size() - extensionLength, extensionLength, Scene::BINARY_EXTENSION) == 0;
+	}
+
+	// Writes the 16 raw bytes of a GUID stored as a string in JSON, or zeros if it's not valid
+	static void WriteGuidBytes(const nlohmann::json& blob, uint8_t* result) {
+		Guid guid = blob.is_string() ? Guid(blob.get<std::string>()) : Guid();
+		memcpy(result, guid.bytes(), 16);
+	}
+
+	// Writes a scene in the binary format from it's JSON representation
+	static bool WriteBinaryScene(const nlohmann::json& blob, const std::string& path) {
+		const nlohmann::json& objects = blob["objects"];
+		const nlohmann::json& lights = blob["lights"];
+
+		SceneFileHeader header;
+		memset(&header, 0, sizeof(SceneFileHeader));
+		memcpy(header.Magic, SCENE_FILE_MAGIC, 4);
+		header.Version = SCENE_FILE_VERSION;
+		WriteGuidBytes(blob["default_shader"], header.DefaultShader);
+		WriteGuidBytes(blob["main_camera"], header.MainCamera);
+
+		std::vector<SceneFileObject> objectTable;
+		std::vector<SceneFileLight> lightTable;
+		std::vector<SceneFileComponent> componentTable;
+		std::vector<uint8_t> data;
+		objectTable.reserve(objects.size());
+		lightTable.reserve(lights.size());
+
+		for (const nlohmann::json& object : objects) {
+			SceneFileObject entry;
+			WriteGuidBytes(object["guid"], entry.Guid);
+			glm::vec3 position = ParseJsonVec3(object["position"]);
+			glm::quat rotation = ParseJsonQuat(object["rotation"]);
+			glm::vec3 scale = ParseJsonVec3(object["scale"]);
+			memcpy(entry.Position, &position, sizeof(float) * 3);
+			memcpy(entry.Scale, &scale, sizeof(float) * 3);
+			// Quaternions are stored XYZW, regardless of GLM's memory layout
+			entry.Rotation[0] = rotation.x;
+			entry.Rotation[1] = rotation.y;
+			entry.Rotation[2] = rotation.z;
+			entry.Rotation[3] = rotation.w;
+
+			const std::string& name = object["name"].get_ref<const std::string&>();
+			entry.NameOffset = static_cast<uint32_t>(data.size());
+			entry.NameLength = static_cast<uint32_t>(name.size());
+			data.insert(data.end(), name.begin(), name.end());
+
+			entry.FirstComponent = static_cast<uint32_t>(componentTable.size());
+			entry.ComponentCount = 0;
+			if (object.contains("components") && object["components"].is_object()) {
+				for (auto& [typeName, value] : object["components"].items()) {
+					std::vector<uint8_t> cbor = nlohmann::json::to_cbor(value);
+					componentTable.push_back({ const_hash_fnv1a(typeName.c_str()), static_cast<uint32_t>(data.size()), static_cast<uint32_t>(cbor.size()), 0 });
+					data.insert(data.end(), cbor.begin(), cbor.end());
+					entry.ComponentCount++;
+				}
+			}
+			objectTable.push_back(entry);
+		}
+
+		for (const nlohmann::json& light : lights) {
+			Light parsed = Light::FromJson(light);
+			SceneFileLight entry;
+			memcpy(entry.Position, &parsed.Position, sizeof(float) * 3);
+			memcpy(entry.Color, &parsed.Color, sizeof(float) * 3);
+			entry.Range = parsed.Range;
+			lightTable.push_back(entry);
+		}
+
+		header.ObjectCount = static_cast<uint32_t>(objectTable.size());
+		header.LightCount = static_cast<uint32_t>(lightTable.size());
+		header.ComponentCount = static_cast<uint32_t>(componentTable.size());
+		header.ObjectOffset = sizeof(SceneFileHeader);
+		header.LightOffset = header.ObjectOffset + header.ObjectCount * sizeof(SceneFileObject);
+		header.ComponentOffset = header.LightOffset + header.LightCount * sizeof(SceneFileLight);
+		header.BlobOffset = header.ComponentOffset + header.ComponentCount * sizeof(SceneFileComponent);
+		header.BlobSize = static_cast<uint32_t>(data.size());
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			LOG_WARN("Failed to open \"{}\" for writing", path);
+			return false;
+		}
+		file.write(reinterpret_cast<const char*>(&header), sizeof(SceneFileHeader));
+		file.write(reinterpret_cast<const char*>(objectTable.data()), objectTable.size() * sizeof(SceneFileObject));
+		file.write(reinterpret_cast<const char*>(lightTable.data()), lightTable.size() * sizeof(SceneFileLight));
+		file.write(reinterpret_cast<const char*>(componentTable.data()), componentTable.size() * sizeof(SceneFileComponent));
+		file.write(reinterpret_cast<const char*>(data.data()), data.size());
+		return file.good();
+	}
+
+	/// <summary>
+	/// A SAX handler for nlohmann::json that creates game objects, components and lights as
+	/// their tokens arrive. Objects are filled in field by field, while small values such as
+	/// vectors, lights and the data for a single component are collected into a DOM first,
+	/// since that's what their loaders expect
+	/// </summary>
+	class Scene::JsonStreamReader : public nlohmann::json_sax<nlohmann::json> {
+	public:
+		JsonStreamReader(Scene* scene) :
+			MainCamera(Guid()),
+			_scene(scene),
+			_state(State::Root),
+			_nextState(State::Root),
+			_object(nullptr),
+			_onCaptured(nullptr),
+			_captureRoot(nullptr),
+			_captureStack(std::vector<nlohmann::json*>()),
+			_captureKey("")
+		{ }
+
+		// The main camera is referenced by GUID, and objects come after it in the file
+		Guid MainCamera;
+
+		bool null() override { return _Value(nullptr); }
+		bool boolean(bool value) override { return _Value(value); }
+		bool number_integer(number_integer_t value) override { return _Value(value); }
+		bool number_unsigned(number_unsigned_t value) override { return _Value(value); }
+		bool number_float(number_float_t value, const string_t&) override { return _Value(value); }
+		bool string(string_t& value) override { return _Value(std::move(value)); }
+		bool binary(binary_t& value) override { return _Value(nlohmann::json::binary(std::move(value))); }
+
+		bool start_object(std::size_t) override {
+			if (_IsCapturing() || _onCaptured) {
+				return _StartContainer(nlohmann::json::object());
+			}
+			switch (_state) {
+				case State::Root:
+					_state = State::Scene;
+					return true;
+				case State::Objects:
+					_object = _scene->_CreateDetachedObject();
+					_state = State::Object;
+					return true;
+				case State::Object:
+					if (_nextState != State::Components) {
+						return false;
+					}
+					_state = State::Components;
+					return true;
+				case State::Lights:
+					_onCaptured = [this](nlohmann::json&& blob) { _scene->Lights.push_back(Light::FromJson(blob)); };
+					return _StartContainer(nlohmann::json::object());
+				default:
+					return false;
+			}
+		}
+
+		bool end_object() override {
+			if (_IsCapturing()) {
+				return _EndContainer();
+			}
+			switch (_state) {
+				case State::Scene:
+					_state = State::Done;
+					return true;
+				case State::Object:
+					_scene->_AddObject(_object);
+					_object = nullptr;
+					_state = State::Objects;
+					return true;
+				case State::Components:
+					_state = State::Object;
+					_nextState = State::Object;
+					return true;
+				default:
+					return false;
+			}
+		}
+
+		bool start_array(std::size_t) override {
+			if (_IsCapturing() || _onCaptured) {
+				return _StartContainer(nlohmann::json::array());
+			}
+			if (_state == State::Scene && (_nextState == State::Objects || _nextState == State::Lights)) {
+				_state = _nextState;
+				_nextState = State::Scene;
+				return true;
+			}
+			return false;
+		}
+
+		bool end_array() override {
+			if (_IsCapturing()) {
+				return _EndContainer();
+			}
+			if (_state == State::Objects || _state == State::Lights) {
+				_state = State::Scene;
+				return true;
+			}
+			return false;
+		}
+
+		bool key(string_t& key) override {
+			if (_IsCapturing()) {
+				_captureKey = key;
+				return true;
+			}
+			switch (_state) {
+				case State::Scene:
+					if (key == "objects") {
+						_nextState = State::Objects;
+					} else if (key == "lights") {
+						_nextState = State::Lights;
+					} else if (key == "default_shader") {
+						_onCaptured = [this](nlohmann::json&& blob) { _scene->BaseShader = ResourceManager::Get<Shader>(Guid(blob.get<std::string>())); };
+					} else if (key == "main_camera") {
+						_onCaptured = [this](nlohmann::json&& blob) { MainCamera = Guid(blob.get<std::string>()); };
+					} else {
+						_onCaptured = [](nlohmann::json&&) {};
+					}
+					return true;
+				case State::Object:
+					if (key == "components") {
+						_nextState = State::Components;
+					} else if (key == "name") {
+						_onCaptured = [this](nlohmann::json&& blob) { _object->Name = blob.get<std::string>(); };
+					} else if (key == "guid") {
+						_onCaptured = [this](nlohmann::json&& blob) { _object->GUID = Guid(blob.get<std::string>()); };
+					} else if (key == "position") {
+						_onCaptured = [this](nlohmann::json&& blob) { _object->SetPostion(ParseJsonVec3(blob)); };
+					} else if (key == "rotation") {
+						_onCaptured = [this](nlohmann::json&& blob) { _object->SetRotation(ParseJsonQuat(blob)); };
+					} else if (key == "scale") {
+						_onCaptured = [this](nlohmann::json&& blob) { _object->SetScale(ParseJsonVec3(blob)); };
+					} else {
+						_onCaptured = [](nlohmann::json&&) {};
+					}
+					return true;
+				case State::Components:
+					// The key is the component's type name, and the value is it's data
+					_onCaptured = [this, typeName = std::string(key)](nlohmann::json&& blob) {
+						IComponent::Sptr component = ComponentManager::Load(typeName, blob);
+						if (component == nullptr) {
+							LOG_WARN("Skipping component with unregistered type {} on \"{}\"", typeName, _object->Name);
+							return;
+						}
+						_AttachLoadedComponent(_object, component);
+					};
+					return true;
+				default:
+					return false;
+			}
+		}
+
+		bool parse_error(std::size_t position, const std::string& lastToken, const nlohmann::detail::exception& ex) override {
+			LOG_WARN("Failed to parse scene at byte {} (near \"{}\"): {}", position, lastToken, ex.what());
+			return false;
+		}
+
+		// Returns true if the whole scene object has been read
+		bool IsDone() const { return _state == State::Done; }
+
+	protected:
+		enum class State {
+			Root,
+			Scene,
+			Objects,
+			Object,
+			Components,
+			Lights,
+			Done
+		};
+
+		Scene*           _scene;
+		State            _state;
+		// The state to enter when the next container starts, set by the key before it
+		State            _nextState;
+		// The object we are currently filling in
+		GameObject::Sptr _object;
+
+		// When set, the next value is collected into a DOM and passed to this callback
+		std::function<void(nlohmann::json&&)> _onCaptured;
+		nlohmann::json                        _captureRoot;
+		// The containers we are currently collecting into, innermost last
+		std::vector<nlohmann::json*>          _captureStack;
+		// The key for the next value in the innermost captured object
+		std::string                           _captureKey;
+
+		bool _IsCapturing() const { return !_captureStack.empty(); }
+
+		// Adds a value to the innermost captured container, and returns a pointer to where it was stored
+		nlohmann::json* _AddToCapture(nlohmann::json&& value) {
+			nlohmann::json& parent = *_captureStack.back();
+			if (parent.is_array()) {
+				parent.push_back(std::move(value));
+				return &parent.back();
+			}
+			nlohmann::json& result = parent[_captureKey];
+			result = std::move(value);
+			return &result;
+		}
+
+		// Handles a scalar value
+		bool _Value(nlohmann::json&& value) {
+			if (_IsCapturing()) {
+				_AddToCapture(std::move(value));
+				return true;
+			}
+			// Scalars at the top level of a capture complete it immediately
+			if (_onCaptured) {
+				auto callback = std::move(_onCaptured);
+				_onCaptured = nullptr;
+				callback(std::move(value));
+				return true;
+			}
+			return false;
+		}
+
+		bool _StartContainer(nlohmann::json&& container) {
+			if (_IsCapturing()) {
+				_captureStack.push_back(_AddToCapture(std::move(container)));
+				return true;
+			}
+			if (_onCaptured) {
+				_captureRoot = std::move(container);
+				_captureStack.push_back(&_captureRoot);
+				return true;
+			}
+			return false;
+		}
+
+		bool _EndContainer() {
+			_captureStack.pop_back();
+			if (_captureStack.empty()) {
+				auto callback = std::move(_onCaptured);
+				_onCaptured = nullptr;
+				callback(std::move(_captureRoot));
+				_captureRoot = nullptr;
+			}
+			return true;
+		}
+	};
+
 	Scene::Scene() :
-		Objects(std::vector<GameObject::Sptr>()),
 		Lights(std::vector<Light>()),
-		IsPlaying(false),
 		MainCamera(nullptr),
 		BaseShader(nullptr),
-		_isAwake(false),
+		IsPlaying(false),
 		_filePath(""),
+		_gravity(glm::vec3(0.0f, 0.0f, -20.f)),
+		Objects(std::vector<GameObject::Sptr>()),
+		_transforms(std::make_shared<TransformStore>()),
 		_ambientLight(glm::vec3(0.1f)),
-		_gravity(glm::vec3(0.0f, 0.0f, -20.f))
+		_frameUniforms(UniformBuffer::Create()),
+		_lightUniforms(UniformBuffer::Create()),
+		_lightData(LightUniforms()),
+		_lightGrid(std::make_shared<LightGrid>()),
+		_isAwake(false),
+		_isActive(true)
 	{
 		_InitPhysics();
+		// Make sure the light buffers have storage before the first frame, even if we have no lights
+		_UploadLights();
 	}
 
 	Scene::~Scene() {
+		_nameIndex.clear();
 		Objects.clear();
 		_CleanupPhysics();
 	}
@@ -36,18 +437,38 @@ namespace Gameplay {
 
 	GameObject::Sptr Scene::CreateGameObject(const std::string& name)
 	{
-		GameObject::Sptr result(new GameObject());
+		GameObject::Sptr result(new GameObject(this));
 		result->Name = name;
-		result->_scene = this;
-		Objects.push_back(result);
+		_AddObject(result);
 		return result;
 	}
 
-	GameObject::Sptr Scene::FindObjectByName(const std::string name) {
-		auto it = std::find_if(Objects.begin(), Objects.end(), [&](const GameObject::Sptr& obj) {
-			return obj->Name == name;
-		});
-		return it == Objects.end() ? nullptr : *it;
+	void Scene::RemoveGameObject(const GameObject::Sptr& object) {
+		auto it = std::find(Objects.begin(), Objects.end(), object);
+		if (it == Objects.end()) {
+			return;
+		}
+		Objects.erase(it);
+		object->_scene = nullptr;
+
+		// If this object was the one indexed for it's name, the next object
+		// with the same name (if any) takes it's place
+		auto indexIt = _nameIndex.find(object->Name);
+		if (indexIt != _nameIndex.end() && indexIt->second == object) {
+			auto next = std::find_if(Objects.begin(), Objects.end(), [&](const GameObject::Sptr& obj) {
+				return obj->Name == object->Name;
+			});
+			if (next != Objects.end()) {
+				indexIt->second = *next;
+			} else {
+				_nameIndex.erase(indexIt);
+			}
+		}
+	}
+
+	GameObject::Sptr Scene::FindObjectByName(const std::string& name) const {
+		auto it = _nameIndex.find(name);
+		return it == _nameIndex.end() ? nullptr : it->second;
 	}
 
 	GameObject::Sptr Scene::FindObjectByGUID(Guid id) {
@@ -59,7 +480,8 @@ namespace Gameplay {
 
 	void Scene::SetAmbientLight(const glm::vec3& value) {
 		_ambientLight = value;
-		BaseShader->SetUniform("u_AmbientCol", glm::vec3(value));
+		_lightData.AmbientCol = value;
+		_lightUniforms->Update(_lightData);
 	}
 
 	const glm::vec3& Scene::GetAmbientLight() const { 
@@ -83,21 +505,40 @@ namespace Gameplay {
 		_isAwake = true;
 	}
 
+	void Scene::SetActive(bool active) {
+		if (active == _isActive) {
+			return;
+		}
+		_isActive = active;
+
+		for (const auto& object : Objects) {
+			for (const auto& component : object->_components) {
+				if (active) {
+					ComponentManager::Attach(component.get());
+				} else {
+					ComponentManager::Detach(component.get());
+				}
+			}
+		}
+	}
+
 	void Scene::DoPhysics(float dt) {
 		if (IsPlaying) {
-			ComponentManager::Each<Gameplay::Physics::RigidBody>([=](const std::shared_ptr<Gameplay::Physics::RigidBody>& body) {
+			// Scenes that are only being kept loaded are detached from the pools (see SetActive),
+			// so these are only the active scene's bodies
+			ComponentManager::Each<Gameplay::Physics::RigidBody>([=](Gameplay::Physics::RigidBody* body) {
 				body->PhysicsPreStep(dt);
 			});
-			ComponentManager::Each<Gameplay::Physics::TriggerVolume>([=](const std::shared_ptr<Gameplay::Physics::TriggerVolume>& body) {
+			ComponentManager::Each<Gameplay::Physics::TriggerVolume>([=](Gameplay::Physics::TriggerVolume* body) {
 				body->PhysicsPreStep(dt);
 			}); 
 
 			_physicsWorld->stepSimulation(dt, 15);
 
-			ComponentManager::Each<Gameplay::Physics::RigidBody>([=](const std::shared_ptr<Gameplay::Physics::RigidBody>& body) {
+			ComponentManager::Each<Gameplay::Physics::RigidBody>([=](Gameplay::Physics::RigidBody* body) {
 				body->PhysicsPostStep(dt);
 			});
-			ComponentManager::Each<Gameplay::Physics::TriggerVolume>([=](const std::shared_ptr<Gameplay::Physics::TriggerVolume>& body) {
+			ComponentManager::Each<Gameplay::Physics::TriggerVolume>([=](Gameplay::Physics::TriggerVolume* body) {
 				body->PhysicsPostStep(dt);
 			});
 			if (_bulletDebugDraw->getDebugMode() != btIDebugDraw::DBG_NoDebug) {
@@ -115,24 +556,52 @@ namespace Gameplay {
 		}
 	}
 
+	void Scene::UpdateTransforms() {
+		_transforms->UpdateWorldMatrices();
+	}
+
+	void Scene::PreRender() {
+		FrameUniforms frame;
+		frame.ViewProjection = MainCamera->GetViewProjection();
+		frame.CameraPos = MainCamera->GetGameObject()->GetPosition();
+		_frameUniforms->Update(frame);
+
+		_frameUniforms->Bind(FRAME_UNIFORM_BINDING);
+		_lightUniforms->Bind(LIGHT_UNIFORM_BINDING);
+		_lightGrid->Bind(LIGHT_CLUSTER_BINDING);
+	}
+
 	void Scene::SetShaderLight(int index, bool update /*= true*/) {
-		std::stringstream stream;
-		stream << "u_Lights[" << index << "]";
-		std::string name = stream.str();
+		if (index >= MAX_LIGHTS) {
+			LOG_WARN("Light {} exceeds the max of {} lights, ignoring", index, (int)MAX_LIGHTS);
+			return;
+		}
 
 		Light& light = Lights[index];
-	
-		// Set the shader uniforms for the light
-		BaseShader->SetUniform(name + ".Position", light.Position);
-		BaseShader->SetUniform(name + ".Color", light.Color);
-		BaseShader->SetUniform(name + ".Attenuation", 1.0f / (1.0f + light.Range));
+
+		// Copy the light into our uniform block
+		LightUniform& data = _lightData.Lights[index];
+		data.Position = light.Position;
+		data.Color = light.Color;
+		data.Attenuation = 1.0f / (1.0f + light.Range);
+
+		if (update) {
+			_UploadLights();
+		}
 	}
 
 	void Scene::SetupShaderAndLights() {
-		BaseShader->SetUniform("u_NumLights", (int)Lights.size());
-		for (int ix = 0; ix < Lights.size(); ix++) {
-			SetShaderLight(ix, true);
+		_lightData.NumLights = (int)glm::min(Lights.size(), (size_t)MAX_LIGHTS);
+		_lightData.AmbientCol = _ambientLight;
+		for (int ix = 0; ix < _lightData.NumLights; ix++) {
+			SetShaderLight(ix, false);
 		}
+		_UploadLights();
+	}
+
+	void Scene::_UploadLights() {
+		_lightUniforms->Update(_lightData);
+		_lightGrid->Build(_lightData);
 	}
 
 	btDynamicsWorld* Scene::GetPhysicsWorld() const {
@@ -147,7 +616,7 @@ namespace Gameplay {
 		// Make sure the scene has objects, then load them all in!
 		LOG_ASSERT(data["objects"].is_array(), "Objects not present in scene!");
 		for (auto& object : data["objects"]) {
-			result->Objects.push_back(GameObject::FromJson(object, result.get()));
+			result->_AddObject(GameObject::FromJson(object, result.get()));
 		}
 
 		// Make sure the scene has lights, then load all
@@ -193,17 +662,337 @@ namespace Gameplay {
 	void Scene::Save(const std::string& path) {
 		_filePath = path;
 		// Save data to file
-		FileHelpers::WriteContentsToFile(path, ToJson().dump(1, '\t'));
+		if (IsBinaryScenePath(path)) {
+			WriteBinaryScene(ToJson(), path);
+		} else {
+			FileHelpers::WriteContentsToFile(path, ToJson().dump(1, '\t'));
+		}
 		LOG_INFO("Saved scene to \"{}\"", path);
 	}
 
 	Scene::Sptr Scene::Load(const std::string& path)
 	{
 		LOG_INFO("Loading scene from \"{}\"", path);
-		std::string content = FileHelpers::ReadFile(path);
-		nlohmann::json blob = nlohmann::json::parse(content);
-		Scene::Sptr result = FromJson(blob);
+		double startTime = glfwGetTime();
+
+		Scene::Sptr result = IsBinaryScenePath(path) ? _LoadBinary(path) : _LoadJsonStreaming(path);
+		if (result == nullptr) {
+			LOG_ERROR("Failed to load scene \"{}\"", path);
+			return nullptr;
+		}
 		result->_filePath = path;
+
+		LOG_INFO("Loaded {} objects from \"{}\" in {:.3f}s", result->Objects.size(), path, glfwGetTime() - startTime);
+		return result;
+	}
+
+	Scene::Sptr Scene::_LoadJsonStreaming(const std::string& path) {
+		MappedFile file(path);
+		if (!file.IsOpen()) {
+			LOG_WARN("Failed to open scene \"{}\"", path);
+			return nullptr;
+		}
+
+		Scene::Sptr result = std::make_shared<Scene>();
+		JsonStreamReader reader(result.get());
+		const char* data = file.GetData();
+		if (!nlohmann::json::sax_parse(data, data + file.GetSize(), &reader) || !reader.IsDone()) {
+			return nullptr;
+		}
+
+		result->MainCamera = ComponentManager::GetComponentByGUID<Camera>(reader.MainCamera);
+		return result;
+	}
+
+	// Layout of a snapshot:
+	//   uint32 light count, then the lights
+	//   uint32 object count, then for each object:
+	//     GUID, position, rotation, scale, uint32 component count, then for each component:
+	//       type ID, IsEnabled, uint32 size of the component's data, then the component's data
+	SceneSnapshot::Sptr Scene::TakeSnapshot() const {
+		SceneSnapshot::Sptr result = std::make_shared<SceneSnapshot>();
+
+		result->Write(static_cast<uint32_t>(Lights.size()));
+		for (const Light& light : Lights) {
+			result->Write(light);
+		}
+
+		result->Write(static_cast<uint32_t>(Objects.size()));
+		for (const GameObject::Sptr& object : Objects) {
+			result->Write(object->GUID);
+			result->Write(object->GetPosition());
+			result->Write(object->GetRotation());
+			result->Write(object->GetScale());
+
+			result->Write(static_cast<uint32_t>(object->_components.size()));
+			for (const IComponent::Sptr& component : object->_components) {
+				result->Write(component->_typeId);
+				result->Write(component->IsEnabled);
+
+				// Reserve space for the size, and fill it in once we know how much was written
+				const size_t sizeOffset = result->GetSize();
+				result->Write(static_cast<uint32_t>(0));
+				component->WriteSnapshot(*result);
+				const uint32_t size = static_cast<uint32_t>(result->GetSize() - sizeOffset - sizeof(uint32_t));
+				memcpy(result->_data.data() + sizeOffset, &size, sizeof(uint32_t));
+			}
+		}
+
+		return result;
+	}
+
+	bool Scene::RestoreSnapshot(const SceneSnapshot::Sptr& snapshot) {
+		LOG_ASSERT(snapshot != nullptr, "Cannot restore a null snapshot!");
+		SceneSnapshot& data = *snapshot;
+
+		// Skip the lights for now, we'll come back to them once we know we can restore
+		data._Seek(0);
+		uint32_t lightCount;
+		data.Read(lightCount);
+		const size_t objectsOffset = data._Tell() + lightCount * sizeof(Light);
+		data._Seek(objectsOffset);
+
+		// Make sure every object in the snapshot still exists with the same components before
+		// we touch anything, so that we never leave the scene half restored
+		std::unordered_map<Guid, GameObject*> objectMap;
+		objectMap.reserve(Objects.size());
+		for (const GameObject::Sptr& object : Objects) {
+			objectMap[object->GUID] = object.get();
+		}
+
+		uint32_t objectCount;
+		data.Read(objectCount);
+		std::vector<GameObject*> targets;
+		targets.reserve(objectCount);
+		for (uint32_t ix = 0; ix < objectCount; ix++) {
+			Guid id;
+			data.Read(id);
+			auto it = objectMap.find(id);
+			if (it == objectMap.end()) {
+				return false;
+			}
+			GameObject* object = it->second;
+			targets.push_back(object);
+
+			data._Seek(data._Tell() + sizeof(glm::vec3) + sizeof(glm::quat) + sizeof(glm::vec3));
+			uint32_t componentCount;
+			data.Read(componentCount);
+			if (componentCount != object->_components.size()) {
+				return false;
+			}
+			for (uint32_t componentIx = 0; componentIx < componentCount; componentIx++) {
+				IComponent::TypeId type;
+				bool isEnabled;
+				uint32_t size;
+				data.Read(type);
+				data.Read(isEnabled);
+				data.Read(size);
+				if (object->_components[componentIx]->_typeId != type) {
+					return false;
+				}
+				data._Seek(data._Tell() + size);
+			}
+		}
+
+		// Remove any objects that were created after the snapshot was taken
+		if (targets.size() != Objects.size()) {
+			std::unordered_set<GameObject*> inSnapshot(targets.begin(), targets.end());
+			std::vector<GameObject::Sptr> created;
+			for (const GameObject::Sptr& object : Objects) {
+				if (inSnapshot.find(object.get()) == inSnapshot.end()) {
+					created.push_back(object);
+				}
+			}
+			for (const GameObject::Sptr& object : created) {
+				RemoveGameObject(object);
+			}
+		}
+
+		// Now we can apply everything
+		data._Seek(0);
+		data.Read(lightCount);
+		Lights.resize(lightCount);
+		for (Light& light : Lights) {
+			data.Read(light);
+		}
+		SetupShaderAndLights();
+
+		data.Read(objectCount);
+		for (GameObject* object : targets) {
+			Guid id;
+			glm::vec3 position, scale;
+			glm::quat rotation;
+			data.Read(id);
+			data.Read(position);
+			data.Read(rotation);
+			data.Read(scale);
+			object->SetPostion(position);
+			object->SetRotation(rotation);
+			object->SetScale(scale);
+
+			uint32_t componentCount;
+			data.Read(componentCount);
+			for (const IComponent::Sptr& component : object->_components) {
+				IComponent::TypeId type;
+				uint32_t size;
+				data.Read(type);
+				data.Read(component->IsEnabled);
+				data.Read(size);
+
+				const size_t end = data._Tell() + size;
+				component->ReadSnapshot(data);
+				LOG_ASSERT(data._Tell() == end, "{} did not read back the same amount of data it wrote to the snapshot!", component->ComponentTypeName());
+			}
+		}
+
+		return true;
+	}
+
+	GameObject::Sptr Scene::_CreateDetachedObject() {
+		return GameObject::Sptr(new GameObject(this));
+	}
+
+	void Scene::_AttachLoadedComponent(const GameObject::Sptr& object, const IComponent::Sptr& component) {
+		object->_AttachLoadedComponent(component);
+	}
+
+	bool Scene::ConvertToBinary(const std::string& jsonPath, const std::string& binaryPath) {
+		std::string content = FileHelpers::ReadFile(jsonPath);
+		nlohmann::json blob = nlohmann::json::parse(content, nullptr, false);
+		if (blob.is_discarded() || !blob["objects"].is_array() || !blob["lights"].is_array()) {
+			LOG_WARN("\"{}\" is not a valid scene file", jsonPath);
+			return false;
+		}
+		if (!WriteBinaryScene(blob, binaryPath)) {
+			return false;
+		}
+		LOG_INFO("Converted \"{}\" to \"{}\"", jsonPath, binaryPath);
+		return true;
+	}
+
+	std::string Scene::GetBinaryPath(const std::string& path) {
+		if (IsBinaryScenePath(path)) {
+			return path;
+		}
+		// Only strip the extension if the dot is in the file name, not a directory
+		size_t extension = path.find_last_of('.');
+		size_t separator = path.find_last_of("/\\");
+		if (extension == std::string::npos || (separator != std::string::npos && extension < separator)) {
+			return path + BINARY_EXTENSION;
+		}
+		return path.substr(0, extension) + BINARY_EXTENSION;
+	}
+
+	Scene::Sptr Scene::_LoadBinary(const std::string& path) {
+		MappedFile file(path);
+		if (!file.IsOpen() || file.GetSize() < sizeof(SceneFileHeader)) {
+			return nullptr;
+		}
+		const char* data = file.GetData();
+		const size_t size = file.GetSize();
+
+		SceneFileHeader header;
+		memcpy(&header, data, sizeof(SceneFileHeader));
+		if (memcmp(header.Magic, SCENE_FILE_MAGIC, 4) != 0 || header.Version != SCENE_FILE_VERSION) {
+			LOG_WARN("\"{}\" is not a binary scene, or is from an older version", path);
+			return nullptr;
+		}
+
+		// Make sure all the tables actually fit in the file before we touch them
+		if (header.ObjectOffset + (size_t)header.ObjectCount * sizeof(SceneFileObject) > size ||
+			header.LightOffset + (size_t)header.LightCount * sizeof(SceneFileLight) > size ||
+			header.ComponentOffset + (size_t)header.ComponentCount * sizeof(SceneFileComponent) > size ||
+			(size_t)header.BlobOffset + header.BlobSize > size) {
+			LOG_WARN("Binary scene \"{}\" is truncated", path);
+			return nullptr;
+		}
+
+		// The tables are all 4 byte aligned, and so is the start of a mapping
+		const SceneFileObject* objects = reinterpret_cast<const SceneFileObject*>(data + header.ObjectOffset);
+		const SceneFileLight* lights = reinterpret_cast<const SceneFileLight*>(data + header.LightOffset);
+		const SceneFileComponent* components = reinterpret_cast<const SceneFileComponent*>(data + header.ComponentOffset);
+		const uint8_t* blob = reinterpret_cast<const uint8_t*>(data + header.BlobOffset);
+
+		Scene::Sptr result = std::make_shared<Scene>();
+		uint8_t guidBytes[16];
+		memcpy(guidBytes, header.DefaultShader, 16);
+		result->BaseShader = ResourceManager::Get<Shader>(Guid::FromBytes(guidBytes));
+
+		result->Objects.reserve(header.ObjectCount);
+		for (uint32_t ix = 0; ix < header.ObjectCount; ix++) {
+			const SceneFileObject& entry = objects[ix];
+			if ((size_t)entry.NameOffset + entry.NameLength > header.BlobSize ||
+				(size_t)entry.FirstComponent + entry.ComponentCount > header.ComponentCount) {
+				LOG_WARN("Binary scene \"{}\" has an object that points outside of the file", path);
+				return nullptr;
+			}
+
+			// Scene is a friend of GameObject, so we can use it's protected constructor
+			GameObject::Sptr object(new GameObject(result.get()));
+			object->Name = std::string(reinterpret_cast<const char*>(blob + entry.NameOffset), entry.NameLength);
+			memcpy(guidBytes, entry.Guid, 16);
+			object->GUID = Guid::FromBytes(guidBytes);
+			object->SetPostion(glm::vec3(entry.Position[0], entry.Position[1], entry.Position[2]));
+			object->SetRotation(glm::quat(entry.Rotation[3], entry.Rotation[0], entry.Rotation[1], entry.Rotation[2]));
+			object->SetScale(glm::vec3(entry.Scale[0], entry.Scale[1], entry.Scale[2]));
+
+			for (uint32_t componentIx = 0; componentIx < entry.ComponentCount; componentIx++) {
+				const SceneFileComponent& component = components[entry.FirstComponent + componentIx];
+				if ((size_t)component.DataOffset + component.DataSize > header.BlobSize) {
+					LOG_WARN("Binary scene \"{}\" has a component on \"{}\" that points outside of the file", path, object->Name);
+					return nullptr;
+				}
+				nlohmann::json componentBlob = nlohmann::json::from_cbor(blob + component.DataOffset, blob + component.DataOffset + component.DataSize, true, false);
+				if (componentBlob.is_discarded()) {
+					LOG_WARN("Binary scene \"{}\" has invalid component data on \"{}\"", path, object->Name);
+					return nullptr;
+				}
+				IComponent::Sptr loaded = ComponentManager::Load(component.TypeHash, componentBlob);
+				if (loaded == nullptr) {
+					LOG_WARN("Skipping component with unregistered type hash {} on \"{}\"", component.TypeHash, object->Name);
+					continue;
+				}
+				object->_AttachLoadedComponent(loaded);
+			}
+			result->_AddObject(object);
+		}
+
+		result->Lights.reserve(header.LightCount);
+		for (uint32_t ix = 0; ix < header.LightCount; ix++) {
+			Light light;
+			light.Position = glm::vec3(lights[ix].Position[0], lights[ix].Position[1], lights[ix].Position[2]);
+			light.Color = glm::vec3(lights[ix].Color[0], lights[ix].Color[1], lights[ix].Color[2]);
+			light.Range = lights[ix].Range;
+			result->Lights.push_back(light);
+		}
+
+		memcpy(guidBytes, header.MainCamera, 16);
+		result->MainCamera = ComponentManager::GetComponentByGUID<Camera>(Guid::FromBytes(guidBytes));
+
+		return result;
+	}
+
+	size_t Scene::EstimateMemoryUsage() const {
+		size_t result = sizeof(Scene);
+
+		// Bullet allocates pools for contact manifolds and collision algorithms up front, which
+		// is most of what an empty scene costs
+		btPoolAllocator* manifolds = _collisionConfig->getPersistentManifoldPool();
+		btPoolAllocator* algorithms = _collisionConfig->getCollisionAlgorithmPool();
+		result += (size_t)manifolds->getMaxCount() * manifolds->getElementSize();
+		result += (size_t)algorithms->getMaxCount() * algorithms->getElementSize();
+		// Every body has it's own collision object, and usually a shape of about the same size
+		result += (size_t)_physicsWorld->getNumCollisionObjects() * sizeof(btRigidBody) * 2;
+
+		// Each transform slot has it's position, rotation, scale and cached matrices
+		result += _transforms->Size() * (sizeof(glm::vec3) * 2 + sizeof(glm::quat) + sizeof(glm::mat4) + sizeof(glm::mat3));
+
+		for (const auto& object : Objects) {
+			result += sizeof(GameObject) + object->Name.capacity();
+			for (const auto& component : object->_components) {
+				result += ComponentManager::GetSize(component.get());
+			}
+		}
 		return result;
 	}
 
@@ -215,6 +1004,13 @@ namespace Gameplay {
 		return Objects[index];
 	}
 
+	void Scene::_AddObject(const GameObject::Sptr& object) {
+		Objects.push_back(object);
+		// emplace will not overwrite an existing entry, so the index always
+		// refers to the first object created with a given name
+		_nameIndex.emplace(object->Name, object);
+	}
+
 	void Scene::_InitPhysics() {
 		_collisionConfig = new btDefaultCollisionConfiguration();
 		_collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
@@ -250,4 +1046,33 @@ namespace Gameplay {
 			object->DrawImGui();
 		}
 	}
+
+	ObjectHandle::ObjectHandle() :
+		_name(""),
+		_object()
+	{ }
+
+	ObjectHandle::ObjectHandle(const std::string& name) :
+		_name(name),
+		_object()
+	{ }
+
+	GameObject::Sptr ObjectHandle::Get(const Scene::Sptr& scene) {
+		if (scene == nullptr) {
+			return nullptr;
+		}
+
+		// Objects that were removed or belong to a scene that has since been
+		// replaced will either be expired or point to a different scene
+		GameObject::Sptr result = _object.lock();
+		if (result == nullptr || result->GetScene() != scene.get()) {
+			result = scene->FindObjectByName(_name);
+			_object = result;
+		}
+		return result;
+	}
+
+	void ObjectHandle::Reset() {
+		_object.reset();
+	}
 }
\ No newline at end of file
@@ -1,10 +1,15 @@
 #pragma once
 #include <btBulletDynamicsCommon.h>
 #include "BulletCollision/CollisionDispatch/btGhostObject.h"
+#include <unordered_map>
 
 #include "Gameplay/Components/Camera.h"
 #include "Gameplay/GameObject.h"
+#include "Gameplay/SceneSnapshot.h"
 #include "Gameplay/Light.h"
+#include "Gameplay/UniformBlocks.h"
+#include "Gameplay/LightGrid.h"
+#include "Graphics/UniformBuffer.h"
 #include "Physics/BulletDebugDraw.h"
 
 struct GLFWwindow;
@@ -23,7 +28,7 @@ namespace Gameplay {
 	public:
 		typedef std::shared_ptr<Scene> Sptr;
 
-		static const int MAX_LIGHTS = 40;
+		static const int MAX_LIGHTS = MAX_UNIFORM_LIGHTS;
 
 		// Stores all the lights in our scene
 		std::vector<Light>         Lights;
@@ -48,6 +53,18 @@ namespace Gameplay {
 		 */
 		bool GetIsAwake() const { return _isAwake; }
 
+		/// <summary>
+		/// Sets whether this scene's components are in the global component pools. Scenes that
+		/// are kept loaded but are not being played (see SceneCache) are deactivated, so that
+		/// systems walking the pools (rendering, physics) only see the active scene
+		/// </summary>
+		/// <param name="active">True to attach all of the scene's components, false to detach them</param>
+		void SetActive(bool active);
+		/**
+		 * Gets whether the scene's components are in the global component pools, see SetActive
+		 */
+		bool GetIsActive() const { return _isActive; }
+
 		/// <summary>
 		/// Creates a game object with the given name
 		/// CreateGameObject is the only way to create game objects
@@ -57,12 +74,22 @@ namespace Gameplay {
 		GameObject::Sptr CreateGameObject(const std::string& name);
 
 		/// <summary>
-		/// Searches all objects in the scene and returns the first
-		/// one who's name matches the one given, or nullptr if no object
-		/// is found
+		/// Removes a game object from the scene, the object will be destroyed
+		/// once the last reference to it is released
+		/// </summary>
+		/// <param name="object">The object to remove</param>
+		void RemoveGameObject(const GameObject::Sptr& object);
+
+		/// <summary>
+		/// Returns the first object in the scene who's name matches the one given,
+		/// or nullptr if no object is found. This uses the scene's name index, so
+		/// it is a hash lookup rather than a search over all objects
+		/// 
+		/// NOTE: the index is built from the name an object has when it's added
+		/// to the scene, renaming an object afterwards is not reflected here
 		/// </summary>
 		/// <param name="name">The name of the object to find</param>
-		GameObject::Sptr FindObjectByName(const std::string name);
+		GameObject::Sptr FindObjectByName(const std::string& name) const;
 		/// <summary>
 		/// Searches all render objects in the scene and returns the first
 		/// one who's guid matches the one given, or nullptr if no object
@@ -111,15 +138,26 @@ namespace Gameplay {
 		void Update(float dt);
 
 		/// <summary>
-		/// Handles setting the shader uniforms for our light structure in our array of lights
+		/// Recalculates the world transforms for all objects that have moved since the
+		/// last update in a single pass, should be called after physics and before rendering
+		/// </summary>
+		void UpdateTransforms();
+
+		/// <summary>
+		/// Uploads the camera data for this frame and binds the scene's uniform blocks,
+		/// should be called once per frame before rendering
+		/// </summary>
+		void PreRender();
+
+		/// <summary>
+		/// Copies a light into the scene's light uniform block
 		/// </summary>
-		/// <param name="shader">The pointer to the shader</param>
-		/// <param name="uniformName">The name of the uniform (ex: u_Lights)</param>
 		/// <param name="index">The index of the light to set</param>
-		/// <param name="light">The light data to copy over</param>
+		/// <param name="update">True to upload the light block to the GPU right away</param>
 		void SetShaderLight(int index, bool update = true);
 		/// <summary>
-		/// Creates the shader and sets up all the lights
+		/// Copies all the lights and the ambient color into the light uniform block and
+		/// uploads it
 		/// </summary>
 		void SetupShaderAndLights();
 
@@ -143,22 +181,90 @@ namespace Gameplay {
 		nlohmann::json ToJson() const;
 
 		/// <summary>
-		/// Saves this scene to an output JSON file
+		/// Captures the transforms, lights and component state for every object in the scene
+		/// into a flat buffer, so it can be restored later with RestoreSnapshot
+		/// </summary>
+		SceneSnapshot::Sptr TakeSnapshot() const;
+		/// <summary>
+		/// Restores a snapshot taken with TakeSnapshot in place, without re-creating objects,
+		/// components or physics bodies. Objects created since the snapshot are removed
+		/// 
+		/// If an object in the snapshot has since been removed, or has had components added or
+		/// removed, the snapshot can't be applied in place and nothing is changed
+		/// </summary>
+		/// <param name="snapshot">The snapshot to restore</param>
+		/// <returns>True if the snapshot was restored, false if the scene no longer matches it</returns>
+		bool RestoreSnapshot(const SceneSnapshot::Sptr& snapshot);
+
+		/// <summary>
+		/// Saves this scene to an output file. Paths ending in BINARY_EXTENSION are saved in
+		/// the binary scene format, anything else is saved as JSON
 		/// </summary>
 		/// <param name="path">The path of the file to write to</param>
 		void Save(const std::string& path);
 		/// <summary>
-		/// Loads a scene from an input JSON file
+		/// Loads a scene from an input file, the format is chosen from the extension like in Save
 		/// </summary>
 		/// <param name="path">The path of the file to read from</param>
-		/// <returns>A new scene loaded from the file</returns>
+		/// <returns>A new scene loaded from the file, or nullptr if the file is missing or invalid</returns>
 		static Scene::Sptr Load(const std::string& path);
 
+		/// <summary>
+		/// The file extension for scenes in the binary format
+		/// </summary>
+		static constexpr const char* BINARY_EXTENSION = ".scene";
+		/// <summary>
+		/// Converts a JSON scene file into the binary scene format. This works directly on the
+		/// file contents, so the scene's resources do not need to be loaded
+		/// </summary>
+		/// <param name="jsonPath">The path to the JSON scene to convert</param>
+		/// <param name="binaryPath">The path to write the binary scene to</param>
+		/// <returns>True if the scene was converted</returns>
+		static bool ConvertToBinary(const std::string& jsonPath, const std::string& binaryPath);
+		/// <summary>
+		/// Gets the path that the binary version of a scene file should be saved to, ie the path
+		/// with it's extension replaced by BINARY_EXTENSION
+		/// </summary>
+		/// <param name="path">The path of the scene file</param>
+		static std::string GetBinaryPath(const std::string& path);
+
+
+		/// <summary>
+		/// Makes a rough guess at how much memory this scene is using in bytes, including it's
+		/// physics world, objects and components. Shared resources like meshes and textures are
+		/// not counted
+		/// </summary>
+		size_t EstimateMemoryUsage() const;
 
 		int NumObjects() const;
 		GameObject::Sptr GetObjectByIndex(int index) const;
 
 	protected:
+		// Objects need to grab our transform store when they're created
+		friend struct GameObject;
+
+		/// <summary>
+		/// Loads a scene from a file in the binary scene format, returns nullptr if the file is invalid
+		/// </summary>
+		static Scene::Sptr _LoadBinary(const std::string& path);
+
+		// Builds a scene from JSON tokens as they are parsed, see _LoadJsonStreaming
+		class JsonStreamReader;
+		/// <summary>
+		/// Loads a scene from a JSON file, creating objects and components as the file is parsed
+		/// rather than building a DOM for the whole file first. Returns nullptr if the file is invalid
+		/// </summary>
+		static Scene::Sptr _LoadJsonStreaming(const std::string& path);
+		/// <summary>
+		/// Creates a game object for this scene without adding it to the object list, used by loaders
+		/// that need to fill in the object before it can be indexed
+		/// </summary>
+		GameObject::Sptr _CreateDetachedObject();
+		/// <summary>
+		/// Attaches a freshly loaded component to a game object, see GameObject::_AttachLoadedComponent
+		/// </summary>
+		static void _AttachLoadedComponent(const GameObject::Sptr& object, const IComponent::Sptr& component);
+
 		// Bullet physics stuff world
 		btDynamicsWorld*          _physicsWorld;
 		// Our bullet physics configuration
@@ -182,9 +288,33 @@ namespace Gameplay {
 
 		// Stores all the objects in our scene
 		std::vector<GameObject::Sptr>  Objects;
+		// Stores the transforms for all the objects in our scene
+		TransformStore::Sptr           _transforms;
+		// Maps object names to the first object created with that name
+		std::unordered_map<std::string, GameObject::Sptr> _nameIndex;
 		glm::vec3 _ambientLight;
 
+		// Shared uniform blocks for the camera and lighting, these are bound to every shader
+		// so lights only need to be uploaded when they change
+		UniformBuffer::Sptr        _frameUniforms;
+		UniformBuffer::Sptr        _lightUniforms;
+		LightUniforms              _lightData;
+		// Splits the lights into clusters so fragments only shade the lights in range
+		LightGrid::Sptr            _lightGrid;
+
 		bool                       _isAwake;
+		bool                       _isActive;
+
+		/// <summary>
+		/// Adds an object to the scene's object list and name index
+		/// </summary>
+		/// <param name="object">The object to add</param>
+		void _AddObject(const GameObject::Sptr& object);
+
+		/// <summary>
+		/// Uploads the light block, and re-assigns the lights to clusters
+		/// </summary>
+		void _UploadLights();
 
 		/// <summary>
 		/// Handles configuring our bullet physics stuff
@@ -195,4 +325,41 @@ namespace Gameplay {
 		/// </summary>
 		void _CleanupPhysics();
 	};
-}
\ No newline at end of file
+
+	/// <summary>
+	/// Caches the result of looking up an object by name, so that gameplay code
+	/// can resolve an object once and hold on to it. The handle will re-resolve
+	/// itself if the scene it was resolved against has changed (ex: after loading
+	/// a new scene), or if the object has been removed from the scene
+	/// </summary>
+	class ObjectHandle {
+	public:
+		ObjectHandle();
+		/// <summary>
+		/// Creates a new handle that will resolve to the object with the given name
+		/// </summary>
+		/// <param name="name">The name of the object to look up</param>
+		explicit ObjectHandle(const std::string& name);
+
+		/// <summary>
+		/// Gets the object this handle refers to in the given scene, or nullptr if
+		/// the scene does not have an object with this handle's name
+		/// </summary>
+		/// <param name="scene">The scene to resolve the object in</param>
+		GameObject::Sptr Get(const Scene::Sptr& scene);
+
+		/// <summary>
+		/// Forgets the cached object, the next call to Get will perform a new lookup
+		/// </summary>
+		void Reset();
+
+		/// <summary>
+		/// Gets the name of the object that this handle refers to
+		/// </summary>
+		const std::string& GetName() const { return _name; }
+
+	protected:
+		std::string                _name;
+		std::weak_ptr<GameObject>  _object;
+	};
+}
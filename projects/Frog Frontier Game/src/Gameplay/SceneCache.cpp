@@ -0,0 +1,118 @@
+#include "Gameplay/SceneCache.h"
+
+#include <GLFW/glfw3.h>
+#include <Logging.h>
+
+namespace Gameplay {
+	SceneCache::SceneCache(size_t memoryBudget, size_t maxScenes) :
+		_memoryBudget(memoryBudget),
+		_memoryUsage(0),
+		_maxScenes(maxScenes),
+		_lru(std::list<std::string>()),
+		_entries(std::unordered_map<std::string, Entry>()),
+		_active(std::weak_ptr<Scene>())
+	{ }
+
+	Scene::Sptr SceneCache::Activate(const std::string& path, GLFWwindow* window) {
+		// Hang on to the current scene, so we can switch back to it if the new one fails to load
+		Scene::Sptr previous = _active.lock();
+
+		auto it = _entries.find(path);
+		if (it != _entries.end()) {
+			Entry& entry = it->second;
+			_SetActive(entry.Instance);
+
+			// Reset the scene to how it was when it was first loaded. This only fails if objects
+			// were removed from the scene, in which case we just load it again
+			if (entry.Instance->RestoreSnapshot(entry.Initial)) {
+				_lru.splice(_lru.begin(), _lru, entry.LruPosition);
+
+				// The window may have been resized since we last used this scene
+				int width, height;
+				glfwGetWindowSize(window, &width, &height);
+				entry.Instance->Window = window;
+				if (width * height > 0) {
+					entry.Instance->MainCamera->ResizeWindow(width, height);
+				}
+
+				LOG_INFO("Using cached scene \"{}\"", path);
+				return entry.Instance;
+			}
+			Remove(path);
+		}
+
+		// Make sure the old scene's components are out of the pools before we load, so that
+		// the new scene can't pick up the old one's camera
+		_SetActive(nullptr);
+
+		Scene::Sptr scene = Scene::Load(path);
+		if (scene == nullptr) {
+			_SetActive(previous);
+			return nullptr;
+		}
+		_active = scene;
+		scene->Window = window;
+		scene->Awake();
+
+		Entry entry;
+		entry.Instance = scene;
+		entry.Initial = scene->TakeSnapshot();
+		entry.EstimatedSize = _EstimateSize(scene, entry.Initial);
+		_lru.push_front(path);
+		entry.LruPosition = _lru.begin();
+		_entries[path] = entry;
+		_memoryUsage += entry.EstimatedSize;
+
+		_Evict();
+		return scene;
+	}
+
+	void SceneCache::Remove(const std::string& path) {
+		auto it = _entries.find(path);
+		if (it != _entries.end()) {
+			_memoryUsage -= it->second.EstimatedSize;
+			_lru.erase(it->second.LruPosition);
+			_entries.erase(it);
+		}
+	}
+
+	void SceneCache::Clear() {
+		_entries.clear();
+		_lru.clear();
+		_memoryUsage = 0;
+	}
+
+	void SceneCache::SetMemoryBudget(size_t bytes) {
+		_memoryBudget = bytes;
+		_Evict();
+	}
+
+	void SceneCache::SetMaxScenes(size_t count) {
+		_maxScenes = count;
+		_Evict();
+	}
+
+	void SceneCache::_SetActive(const Scene::Sptr& scene) {
+		Scene::Sptr previous = _active.lock();
+		if (previous != nullptr && previous != scene) {
+			previous->SetActive(false);
+		}
+		if (scene != nullptr) {
+			scene->SetActive(true);
+		}
+		_active = scene;
+	}
+
+	void SceneCache::_Evict() {
+		// Always keep the most recent scene, since it's the one being used
+		while ((_memoryUsage > _memoryBudget || _lru.size() > _maxScenes) && _lru.size() > 1) {
+			std::string path = _lru.back();
+			LOG_INFO("Releasing cached scene \"{}\"", path);
+			Remove(path);
+		}
+	}
+
+	size_t SceneCache::_EstimateSize(const Scene::Sptr& scene, const SceneSnapshot::Sptr& snapshot) {
+		return scene->EstimateMemoryUsage() + snapshot->GetSize();
+	}
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <memory>
+
+#include "Gameplay/Scene.h"
+
+struct GLFWwindow;
+
+namespace Gameplay {
+	/// <summary>
+	/// Keeps recently used scenes loaded, so that switching between them (ex: going back to
+	/// the main menu) does not need to re-create all their objects and physics bodies
+	///
+	/// A snapshot of each scene is taken right after it is first loaded and awoken, and the
+	/// scene is restored to it when it is activated again, so cached scenes always start out
+	/// the same as a freshly loaded one. Only the active scene's components are kept in the
+	/// component pools, the rest are detached until they are activated again (see Scene::SetActive). When the estimated memory used by the cached scenes
+	/// goes over the budget, or there are more than the maximum number of scenes, the least
+	/// recently used scenes are released
+	/// </summary>
+	class SceneCache {
+	public:
+		typedef std::shared_ptr<SceneCache> Sptr;
+
+		// The default memory budget, in bytes
+		static constexpr size_t DEFAULT_MEMORY_BUDGET = 64 * 1024 * 1024;
+		// The default number of scenes to keep loaded, each scene has it's own physics world
+		static constexpr size_t DEFAULT_MAX_SCENES = 4;
+
+		SceneCache(size_t memoryBudget = DEFAULT_MEMORY_BUDGET, size_t maxScenes = DEFAULT_MAX_SCENES);
+		~SceneCache() = default;
+
+		SceneCache(const SceneCache& other) = delete;
+		SceneCache(SceneCache&& other) = delete;
+		SceneCache& operator=(const SceneCache& other) = delete;
+		SceneCache& operator=(SceneCache&& other) = delete;
+
+		/// <summary>
+		/// Gets the scene for the given file, ready to be used as the active scene. If the scene
+		/// is cached it will be reset to it's initial state, otherwise it will be loaded and
+		/// awoken. The previously activated scene is deactivated. Note that the returned scene is
+		/// always awake. If the scene could not be loaded, the previous scene stays active
+		/// </summary>
+		/// <param name="path">The path of the scene file</param>
+		/// <param name="window">The window that the scene will be drawn to</param>
+		/// <returns>The scene to make active, or nullptr if it failed to load</returns>
+		Scene::Sptr Activate(const std::string& path, GLFWwindow* window);
+
+		/// <summary>
+		/// Removes the scene for the given file from the cache, so that it is re-loaded the
+		/// next time it is activated. Should be called when the file changes
+		/// </summary>
+		/// <param name="path">The path of the scene file</param>
+		void Remove(const std::string& path);
+		/// <summary>
+		/// Removes all scenes from the cache
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Sets the memory budget for the cache in bytes, evicting scenes if needed. The most
+		/// recently activated scene is never evicted
+		/// </summary>
+		void SetMemoryBudget(size_t bytes);
+		size_t GetMemoryBudget() const { return _memoryBudget; }
+		/// <summary>
+		/// Sets the most scenes that the cache will keep loaded, evicting scenes if needed. The
+		/// most recently activated scene is never evicted
+		/// </summary>
+		void SetMaxScenes(size_t count);
+		size_t GetMaxScenes() const { return _maxScenes; }
+		/// <summary>
+		/// Gets the estimated memory used by all the cached scenes, in bytes
+		/// </summary>
+		size_t GetMemoryUsage() const { return _memoryUsage; }
+
+	protected:
+		struct Entry {
+			Scene::Sptr         Instance;
+			// The state of the scene right after it was loaded
+			SceneSnapshot::Sptr Initial;
+			size_t              EstimatedSize;
+			// Our position in the LRU list
+			std::list<std::string>::iterator LruPosition;
+		};
+
+		size_t _memoryBudget;
+		size_t _memoryUsage;
+		size_t _maxScenes;
+		// Paths of the cached scenes, most recently used first
+		std::list<std::string> _lru;
+		std::unordered_map<std::string, Entry> _entries;
+		// The scene that was last activated, this may have since been removed from the cache
+		std::weak_ptr<Scene> _active;
+
+		/// <summary>
+		/// Deactivates the last activated scene if it is not the given scene, and activates the given scene
+		/// </summary>
+		void _SetActive(const Scene::Sptr& scene);
+
+		/// <summary>
+		/// Releases the least recently used scenes until we are under budget and the scene limit
+		/// </summary>
+		void _Evict();
+		/// <summary>
+		/// Makes a rough guess at how much memory a cached scene uses, in bytes
+		/// </summary>
+		static size_t _EstimateSize(const Scene::Sptr& scene, const SceneSnapshot::Sptr& snapshot);
+	};
+}
@@ -0,0 +1,8 @@
+#include "SceneSnapshot.h"
+
+namespace Gameplay {
+	SceneSnapshot::SceneSnapshot() :
+		_data(std::vector<uint8_t>()),
+		_readOffset(0)
+	{ }
+}
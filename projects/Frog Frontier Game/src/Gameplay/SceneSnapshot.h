@@ -0,0 +1,95 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include <Logging.h>
+#include "Utils/GUID.hpp"
+#include "Utils/ResourceManager/ResourceManager.h"
+
+namespace Gameplay {
+	/// <summary>
+	/// A flat binary buffer holding the state of a scene at a point in time, so that it can
+	/// be restored in place without re-creating any game objects, components or physics
+	/// bodies (see Scene::TakeSnapshot and Scene::RestoreSnapshot)
+	///
+	/// Values are written and read back in the same order, so components must read exactly
+	/// what they wrote. Snapshots only live in memory, and are not meant to be saved
+	/// </summary>
+	class SceneSnapshot {
+	public:
+		typedef std::shared_ptr<SceneSnapshot> Sptr;
+
+		SceneSnapshot();
+		~SceneSnapshot() = default;
+
+		SceneSnapshot(const SceneSnapshot& other) = delete;
+		SceneSnapshot(SceneSnapshot&& other) = delete;
+		SceneSnapshot& operator=(const SceneSnapshot& other) = delete;
+		SceneSnapshot& operator=(SceneSnapshot&& other) = delete;
+
+		/// <summary>
+		/// Appends a value to the end of the snapshot
+		/// </summary>
+		template <typename T>
+		void Write(const T& value) {
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written to a snapshot!");
+			const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+			_data.insert(_data.end(), bytes, bytes + sizeof(T));
+		}
+
+		/// <summary>
+		/// Reads the next value from the snapshot
+		/// </summary>
+		template <typename T>
+		void Read(T& value) {
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read from a snapshot!");
+			LOG_ASSERT(_readOffset + sizeof(T) <= _data.size(), "Read past the end of the snapshot!");
+			memcpy(&value, _data.data() + _readOffset, sizeof(T));
+			_readOffset += sizeof(T);
+		}
+
+		/// <summary>
+		/// Writes a reference to a resource, as it's GUID
+		/// </summary>
+		void WriteResource(const std::shared_ptr<IResource>& resource) {
+			Write(resource != nullptr ? resource->GetGUID() : Guid());
+		}
+
+		/// <summary>
+		/// Reads a reference to a resource written with WriteResource. If the resource is
+		/// the same as the current value it is kept, otherwise it is looked up in the
+		/// ResourceManager
+		/// </summary>
+		/// <param name="current">The value currently stored in the component</param>
+		template <typename T>
+		std::shared_ptr<T> ReadResource(const std::shared_ptr<T>& current) {
+			Guid id;
+			Read(id);
+			if (!id.isValid()) {
+				return nullptr;
+			}
+			if (current != nullptr && current->IResource::GetGUID() == id) {
+				return current;
+			}
+			return ResourceManager::Get<T>(id);
+		}
+
+		/// <summary>
+		/// Gets the size of the snapshot, in bytes
+		/// </summary>
+		size_t GetSize() const { return _data.size(); }
+
+	protected:
+		friend class Scene;
+
+		std::vector<uint8_t> _data;
+		size_t               _readOffset;
+
+		// Moves the read position to the given offset, used by the scene to skip over data
+		void _Seek(size_t offset) { _readOffset = offset; }
+		size_t _Tell() const { return _readOffset; }
+	};
+}
@@ -0,0 +1,149 @@
+#include "TransformStore.h"
+#include <algorithm>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Gameplay {
+	// Gets the index of the lowest set bit in a non-zero word
+	static inline uint32_t LowestSetBit(uint64_t word) {
+		#ifdef _MSC_VER
+		unsigned long result;
+		_BitScanForward64(&result, word);
+		return result;
+		#else
+		return __builtin_ctzll(word);
+		#endif
+	}
+
+	TransformStore::TransformStore() :
+		_positions(std::vector<glm::vec3>()),
+		_rotations(std::vector<glm::quat>()),
+		_scales(std::vector<glm::vec3>()),
+		_worldMatrices(std::vector<glm::mat4>()),
+		_normalMatrices(std::vector<glm::mat3>()),
+		_dirty(std::vector<uint64_t>()),
+		_freeList(std::vector<Index>()),
+		_dirtyCount(0),
+		_dirtyBegin(~0u),
+		_dirtyEnd(0)
+	{ }
+
+	TransformStore::Index TransformStore::Allocate() {
+		Index result;
+		if (_freeList.empty()) {
+			result = static_cast<Index>(_positions.size());
+			_positions.emplace_back();
+			_rotations.emplace_back();
+			_scales.emplace_back();
+			_worldMatrices.emplace_back();
+			_normalMatrices.emplace_back();
+			// Add another word of dirty bits when we cross into a new block of 64
+			if ((result >> 6) >= _dirty.size()) {
+				_dirty.push_back(0);
+			}
+		} else {
+			result = _freeList.back();
+			_freeList.pop_back();
+		}
+
+		_positions[result] = glm::vec3(0.0f);
+		_rotations[result] = glm::quat(glm::vec3(0.0f));
+		_scales[result] = glm::vec3(1.0f);
+		_worldMatrices[result] = glm::mat4(1.0f);
+		_normalMatrices[result] = glm::mat3(1.0f);
+		MarkDirty(result);
+		return result;
+	}
+
+	void TransformStore::Free(Index index) {
+		// Clear the dirty bit so the batch update skips this slot until it's re-used
+		_ClearDirty(index);
+		_freeList.push_back(index);
+	}
+
+	const glm::mat4& TransformStore::GetWorldMatrix(Index index) {
+		if (IsDirty(index)) {
+			_UpdateWorldMatrix(index);
+		}
+		return _worldMatrices[index];
+	}
+
+	const glm::mat3& TransformStore::GetNormalMatrix(Index index) {
+		if (IsDirty(index)) {
+			_UpdateWorldMatrix(index);
+		}
+		return _normalMatrices[index];
+	}
+
+	void TransformStore::UpdateWorldMatrices() {
+		if (_dirtyCount > 0) {
+			const size_t firstBlock = _dirtyBegin >> 6;
+			const size_t lastBlock = (_dirtyEnd - 1) >> 6;
+
+			// If at least half the range is dirty, it's cheaper to recalculate every transform in
+			// it than to find each dirty bit. Recalculating a clean (or freed) transform is harmless
+			if (_dirtyCount * 2 >= _dirtyEnd - _dirtyBegin) {
+				for (Index index = _dirtyBegin; index < _dirtyEnd; index++) {
+					_CalculateWorldMatrix(index);
+				}
+			} else {
+				for (size_t block = firstBlock; block <= lastBlock; block++) {
+					uint64_t word = _dirty[block];
+					// Visit each set bit in the word, skipping clean blocks entirely
+					while (word != 0) {
+						_CalculateWorldMatrix(static_cast<Index>((block << 6) + LowestSetBit(word)));
+						word &= word - 1;
+					}
+				}
+			}
+
+			// Every dirty bit is inside the range, so we can clear whole words at once
+			std::fill(_dirty.begin() + firstBlock, _dirty.begin() + lastBlock + 1, 0ull);
+		}
+
+		_dirtyCount = 0;
+		_dirtyBegin = ~0u;
+		_dirtyEnd = 0;
+	}
+
+	void TransformStore::_UpdateWorldMatrix(Index index) {
+		_CalculateWorldMatrix(index);
+		_ClearDirty(index);
+	}
+
+	void TransformStore::_ClearDirty(Index index) {
+		uint64_t& word = _dirty[index >> 6];
+		const uint64_t bit = 1ull << (index & 63);
+		if ((word & bit) != 0) {
+			word &= ~bit;
+			_dirtyCount--;
+		}
+	}
+
+	void TransformStore::_CalculateWorldMatrix(Index index) {
+		// This is translate * rotate * scale, but we build it directly rather than multiplying
+		// out 3 full matrices. The scale just scales the columns of the rotation matrix
+		const glm::mat3 rotation = glm::mat3_cast(_rotations[index]);
+		const glm::vec3& scale = _scales[index];
+
+		glm::mat4& result = _worldMatrices[index];
+		result[0] = glm::vec4(rotation[0] * scale.x, 0.0f);
+		result[1] = glm::vec4(rotation[1] * scale.y, 0.0f);
+		result[2] = glm::vec4(rotation[2] * scale.z, 0.0f);
+		result[3] = glm::vec4(_positions[index], 1.0f);
+
+		// The upper 3x3 is R * S, so it's inverse transpose is R * S^-1 (the rotation is
+		// orthonormal), meaning we never need a full inverse. For uniform scales we can skip
+		// the per-axis divide as well
+		glm::mat3& normal = _normalMatrices[index];
+		if (scale.x == scale.y && scale.y == scale.z) {
+			normal = rotation * (1.0f / scale.x);
+		} else {
+			normal[0] = rotation[0] / scale.x;
+			normal[1] = rotation[1] / scale.y;
+			normal[2] = rotation[2] / scale.z;
+		}
+	}
+}
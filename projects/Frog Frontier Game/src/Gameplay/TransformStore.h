@@ -0,0 +1,130 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+// GLM
+#define GLM_ENABLE_EXPERIMENTAL
+#include "GLM/glm.hpp"
+#include "GLM/gtc/quaternion.hpp"
+
+namespace Gameplay {
+	/// <summary>
+	/// Stores the transforms for all the game objects in a scene as a structure of arrays,
+	/// so positions, rotations, scales and world matrices are each packed together in memory.
+	///
+	/// Game objects hold an index into the store, and flag their transform as dirty when
+	/// it changes. UpdateWorldMatrices will then recompute all dirty world matrices in a
+	/// single pass, which the scene should do once per frame before rendering
+	/// </summary>
+	class TransformStore {
+	public:
+		typedef std::shared_ptr<TransformStore> Sptr;
+		typedef uint32_t Index;
+
+		TransformStore();
+		~TransformStore() = default;
+
+		TransformStore(const TransformStore& other) = delete;
+		TransformStore(TransformStore&& other) = delete;
+		TransformStore& operator=(const TransformStore& other) = delete;
+		TransformStore& operator=(TransformStore&& other) = delete;
+
+		/// <summary>
+		/// Allocates a new identity transform in the store, and returns it's index
+		/// </summary>
+		Index Allocate();
+		/// <summary>
+		/// Frees a transform so that it's index can be re-used
+		/// </summary>
+		/// <param name="index">The index of the transform to free</param>
+		void Free(Index index);
+
+		/// <summary>
+		/// Gets the position for the transform at the given index. If you modify the
+		/// value, make sure to call MarkDirty
+		/// </summary>
+		glm::vec3& GetPosition(Index index) { return _positions[index]; }
+		const glm::vec3& GetPosition(Index index) const { return _positions[index]; }
+		/// <summary>
+		/// Gets the rotation for the transform at the given index. If you modify the
+		/// value, make sure to call MarkDirty
+		/// </summary>
+		glm::quat& GetRotation(Index index) { return _rotations[index]; }
+		const glm::quat& GetRotation(Index index) const { return _rotations[index]; }
+		/// <summary>
+		/// Gets the scale for the transform at the given index. If you modify the
+		/// value, make sure to call MarkDirty
+		/// </summary>
+		glm::vec3& GetScale(Index index) { return _scales[index]; }
+		const glm::vec3& GetScale(Index index) const { return _scales[index]; }
+
+		/// <summary>
+		/// Flags the world matrix for the given transform as needing to be recalculated
+		/// </summary>
+		void MarkDirty(Index index) {
+			uint64_t& word = _dirty[index >> 6];
+			const uint64_t bit = 1ull << (index & 63);
+			if ((word & bit) == 0) {
+				word |= bit;
+				_dirtyCount++;
+				_dirtyBegin = index < _dirtyBegin ? index : _dirtyBegin;
+				_dirtyEnd = index >= _dirtyEnd ? index + 1 : _dirtyEnd;
+			}
+		}
+		/// <summary>
+		/// Returns true if the world matrix for the given transform is out of date
+		/// </summary>
+		bool IsDirty(Index index) const { return (_dirty[index >> 6] >> (index & 63)) & 1ull; }
+
+		/// <summary>
+		/// Gets the world matrix for the given transform, recalculating it if it is dirty
+		/// </summary>
+		const glm::mat4& GetWorldMatrix(Index index);
+		/// <summary>
+		/// Gets the normal matrix (inverse transpose of the world rotation and scale) for the
+		/// given transform, recalculating it if it is dirty
+		/// </summary>
+		const glm::mat3& GetNormalMatrix(Index index);
+
+		/// <summary>
+		/// Recalculates the world and normal matrices for all dirty transforms in the store. When
+		/// most of the dirty range is dirty, the whole range is recalculated in one straight loop
+		/// rather than scanning for each dirty bit
+		/// </summary>
+		void UpdateWorldMatrices();
+
+		/// <summary>
+		/// Gets the number of transform slots in the store, including ones that have been freed
+		/// </summary>
+		size_t Size() const { return _positions.size(); }
+
+	protected:
+		std::vector<glm::vec3> _positions;
+		std::vector<glm::quat> _rotations;
+		std::vector<glm::vec3> _scales;
+		std::vector<glm::mat4> _worldMatrices;
+		std::vector<glm::mat3> _normalMatrices;
+		// One bit per transform, packed into 64 bit words so we can skip clean blocks quickly
+		std::vector<uint64_t>  _dirty;
+		// Indices that have been freed and can be handed out again
+		std::vector<Index>     _freeList;
+		// The number of dirty bits that are set, and the range of indices [begin, end) that contains them
+		size_t                 _dirtyCount;
+		Index                  _dirtyBegin;
+		Index                  _dirtyEnd;
+
+		/// <summary>
+		/// Calculates the world and normal matrix for a single transform, without touching it's dirty bit
+		/// </summary>
+		void _CalculateWorldMatrix(Index index);
+		/// <summary>
+		/// Calculates the world and normal matrix for a single transform and clears it's dirty bit
+		/// </summary>
+		void _UpdateWorldMatrix(Index index);
+		/// <summary>
+		/// Clears the dirty bit for a single transform, if it is set
+		/// </summary>
+		void _ClearDirty(Index index);
+	};
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "GLM/glm.hpp"
+
+namespace Gameplay {
+	// The binding slots for our shared uniform blocks, these need to match the
+	// layout(binding = N) of the blocks in our shaders
+	static constexpr int FRAME_UNIFORM_BINDING = 0;
+	static constexpr int LIGHT_UNIFORM_BINDING = 1;
+	// Shader storage blocks have their own set of binding slots
+	static constexpr int LIGHT_CLUSTER_BINDING = 0;
+
+	// Must match MAX_LIGHTS in our shaders. Lights are culled per cluster, so this only
+	// limits the size of the light block (256 * 32 bytes fits in the 16KB minimum)
+	static constexpr int MAX_UNIFORM_LIGHTS = 256;
+	// Must match LIGHT_CLUSTERS in our shaders
+	static constexpr int LIGHT_CLUSTER_COUNT = 64;
+
+	/// <summary>
+	/// Per-frame camera data, matches b_FrameData in our shaders (std140)
+	/// </summary>
+	struct FrameUniforms {
+		glm::mat4 ViewProjection;
+		glm::vec3 CameraPos;
+		float     _padding0;
+	};
+
+	/// <summary>
+	/// A single light, matches the Light struct in our shaders (std140). Structs in
+	/// arrays are rounded up to 16 bytes, so the attenuation is packed in after the
+	/// position
+	/// </summary>
+	struct LightUniform {
+		glm::vec3 Position;
+		float     Attenuation;
+		glm::vec3 Color;
+		float     _padding0;
+	};
+
+	/// <summary>
+	/// All of the lighting data for a scene, matches b_LightData in our shaders (std140)
+	/// </summary>
+	struct LightUniforms {
+		LightUniform Lights[MAX_UNIFORM_LIGHTS];
+		glm::vec3    AmbientCol;
+		int          NumLights;
+	};
+
+	/// <summary>
+	/// The fixed size part of b_LightClusters in our shaders (std430). The world is split
+	/// into equal slices along the X axis, and each cluster stores the offset and count
+	/// of it's lights in the light index list that follows this header
+	/// </summary>
+	struct LightClusterHeader {
+		float      MinX;
+		float      InvClusterSize;
+		int        ClusterCount;
+		int        _padding0;
+		glm::uvec2 Clusters[LIGHT_CLUSTER_COUNT];
+	};
+}
@@ -25,10 +25,22 @@ void IBuffer::LoadData(const void* data, size_t elementSize, size_t elementCount
 	_elementSize = elementSize;
 }
 
+void IBuffer::Update(const void* data, size_t size) {
+	if (GetTotalSize() != size) {
+		LoadData(data, size, 1);
+	} else {
+		glNamedBufferSubData(_handle, 0, size, data);
+	}
+}
+
 void IBuffer::Bind() const {
 	glBindBuffer((GLenum)_type, _handle);
 }
 
+void IBuffer::Bind(int slot) const {
+	glBindBufferBase((GLenum)_type, slot, _handle);
+}
+
 void IBuffer::UnBind(BufferType type) {
 	glBindBuffer((GLenum)type, 0);
 }
@@ -8,7 +8,8 @@
 enum class BufferType {
 	Vertex = GL_ARRAY_BUFFER,
 	Index = GL_ELEMENT_ARRAY_BUFFER,
-	Uniform = GL_UNIFORM_BUFFER
+	Uniform = GL_UNIFORM_BUFFER,
+	ShaderStorage = GL_SHADER_STORAGE_BUFFER
 };
 
 /// <summary>
@@ -74,6 +75,14 @@ public:
 		IBuffer::LoadData((const void*)(data), sizeof(T), count);
 	}
 
+	/// <summary>
+	/// Updates the contents of the buffer. The storage is only re-allocated if the size
+	/// has changed, otherwise the data is copied into the existing storage
+	/// </summary>
+	/// <param name="data">The data to upload</param>
+	/// <param name="size">The size of the data, in bytes</param>
+	void Update(const void* data, size_t size);
+
 	/// <summary>
 	/// Returns the number of elements that are loaded into this buffer
 	/// </summary>
@@ -104,6 +113,12 @@ public:
 	/// </summary>
 	virtual void Bind() const;
 	/// <summary>
+	/// Binds this buffer to an indexed binding slot for the type returned by GetType(). Only
+	/// valid for indexed buffer types, such as uniform and shader storage buffers
+	/// </summary>
+	/// <param name="slot">The binding slot, should match the binding of the block in GLSL</param>
+	void Bind(int slot) const;
+	/// <summary>
 	/// Unbinds the buffer bound to the slot given by type
 	/// </summary>
 	/// <param name="type">The type or slot of buffer to unbind (ex: GL_ARRAY_BUFFER, GL_ARRAY_ELEMENT_BUFFER)</param>
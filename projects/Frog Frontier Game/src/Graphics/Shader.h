@@ -25,6 +25,7 @@ class Shader final : public IResource
 {
 public:
 	typedef std::shared_ptr<Shader> Sptr;
+	MAKE_STATIC_TYPENAME(Shader)
 
 	static inline Sptr Create() {
 		return std::make_shared<Shader>();
@@ -101,6 +102,13 @@ public:
 	void SetUniform(int location, const glm::bvec3* value, int count = 1);
 	void SetUniform(int location, const glm::bvec4* value, int count = 1);
 
+	/// <summary>
+	/// Gets the location of a uniform in this shader, or -1 if the shader does not use it.
+	/// Locations are cached, so this is cheap to call every frame
+	/// </summary>
+	/// <param name="name">The name of the uniform to look up</param>
+	int GetUniformLocation(const std::string& name) { return __GetUniformLocation(name); }
+
 	template <typename T>
 	void SetUniform(const std::string& name, const T& value) {
 		int location = __GetUniformLocation(name);
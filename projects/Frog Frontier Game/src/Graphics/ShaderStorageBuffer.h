@@ -0,0 +1,29 @@
+#pragma once
+#include "IBuffer.h"
+#include <memory>
+
+/// <summary>
+/// The shader storage buffer stores large or variable sized blocks of data that shaders
+/// can read from (and write to). The contents should be laid out following the std430
+/// rules, and bound to the same slot as the block's binding in GLSL
+/// </summary>
+class ShaderStorageBuffer : public IBuffer
+{
+public:
+	typedef std::shared_ptr<ShaderStorageBuffer> Sptr;
+
+	static inline Sptr Create(BufferUsage usage = BufferUsage::DynamicDraw) {
+		return std::make_shared<ShaderStorageBuffer>(usage);
+	}
+
+	/// <summary>
+	/// Creates a new shader storage buffer, with the given usage. Data will still need to be uploaded before it can be used
+	/// </summary>
+	/// <param name="usage">The usage hint for the buffer, default is GL_DYNAMIC_DRAW</param>
+	ShaderStorageBuffer(BufferUsage usage = BufferUsage::DynamicDraw) : IBuffer(BufferType::ShaderStorage, usage) { }
+
+	/// <summary>
+	/// Unbinds the shader storage buffer bound to the given slot
+	/// </summary>
+	static void UnBind(int slot) { IBuffer::UnBind(BufferType::ShaderStorage, slot); }
+};
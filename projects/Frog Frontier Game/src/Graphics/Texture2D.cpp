@@ -1,5 +1,7 @@
 #include "Texture2D.h"
 #include <stb_image.h>
+#include <cstring>
+#include <vector>
 #include <Logging.h>
 #include "GLM/glm.hpp"
 #include "Utils/JsonGlmHelpers.h"
@@ -12,13 +14,29 @@ nlohmann::json Texture2D::ToJson() const {
 	};
 }
 
-Texture2D::Sptr Texture2D::FromJson(const nlohmann::json& data)
-{
+// Reads the description for a texture from it's JSON manifest entry
+static Texture2DDescription DescriptionFromJson(const nlohmann::json& data) {
 	Texture2DDescription descr = Texture2DDescription();
 	descr.Filename = data["filename"];
 	descr.HorizontalWrap = JsonParseEnum(WrapMode, data, "wrap_s", WrapMode::ClampToEdge);
 	descr.VerticalWrap   = JsonParseEnum(WrapMode, data, "wrap_t", WrapMode::ClampToEdge);
-	return std::make_shared<Texture2D>(descr);
+	return descr;
+}
+
+Texture2D::Sptr Texture2D::FromJson(const nlohmann::json& data)
+{
+	return std::make_shared<Texture2D>(DescriptionFromJson(data));
+}
+
+ResourceFinalizer Texture2D::PrepareFromJson(const nlohmann::json& data)
+{
+	Texture2DDescription descr = DescriptionFromJson(data);
+	DecodedImage image;
+	if (!DecodeImage(descr.Filename, descr.FormatHint, image)) {
+		// Let the main thread create the empty texture like it normally would
+		return [descr]() { return std::make_shared<Texture2D>(descr); };
+	}
+	return [descr, image]() { return std::make_shared<Texture2D>(descr, image); };
 }
 
 Texture2D::Texture2D(const Texture2DDescription& description) : ITexture(TextureType::_2D) {
@@ -27,6 +45,13 @@ Texture2D::Texture2D(const Texture2DDescription& description) : ITexture(Texture
 	_LoadDataFromFile();
 }
 
+Texture2D::Texture2D(const Texture2DDescription& description, const DecodedImage& image) : ITexture(TextureType::_2D) {
+	_description = description;
+	_SetTextureParams();
+	LOG_ASSERT(_description.Width + _description.Height == 0, "This texture has already been configured with a size! Cannot re-allocate memory!");
+	_UploadImage(image);
+}
+
 Texture2D::Texture2D(const std::string& filePath) : ITexture(TextureType::_2D) {
 	_description.Filename = filePath;
 	_SetTextureParams();
@@ -48,75 +73,97 @@ void Texture2D::LoadData(uint32_t width, uint32_t height, PixelFormat format, Pi
 }
 
 void Texture2D::_LoadDataFromFile() {
-	LOG_ASSERT(_description.Width + _description.Height == 0, "This texture has already been configured with a size! Cannot re-allocate memory!");
-
+	// Textures created with a size and no file (ex: render targets, lookup tables) are already allocated
 	if (!_description.Filename.empty()) {
-		// Variables that will store properties about our image
-		int width, height, numChannels;
-		const int targetChannels = GetTexelComponentCount(_description.FormatHint);
-
-		// Use STBI to load the image
-		stbi_set_flip_vertically_on_load(true);
-		uint8_t* data = stbi_load(_description.Filename.c_str(), &width, &height, &numChannels, targetChannels);
-
-		// If we could not load any data, warn and return null
-		if (data == nullptr) {
-			LOG_WARN("STBI Failed to load image from \"{}\"", _description.Filename);
-			return ;
-		}
+		LOG_ASSERT(_description.Width + _description.Height == 0, "This texture has already been configured with a size! Cannot re-allocate memory!");
 
-		// We should estimate a good format for our data
-
-		// numChannels will store the number of channels in the image on disk, if we overrode that we should use the override value
-		if (targetChannels != 0)
-			numChannels = targetChannels;
-
-		// We'll determine a recommended format for the image based on number of channels
-		// We hinted that we wanted a certain number of channels, but we're not guaranteed
-		// that all those channels exist (ex: loading an RGB image but requesting RGBA)
-		InternalFormat internal_format;
-		PixelFormat    image_format;
-		switch (numChannels) {
-			case 1:
-				internal_format = InternalFormat::R8;
-				image_format = PixelFormat::Red;
-				break;
-			case 2:
-				internal_format = InternalFormat::RG8;
-				image_format = PixelFormat::RG;
-				break;
-			case 3:
-				internal_format = InternalFormat::RGB8;
-				image_format = PixelFormat::RGB;
-				break;
-			case 4:
-				internal_format = InternalFormat::RGBA8;
-				image_format = PixelFormat::RGBA;
-				break;
-			default:
-				LOG_ASSERT(false, "Unsupported texture format for texture \"{}\" with {} channels", _description.Filename, numChannels)
-					break;
+		DecodedImage image;
+		if (DecodeImage(_description.Filename, _description.FormatHint, image)) {
+			_UploadImage(image);
 		}
+	}
+}
 
-		// This is one of those poorly documented things in OpenGL
-		if ((numChannels * width) % 4 != 0) {
-			LOG_WARN("The alignment of a horizontal line is not a multiple of 4, this will require a call to glPixelStorei(GL_PACK_ALIGNMENT)");
-		}
+bool Texture2D::DecodeImage(const std::string& filename, PixelFormat formatHint, DecodedImage& result) {
+	// Variables that will store properties about our image
+	int width, height, numChannels;
+	const int targetChannels = GetTexelComponentCount(formatHint);
+
+	// Use STBI to load the image. Note that we flip the image ourselves rather than using
+	// stbi_set_flip_vertically_on_load, since that is global state shared by all threads
+	uint8_t* data = stbi_load(filename.c_str(), &width, &height, &numChannels, targetChannels);
+
+	// If we could not load any data, warn and return null
+	if (data == nullptr) {
+		LOG_WARN("STBI Failed to load image from \"{}\"", filename);
+		return false;
+	}
 
-		// Update our description to match what we loaded
-		_description.Format = internal_format;
-		_description.Width = width;
-		_description.Height = height;
+	// numChannels will store the number of channels in the image on disk, if we overrode that we should use the override value
+	if (targetChannels != 0)
+		numChannels = targetChannels;
+
+	// Flip the rows so the first row in memory is the bottom of the image, like OpenGL expects
+	const size_t rowSize = (size_t)width * numChannels;
+	std::vector<uint8_t> rowBuffer(rowSize);
+	for (int row = 0; row < height / 2; row++) {
+		uint8_t* top = data + row * rowSize;
+		uint8_t* bottom = data + (height - 1 - row) * rowSize;
+		memcpy(rowBuffer.data(), top, rowSize);
+		memcpy(top, bottom, rowSize);
+		memcpy(bottom, rowBuffer.data(), rowSize);
+	}
 
-		// Allocates our memory
-		_SetTextureParams();
+	result.Pixels = std::shared_ptr<uint8_t>(data, stbi_image_free);
+	result.Width = width;
+	result.Height = height;
+	result.NumChannels = numChannels;
+	return true;
+}
 
-		// Upload data to our texture
-		LoadData(width, height, image_format, PixelType::UByte, data);
+void Texture2D::_UploadImage(const DecodedImage& image) {
+	// We'll determine a recommended format for the image based on number of channels
+	// We hinted that we wanted a certain number of channels, but we're not guaranteed
+	// that all those channels exist (ex: loading an RGB image but requesting RGBA)
+	InternalFormat internal_format;
+	PixelFormat    image_format;
+	switch (image.NumChannels) {
+		case 1:
+			internal_format = InternalFormat::R8;
+			image_format = PixelFormat::Red;
+			break;
+		case 2:
+			internal_format = InternalFormat::RG8;
+			image_format = PixelFormat::RG;
+			break;
+		case 3:
+			internal_format = InternalFormat::RGB8;
+			image_format = PixelFormat::RGB;
+			break;
+		case 4:
+			internal_format = InternalFormat::RGBA8;
+			image_format = PixelFormat::RGBA;
+			break;
+		default:
+			LOG_ASSERT(false, "Unsupported texture format for texture \"{}\" with {} channels", _description.Filename, image.NumChannels)
+				break;
+	}
 
-		// We now have data in the image, we can clear the STBI data
-		stbi_image_free(data);
+	// This is one of those poorly documented things in OpenGL
+	if ((image.NumChannels * image.Width) % 4 != 0) {
+		LOG_WARN("The alignment of a horizontal line is not a multiple of 4, this will require a call to glPixelStorei(GL_PACK_ALIGNMENT)");
 	}
+
+	// Update our description to match what we loaded
+	_description.Format = internal_format;
+	_description.Width = image.Width;
+	_description.Height = image.Height;
+
+	// Allocates our memory
+	_SetTextureParams();
+
+	// Upload data to our texture
+	LoadData(image.Width, image.Height, image_format, PixelType::UByte, image.Pixels.get());
 }
 
 void Texture2D::_SetTextureParams() {
@@ -51,6 +51,7 @@ struct Texture2DDescription {
 class Texture2D : public ITexture {
 public:
 	typedef std::shared_ptr<Texture2D> Sptr;
+	MAKE_STATIC_TYPENAME(Texture2D)
 
 	// Remove the copy and and assignment operators
 	Texture2D(const Texture2D& other) = delete;
@@ -106,12 +107,47 @@ public:
 	/// </summary>
 	const Texture2DDescription& GetDescription() const { return _description; }
 
+	/// <summary>
+	/// An image that has been decoded from a file, but not yet uploaded to OpenGL
+	/// </summary>
+	struct DecodedImage {
+		std::shared_ptr<uint8_t> Pixels;
+		int                      Width;
+		int                      Height;
+		int                      NumChannels;
+	};
+
+	/// <summary>
+	/// Decodes an image file into memory, flipped so the first row is the bottom of the
+	/// image. This does not touch OpenGL, so it can be called from worker threads
+	/// </summary>
+	/// <param name="filename">The path to the image to load</param>
+	/// <param name="formatHint">The format we would like the pixels in, determines the number of channels</param>
+	/// <param name="result">The image to store the decoded data in</param>
+	/// <returns>True if the image was loaded</returns>
+	static bool DecodeImage(const std::string& filename, PixelFormat formatHint, DecodedImage& result);
+
+	/// <summary>
+	/// Creates a texture from an image that has already been decoded
+	/// </summary>
+	Texture2D(const Texture2DDescription& description, const DecodedImage& image);
+
 	virtual nlohmann::json ToJson() const override;
 	static Texture2D::Sptr FromJson(const nlohmann::json& data);
+	/// <summary>
+	/// Decodes the texture's image on the calling thread, and returns a function to
+	/// create the texture on the main thread
+	/// </summary>
+	static ResourceFinalizer PrepareFromJson(const nlohmann::json& data);
 
 protected:
 	Texture2DDescription _description;
 
+	/// <summary>
+	/// Allocates the texture's memory and uploads a decoded image into it
+	/// </summary>
+	void _UploadImage(const DecodedImage& image);
+
 	/// <summary>
 	/// Loads this texture from the file specified in the description
 	/// Will overwrite description size
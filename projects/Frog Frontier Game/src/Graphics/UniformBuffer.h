@@ -0,0 +1,40 @@
+#pragma once
+#include "IBuffer.h"
+#include <memory>
+
+/// <summary>
+/// The uniform buffer stores a block of uniform data that can be shared between many
+/// shaders. The contents should be laid out following the std140 rules, and bound to
+/// the same slot as the block's binding in GLSL
+/// </summary>
+class UniformBuffer : public IBuffer
+{
+public:
+	typedef std::shared_ptr<UniformBuffer> Sptr;
+
+	static inline Sptr Create(BufferUsage usage = BufferUsage::DynamicDraw) {
+		return std::make_shared<UniformBuffer>(usage);
+	}
+
+	/// <summary>
+	/// Creates a new uniform buffer, with the given usage. Data will still need to be uploaded before it can be used
+	/// </summary>
+	/// <param name="usage">The usage hint for the buffer, default is GL_DYNAMIC_DRAW</param>
+	UniformBuffer(BufferUsage usage = BufferUsage::DynamicDraw) : IBuffer(BufferType::Uniform, usage) { }
+
+	using IBuffer::Update;
+	/// <summary>
+	/// Updates the contents of the buffer from a single std140 structure
+	/// </summary>
+	/// <typeparam name="T">The type of structure to upload</typeparam>
+	/// <param name="data">The structure to upload</param>
+	template <typename T>
+	void Update(const T& data) {
+		Update((const void*)(&data), sizeof(T));
+	}
+
+	/// <summary>
+	/// Unbinds the uniform buffer bound to the given slot
+	/// </summary>
+	static void UnBind(int slot) { IBuffer::UnBind(BufferType::Uniform, slot); }
+};
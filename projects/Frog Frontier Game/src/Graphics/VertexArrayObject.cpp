@@ -5,6 +5,7 @@
 
 VertexArrayObject::VertexArrayObject() :
 	_indexBuffer(nullptr),
+	_instanceBuffer(nullptr),
 	_handle(0),
 	_vertexCount(0),
 	_elementCount(0),
@@ -62,6 +63,22 @@ void VertexArrayObject::AddVertexBuffer(const VertexBuffer::Sptr& buffer, const
 	Unbind();
 }
 
+void VertexArrayObject::SetInstanceBuffer(const VertexBuffer::Sptr& buffer, const std::vector<BufferAttribute>& attributes) {
+	_instanceBuffer = buffer;
+
+	// These all act on the bound VAO and buffer
+	Bind();
+	buffer->Bind();
+	for (const BufferAttribute& attrib : attributes) {
+		glEnableVertexAttribArray(attrib.Slot);
+		glVertexAttribPointer(attrib.Slot, attrib.Size, (GLenum)attrib.Type, attrib.Normalized, attrib.Stride,
+							  (void*)attrib.Offset);
+		// Advance this attribute once per instance instead of once per vertex
+		glVertexAttribDivisor(attrib.Slot, 1);
+	}
+	Unbind();
+}
+
 void VertexArrayObject::Draw(DrawMode mode) {
 	Bind();
 	if (_indexBuffer == nullptr) {
@@ -72,6 +89,16 @@ void VertexArrayObject::Draw(DrawMode mode) {
 	Unbind();
 }
 
+void VertexArrayObject::DrawInstanced(uint32_t instanceCount, uint32_t baseInstance, DrawMode mode) {
+	Bind();
+	if (_indexBuffer == nullptr) {
+		glDrawArraysInstancedBaseInstance((GLenum)mode, 0, _elementCount, instanceCount, baseInstance);
+	} else {
+		glDrawElementsInstancedBaseInstance((GLenum)mode, _elementCount, (GLenum)_indexBuffer->GetElementType(), nullptr, instanceCount, baseInstance);
+	}
+	Unbind();
+}
+
 void VertexArrayObject::Bind() {
 	glBindVertexArray(_handle);
 }
@@ -151,6 +151,14 @@ public:
 	/// <param name="buffer">The buffer to add (note, does not take ownership, you will still need to delete later)</param>
 	/// <param name="attributes">A list of vertex attributes that will be fed by this buffer</param>
 	void AddVertexBuffer(const VertexBuffer::Sptr& buffer, const std::vector<BufferAttribute>& attributes);
+	/// <summary>
+	/// Sets the buffer that will feed per-instance attributes for DrawInstanced. The attributes
+	/// will advance once per instance rather than once per vertex
+	/// </summary>
+	/// <param name="buffer">The buffer containing the per-instance data</param>
+	/// <param name="attributes">A list of vertex attributes that will be fed by this buffer</param>
+	void SetInstanceBuffer(const VertexBuffer::Sptr& buffer, const std::vector<BufferAttribute>& attributes);
+	const VertexBuffer::Sptr& GetInstanceBuffer() const { return _instanceBuffer; }
 
 	/// <summary>
 	/// Gets the buffer binding that has an attribute with the given usage
@@ -161,6 +169,14 @@ public:
 	const VertexBufferBinding* GetBufferBinding(AttribUsage usage);
 
 	void Draw(DrawMode mode = DrawMode::TriangleList);
+	/// <summary>
+	/// Draws multiple instances of this VAO in a single draw call, the per-instance
+	/// data should be provided via SetInstanceBuffer
+	/// </summary>
+	/// <param name="instanceCount">The number of instances to draw</param>
+	/// <param name="baseInstance">The first element of the instance buffer to draw from, so several draws can share one buffer</param>
+	/// <param name="mode">The primitive mode to draw with</param>
+	void DrawInstanced(uint32_t instanceCount, uint32_t baseInstance = 0, DrawMode mode = DrawMode::TriangleList);
 
 	/// <summary>
 	/// Binds this VAO as the source of data for draw operations
@@ -185,6 +201,8 @@ protected:
 	IndexBuffer::Sptr _indexBuffer;
 	// The vertex buffers bound to this VAO
 	std::vector<VertexBufferBinding> _vertexBuffers;
+	// The buffer providing per-instance attributes, if any
+	VertexBuffer::Sptr _instanceBuffer;
 
 	// Stores a const pointer to one of the vertex declarations
 	// defined in VertexTypes.cpp
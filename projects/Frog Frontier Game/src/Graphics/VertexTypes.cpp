@@ -5,6 +5,8 @@ VertexPosCol* VPC = nullptr;
 VertexPosNormCol* VPNC = nullptr;
 VertexPosNormTex* VPNT = nullptr;
 VertexPosNormTexCol* VPNTC = nullptr;
+VertexPosNorm* VPN = nullptr;
+InstanceTransform* IT = nullptr;
 
 const std::vector<BufferAttribute> VertexPosCol::V_DECL = {
 	BufferAttribute(0, 3, AttributeType::Float, sizeof(VertexPosCol), (size_t)&VPC->Position, AttribUsage::Position),
@@ -26,4 +28,18 @@ const std::vector<BufferAttribute> VertexPosNormTexCol::V_DECL = {
 	BufferAttribute(2, 3, AttributeType::Float, sizeof(VertexPosNormTexCol), (size_t)&VPNTC->Normal, AttribUsage::Normal),
 	BufferAttribute(3, 2, AttributeType::Float, sizeof(VertexPosNormTexCol), (size_t)&VPNTC->UV, AttribUsage::Texture),
 };
+const std::vector<BufferAttribute> VertexPosNorm::V_DECL = {
+	BufferAttribute(0, 3, AttributeType::Float, sizeof(VertexPosNorm), (size_t)&VPN->Position, AttribUsage::Position),
+	BufferAttribute(2, 3, AttributeType::Float, sizeof(VertexPosNorm), (size_t)&VPN->Normal, AttribUsage::Normal),
+};
+// Matrices are passed as one attribute per column
+const std::vector<BufferAttribute> InstanceTransform::V_DECL = {
+	BufferAttribute(4, 4, AttributeType::Float, sizeof(InstanceTransform), (size_t)&IT->Model[0], AttribUsage::User0),
+	BufferAttribute(5, 4, AttributeType::Float, sizeof(InstanceTransform), (size_t)&IT->Model[1], AttribUsage::User0),
+	BufferAttribute(6, 4, AttributeType::Float, sizeof(InstanceTransform), (size_t)&IT->Model[2], AttribUsage::User0),
+	BufferAttribute(7, 4, AttributeType::Float, sizeof(InstanceTransform), (size_t)&IT->Model[3], AttribUsage::User0),
+	BufferAttribute(8, 3, AttributeType::Float, sizeof(InstanceTransform), (size_t)&IT->NormalMatrix[0], AttribUsage::User1),
+	BufferAttribute(9, 3, AttributeType::Float, sizeof(InstanceTransform), (size_t)&IT->NormalMatrix[1], AttribUsage::User1),
+	BufferAttribute(10, 3, AttributeType::Float, sizeof(InstanceTransform), (size_t)&IT->NormalMatrix[2], AttribUsage::User1),
+};
 #pragma warning(pop)
\ No newline at end of file
@@ -58,4 +58,34 @@ struct VertexPosNormTexCol {
 		Position({ x, y, z }), Normal({ nX, nY, nZ }), UV({ u, v }), Color({r, g, b, a}) {}
 
 	static const std::vector<BufferAttribute> V_DECL;
-};
\ No newline at end of file
+};
+
+/// <summary>
+/// Just the parts of a vertex that change between the keyframes of an animated mesh, see
+/// AnimatedMeshResource
+/// </summary>
+struct VertexPosNorm {
+	glm::vec3 Position;
+	glm::vec3 Normal;
+
+	VertexPosNorm() : Position(glm::vec3(0.0f)), Normal(glm::vec3(0.0f)) {}
+	VertexPosNorm(const glm::vec3& pos, const glm::vec3& norm) :
+		Position(pos), Normal(norm) {}
+
+	static const std::vector<BufferAttribute> V_DECL;
+};
+
+/// <summary>
+/// Per-instance data for instanced draws, this is fed to the vertex shader in slots 4-10
+/// (see vertex_shader_instanced.glsl), with the attribute divisor set to 1
+/// </summary>
+struct InstanceTransform {
+	glm::mat4 Model;
+	glm::mat3 NormalMatrix;
+
+	InstanceTransform() : Model(glm::mat4(1.0f)), NormalMatrix(glm::mat3(1.0f)) {}
+	InstanceTransform(const glm::mat4& model, const glm::mat3& normalMatrix) :
+		Model(model), NormalMatrix(normalMatrix) {}
+
+	static const std::vector<BufferAttribute> V_DECL;
+};
@@ -0,0 +1,105 @@
+#include "Utils/MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& filename) :
+	_data(nullptr),
+	_size(0),
+	_isOpen(false),
+	_file((intptr_t)INVALID_HANDLE_VALUE),
+	_mapping(0)
+{
+	HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return;
+	}
+	_file = (intptr_t)file;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)) {
+		return;
+	}
+	_size = (size_t)size.QuadPart;
+	_isOpen = true;
+
+	// Windows can't map empty files, but there's nothing to read anyways
+	if (_size == 0) {
+		return;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		_isOpen = false;
+		return;
+	}
+	_mapping = (intptr_t)mapping;
+
+	_data = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	_isOpen = _data != nullptr;
+}
+
+MappedFile::~MappedFile() {
+	if (_data != nullptr) {
+		UnmapViewOfFile(_data);
+	}
+	if (_mapping != 0) {
+		CloseHandle((HANDLE)_mapping);
+	}
+	if ((HANDLE)_file != INVALID_HANDLE_VALUE) {
+		CloseHandle((HANDLE)_file);
+	}
+}
+#else
+MappedFile::MappedFile(const std::string& filename) :
+	_data(nullptr),
+	_size(0),
+	_isOpen(false),
+	_file(-1),
+	_mapping(0)
+{
+	int file = open(filename.c_str(), O_RDONLY);
+	if (file == -1) {
+		return;
+	}
+	_file = file;
+
+	struct stat info;
+	if (fstat(file, &info) != 0) {
+		return;
+	}
+	_size = (size_t)info.st_size;
+	_isOpen = true;
+
+	// Can't map empty files, but there's nothing to read anyways
+	if (_size == 0) {
+		return;
+	}
+
+	void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+	if (data == MAP_FAILED) {
+		_isOpen = false;
+		return;
+	}
+	madvise(data, _size, MADV_SEQUENTIAL);
+	_data = (const char*)data;
+}
+
+MappedFile::~MappedFile() {
+	if (_data != nullptr) {
+		munmap((void*)_data, _size);
+	}
+	if (_file != -1) {
+		close((int)_file);
+	}
+}
+#endif
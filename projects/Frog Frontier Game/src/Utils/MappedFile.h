@@ -0,0 +1,45 @@
+#pragma once
+#include <string>
+#include <cstdint>
+
+/// <summary>
+/// Maps a file into memory as read-only, so it can be scanned in place without copying
+/// it into our own buffers first. The mapping is released when this object is destroyed
+/// </summary>
+class MappedFile {
+public:
+	/// <summary>
+	/// Opens and maps the given file, check IsOpen to see if this succeeded
+	/// </summary>
+	/// <param name="filename">The path of the file to map</param>
+	MappedFile(const std::string& filename);
+	~MappedFile();
+
+	MappedFile(const MappedFile& other) = delete;
+	MappedFile(MappedFile&& other) = delete;
+	MappedFile& operator=(const MappedFile& other) = delete;
+	MappedFile& operator=(MappedFile&& other) = delete;
+
+	/// <summary>
+	/// Returns true if the file was opened successfully. Note that empty files are
+	/// open, but will have a null data pointer
+	/// </summary>
+	bool IsOpen() const { return _isOpen; }
+	/// <summary>
+	/// Gets a pointer to the start of the file's contents
+	/// </summary>
+	const char* GetData() const { return _data; }
+	/// <summary>
+	/// Gets the size of the file, in bytes
+	/// </summary>
+	size_t GetSize() const { return _size; }
+
+protected:
+	const char* _data;
+	size_t      _size;
+	bool        _isOpen;
+
+	// Platform handles, stored as integers so we don't need the OS headers here
+	intptr_t    _file;
+	intptr_t    _mapping;
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <vector>
+#include <cstdint>
 #include "Graphics/VertexArrayObject.h"
 
 /// <summary>
@@ -127,7 +128,13 @@ public:
 		IndexBuffer::Sptr ebo = nullptr;
 		if (_indices.size() > 0) {
 			ebo = IndexBuffer::Create();
-			ebo->LoadData(GetIndexDataPtr(), _indices.size());
+			// Use 16 bit indices if we can, halving the size of the index buffer
+			if (_vertices.size() <= UINT16_MAX) {
+				std::vector<uint16_t> shortIndices(_indices.begin(), _indices.end());
+				ebo->LoadData(shortIndices.data(), shortIndices.size());
+			} else {
+				ebo->LoadData(GetIndexDataPtr(), _indices.size());
+			}
 		}
 
 		// Create VAO and attach the buffers
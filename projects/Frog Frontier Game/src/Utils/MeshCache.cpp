@@ -0,0 +1,237 @@
+#include "Utils/MeshCache.h"
+
+#include <fstream>
+#include <filesystem>
+#include <cstring>
+#include <atomic>
+#include <GLFW/glfw3.h>
+#include <Logging.h>
+
+
+// Bump this whenever the layout of the cache files changes, so old caches are rebuilt
+static constexpr uint32_t MESH_CACHE_VERSION = 1;
+static constexpr char     MESH_CACHE_MAGIC[4] = { 'F', 'F', 'M', 'C' };
+
+// The file header, followed by AttributeCount attributes, the vertex data then the index data
+struct MeshCacheHeader {
+	char     Magic[4];
+	uint32_t Version;
+	// Identifies the source file this cache was built from
+	uint64_t SourceSize;
+	int64_t  SourceTime;
+	uint32_t AttributeCount;
+	uint32_t VertexStride;
+	uint32_t VertexCount;
+	uint32_t IndexFormat;
+	uint32_t IndexSize;
+	uint32_t IndexCount;
+};
+
+// A BufferAttribute with fixed size fields, so the file layout doesn't depend on the compiler
+struct MeshCacheAttribute {
+	uint32_t Slot;
+	int32_t  Size;
+	uint32_t Type;
+	uint32_t Normalized;
+	int32_t  Stride;
+	int32_t  Offset;
+	uint32_t Usage;
+	uint32_t _padding0;
+};
+
+// Gets the size and modified time of the source file, returns false if it can't be read
+static bool GetSourceInfo(const std::string& sourcePath, uint64_t& size, int64_t& time) {
+	std::error_code error;
+	size = std::filesystem::file_size(sourcePath, error);
+	if (error) {
+		return false;
+	}
+	time = (int64_t)std::filesystem::last_write_time(sourcePath, error).time_since_epoch().count();
+	return !error;
+}
+
+std::string MeshCache::GetCachePath(const std::string& sourcePath) {
+	return sourcePath + ".meshcache";
+}
+
+VertexArrayObject::Sptr MeshCache::Load(const std::string& sourcePath) {
+	float startTime = glfwGetTime();
+
+	CachedMesh::Sptr cached = Read(sourcePath);
+	if (cached == nullptr) {
+		return nullptr;
+	}
+	VertexArrayObject::Sptr result = Upload(*cached);
+
+	float endTime = glfwGetTime();
+	LOG_TRACE("Loaded cached mesh for \"{}\" in {} seconds ({} vertices, {} indices)", sourcePath, endTime - startTime, cached->VertexCount, cached->IndexCount);
+
+	return result;
+}
+
+MeshCache::CachedMesh::Sptr MeshCache::Read(const std::string& sourcePath) {
+	uint64_t sourceSize;
+	int64_t sourceTime;
+	if (!GetSourceInfo(sourcePath, sourceSize, sourceTime)) {
+		return nullptr;
+	}
+
+	const std::string cachePath = GetCachePath(sourcePath);
+	if (!std::filesystem::exists(cachePath)) {
+		return nullptr;
+	}
+
+	std::unique_ptr<MappedFile> file = std::make_unique<MappedFile>(cachePath);
+	if (!file->IsOpen() || file->GetSize() < sizeof(MeshCacheHeader)) {
+		return nullptr;
+	}
+
+	MeshCacheHeader header;
+	memcpy(&header, file->GetData(), sizeof(MeshCacheHeader));
+
+	// Make sure the cache is ours, and was built from the current version of the source
+	if (memcmp(header.Magic, MESH_CACHE_MAGIC, 4) != 0 || header.Version != MESH_CACHE_VERSION) {
+		return nullptr;
+	}
+	if (header.SourceSize != sourceSize || header.SourceTime != sourceTime) {
+		LOG_INFO("Mesh cache for \"{}\" is out of date, rebuilding", sourcePath);
+		return nullptr;
+	}
+
+	// Make sure the file actually contains all the data the header says it does
+	const size_t attribBytes = header.AttributeCount * sizeof(MeshCacheAttribute);
+	const size_t vertexBytes = (size_t)header.VertexStride * header.VertexCount;
+	const size_t indexBytes = (size_t)header.IndexSize * header.IndexCount;
+	if (file->GetSize() != sizeof(MeshCacheHeader) + attribBytes + vertexBytes + indexBytes) {
+		LOG_WARN("Mesh cache for \"{}\" is corrupt, ignoring", sourcePath);
+		return nullptr;
+	}
+
+	CachedMesh::Sptr result = std::make_shared<CachedMesh>();
+	const char* data = file->GetData() + sizeof(MeshCacheHeader);
+
+	result->VDecl.resize(header.AttributeCount);
+	for (uint32_t ix = 0; ix < header.AttributeCount; ix++) {
+		MeshCacheAttribute attrib;
+		memcpy(&attrib, data, sizeof(MeshCacheAttribute));
+		data += sizeof(MeshCacheAttribute);
+
+		result->VDecl[ix] = BufferAttribute(attrib.Slot, attrib.Size, (AttributeType)attrib.Type, attrib.Stride, attrib.Offset, (AttribUsage)attrib.Usage, attrib.Normalized != 0);
+	}
+
+	result->VertexData = data;
+	result->VertexStride = header.VertexStride;
+	result->VertexCount = header.VertexCount;
+	result->IndexData = data + vertexBytes;
+	result->IndexFormat = (IndexType)header.IndexFormat;
+	result->IndexSize = header.IndexSize;
+	result->IndexCount = header.IndexCount;
+	result->File = std::move(file);
+	return result;
+}
+
+VertexArrayObject::Sptr MeshCache::Upload(const CachedMesh& mesh) {
+	// Hand the data straight from the mapped file to OpenGL
+	VertexBuffer::Sptr vertexBuffer = VertexBuffer::Create();
+	vertexBuffer->LoadData(mesh.VertexData, mesh.VertexStride, mesh.VertexCount);
+
+	IndexBuffer::Sptr indexBuffer = nullptr;
+	if (mesh.IndexCount > 0) {
+		indexBuffer = IndexBuffer::Create();
+		indexBuffer->LoadData(mesh.IndexData, mesh.IndexSize, mesh.IndexCount, mesh.IndexFormat);
+	}
+
+	VertexArrayObject::Sptr result = VertexArrayObject::Create();
+	result->AddVertexBuffer(vertexBuffer, mesh.VDecl);
+	result->SetIndexBuffer(indexBuffer);
+	result->SetVDecl(mesh.VDecl);
+	return result;
+}
+
+bool MeshCache::_Save(const std::string& sourcePath, const VertexArrayObject::VertexDeclaration& vDecl,
+	const void* vertexData, size_t vertexStride, size_t vertexCount, const uint32_t* indexData, size_t indexCount)
+{
+	if (vertexCount == 0) {
+		return false;
+	}
+
+	uint64_t sourceSize;
+	int64_t sourceTime;
+	if (!GetSourceInfo(sourcePath, sourceSize, sourceTime)) {
+		return false;
+	}
+
+	// Match the index format that MeshBuilder::Bake would upload
+	std::vector<uint16_t> shortIndices;
+	IndexType indexFormat = IndexType::Unknown;
+	size_t indexSize = 0;
+	const void* indices = nullptr;
+	if (indexCount > 0) {
+		if (vertexCount <= UINT16_MAX) {
+			shortIndices.assign(indexData, indexData + indexCount);
+			indexFormat = IndexType::UShort;
+			indexSize = sizeof(uint16_t);
+			indices = shortIndices.data();
+		} else {
+			indexFormat = IndexType::UInt;
+			indexSize = sizeof(uint32_t);
+			indices = indexData;
+		}
+	}
+
+	MeshCacheHeader header;
+	memcpy(header.Magic, MESH_CACHE_MAGIC, 4);
+	header.Version = MESH_CACHE_VERSION;
+	header.SourceSize = sourceSize;
+	header.SourceTime = sourceTime;
+	header.AttributeCount = (uint32_t)vDecl.size();
+	header.VertexStride = (uint32_t)vertexStride;
+	header.VertexCount = (uint32_t)vertexCount;
+	header.IndexFormat = (uint32_t)indexFormat;
+	header.IndexSize = (uint32_t)indexSize;
+	header.IndexCount = (uint32_t)indexCount;
+
+	// Write to a temporary file first, so a crash part way through can't leave a broken cache behind.
+	// Each save gets it's own temporary file, since the loader threads can save the same mesh at
+	// once if it's in the manifest more than once, and whichever rename lands last wins
+	static std::atomic<uint32_t> nextTempId(0);
+	const std::string cachePath = GetCachePath(sourcePath);
+	const std::string tempPath = cachePath + "." + std::to_string(nextTempId++) + ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			LOG_WARN("Failed to write mesh cache \"{}\"", cachePath);
+			return false;
+		}
+
+		file.write((const char*)&header, sizeof(MeshCacheHeader));
+		for (const BufferAttribute& attrib : vDecl) {
+			MeshCacheAttribute data;
+			data.Slot = attrib.Slot;
+			data.Size = attrib.Size;
+			data.Type = (uint32_t)attrib.Type;
+			data.Normalized = attrib.Normalized ? 1 : 0;
+			data.Stride = attrib.Stride;
+			data.Offset = attrib.Offset;
+			data.Usage = (uint32_t)attrib.Usage;
+			data._padding0 = 0;
+			file.write((const char*)&data, sizeof(MeshCacheAttribute));
+		}
+		file.write((const char*)vertexData, vertexStride * vertexCount);
+		file.write((const char*)indices, indexSize * indexCount);
+
+		if (!file) {
+			LOG_WARN("Failed to write mesh cache \"{}\"", cachePath);
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(tempPath, cachePath, error);
+	if (error) {
+		LOG_WARN("Failed to write mesh cache \"{}\": {}", cachePath, error.message());
+		std::filesystem::remove(tempPath, error);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <string>
+#include <memory>
+
+#include "Graphics/VertexArrayObject.h"
+#include "Utils/MappedFile.h"
+#include "Utils/MeshBuilder.h"
+
+/// <summary>
+/// Stores meshes that have been loaded from source files (ex: OBJ) in a cooked binary
+/// format next to the source, so later runs can skip parsing entirely. A cache file
+/// contains a header, the vertex declaration, then the raw vertex and index data
+///
+/// Cache files record the size and modified time of the source they were built from,
+/// and are ignored if the source has changed since
+/// </summary>
+class MeshCache
+{
+public:
+	/// <summary>
+	/// A cache file that has been mapped and validated, but not yet uploaded to OpenGL.
+	/// The data pointers point into the mapped file
+	/// </summary>
+	struct CachedMesh {
+		typedef std::shared_ptr<CachedMesh> Sptr;
+
+		std::unique_ptr<MappedFile>          File;
+		VertexArrayObject::VertexDeclaration VDecl;
+		const char* VertexData;
+		uint32_t    VertexStride;
+		uint32_t    VertexCount;
+		const char* IndexData;
+		IndexType   IndexFormat;
+		uint32_t    IndexSize;
+		uint32_t    IndexCount;
+	};
+
+	/// <summary>
+	/// Maps and validates the cooked version of a mesh file without touching OpenGL, so
+	/// this can be called from worker threads
+	/// </summary>
+	/// <param name="sourcePath">The path to the source mesh (ex: the OBJ file)</param>
+	/// <returns>The cached mesh, or nullptr if there is no cache or it is out of date</returns>
+	static CachedMesh::Sptr Read(const std::string& sourcePath);
+	/// <summary>
+	/// Creates a VAO from a cache file that has been read, must be called on the main thread
+	/// </summary>
+	static VertexArrayObject::Sptr Upload(const CachedMesh& mesh);
+
+	/// <summary>
+	/// Attempts to load the cooked version of a mesh file
+	/// </summary>
+	/// <param name="sourcePath">The path to the source mesh (ex: the OBJ file)</param>
+	/// <returns>The mesh, or nullptr if there is no cache or it is out of date</returns>
+	static VertexArrayObject::Sptr Load(const std::string& sourcePath);
+
+	/// <summary>
+	/// Writes a mesh to the cache for the given source file, in the same layout that
+	/// MeshBuilder::Bake would upload it in. This doesn't touch OpenGL, so it can be called
+	/// from worker threads
+	/// </summary>
+	/// <typeparam name="VertType">The type of vertex in the mesh</typeparam>
+	/// <param name="sourcePath">The path to the source mesh that was loaded</param>
+	/// <param name="mesh">The mesh to store</param>
+	/// <returns>True if the cache file was written</returns>
+	template <typename VertType>
+	static bool Save(const std::string& sourcePath, const MeshBuilder<VertType>& mesh) {
+		return _Save(sourcePath, VertType::V_DECL, mesh.GetVertexDataPtr(), sizeof(VertType), mesh.GetVertexCount(), mesh.GetIndexDataPtr(), mesh.GetIndexCount());
+	}
+
+	/// <summary>
+	/// Gets the path of the cache file for the given source file
+	/// </summary>
+	static std::string GetCachePath(const std::string& sourcePath);
+
+protected:
+	MeshCache() = default;
+	~MeshCache() = default;
+
+	/// <summary>
+	/// Writes raw vertex and index data to the cache for the given source file. Indices are
+	/// stored as 16 bit if every vertex can be addressed with them, same as MeshBuilder::Bake
+	/// </summary>
+	static bool _Save(const std::string& sourcePath, const VertexArrayObject::VertexDeclaration& vDecl,
+		const void* vertexData, size_t vertexStride, size_t vertexCount, const uint32_t* indexData, size_t indexCount);
+};
@@ -6,14 +6,44 @@
 #include <iostream>
 #include <GLFW/glfw3.h>
 #include <filesystem>
+#include <unordered_map>
 
 #include "Utils/StringUtils.h"
 
 VertexArrayObject::Sptr ObjLoader::LoadFromFile(const std::string& filename)
+{
+	float startTime = glfwGetTime();
+
+	std::vector<glm::vec3> positions;
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec2> uvs;
+	std::vector<glm::ivec3> vertices;
+	if (!ParseAttributes(filename, positions, uvs, normals, vertices)) {
+		return nullptr;
+	}
+
+	// Generate an indexed mesh from the data we loaded
+	MeshBuilder<VertexPosNormTexCol> mesh;
+	BuildMesh(positions, uvs, normals, vertices, mesh);
+	VertexArrayObject::Sptr result = mesh.Bake();
+	
+	// Calculate and trace out how long it took us to load
+	float endTime = glfwGetTime();
+	LOG_TRACE("Loaded OBJ file \"{}\" in {} seconds ({} vertices, {} indices)", filename, endTime - startTime, mesh.GetVertexCount(), mesh.GetIndexCount());
+
+	return result;
+}
+
+bool ObjLoader::ParseAttributes(
+	const std::string& filename,
+	std::vector<glm::vec3>& positions,
+	std::vector<glm::vec2>& uvs,
+	std::vector<glm::vec3>& normals,
+	std::vector<glm::ivec3>& vertices)
 {
 	if (!std::filesystem::exists(filename)) {
 		LOG_WARN("Failed to find OBJ file: \"{}\"", filename);
-		return nullptr;
+		return false;
 	}
 
 	// Open our file in binary mode
@@ -26,18 +56,10 @@ VertexArrayObject::Sptr ObjLoader::LoadFromFile(const std::string& filename)
 	}
 
 	std::string line;
-	
-	// TODO: Load data from file
-	std::vector<glm::vec3> positions;
-	std::vector<glm::vec3> normals;
-	std::vector<glm::vec2> uvs;
-	std::vector<glm::ivec3> vertices;
 
 	glm::vec3 vecData;
 	glm::ivec3 vertexIndices;
 
-	float startTime = glfwGetTime();
-
 	// Read and process the entire file
 	while (file.peek() != EOF) {
 		// Read in the first part of the line (ex: f, v, vn, etc...)
@@ -80,9 +102,20 @@ VertexArrayObject::Sptr ObjLoader::LoadFromFile(const std::string& filename)
 
 			// We'll support only triangles
 			for (int ix = 0; ix < 3; ix++) {
-				// Read in the 3 attributes (position, UV, normal)
-				char separator;
-				stream >> vertexIndices.x >> separator >> vertexIndices.y >> separator >> vertexIndices.z;
+				// Read in the 3 attributes (position, UV, normal), either of the last
+				// two can be left out (ex: 1//2)
+				vertexIndices = glm::ivec3(0);
+				stream >> vertexIndices.x;
+				if (stream.peek() == '/') {
+					stream.get();
+					if (stream.peek() != '/') {
+						stream >> vertexIndices.y;
+					}
+					if (stream.peek() == '/') {
+						stream.get();
+						stream >> vertexIndices.z;
+					}
+				}
 
 				// The OBJ format can have negative values, which are a reference from the last added attributes
 				if (vertexIndices.x < 0) { vertexIndices.x = positions.size() + 1 + vertexIndices.x; }
@@ -92,45 +125,47 @@ VertexArrayObject::Sptr ObjLoader::LoadFromFile(const std::string& filename)
 				// OBJ format uses 1-based indices
 				vertexIndices -= glm::ivec3(1);
 
-				// add the vertex indices to the list
-				// NOTE: This will create duplicate vertices!
-				// A smarter solution would create a map of what attribute
-				// combos have already been added
+				// add the vertex indices to the list, duplicates are merged in BuildMesh
 				vertices.push_back(vertexIndices);
 			}
 		}
 	}
 
-	// TODO: Generate mesh from the data we loaded
-	std::vector<VertexPosNormTexCol> vertexData;
-
-	for (int ix = 0; ix < vertices.size(); ix++) {
-		glm::ivec3 attribs = vertices[ix];
-
-		// Extract attributes from lists (except color)
-		glm::vec3 position = positions[attribs.x];
-		glm::vec2 uv       = uvs[attribs.y];
-		glm::vec3 normal   = normals[attribs.z];
-		glm::vec4 color    = glm::vec4(1.0f);
+	return true;
+}
 
-		// Add the vertex to the mesh
-		vertexData.push_back(VertexPosNormTexCol(position, normal, uv, color));
+// Hashes the position, uv and normal indices of an OBJ vertex
+struct ObjVertexHash {
+	size_t operator()(const glm::ivec3& value) const {
+		return ((size_t)value.x * 73856093u) ^ ((size_t)value.y * 19349663u) ^ ((size_t)value.z * 83492791u);
+	}
+};
+
+void ObjLoader::BuildMesh(
+	const std::vector<glm::vec3>& positions,
+	const std::vector<glm::vec2>& uvs,
+	const std::vector<glm::vec3>& normals,
+	const std::vector<glm::ivec3>& vertices,
+	MeshBuilder<VertexPosNormTexCol>& mesh)
+{
+	mesh.ReserveIndexSpace(vertices.size());
+
+	// Maps each unique combination of attributes to it's index in the mesh
+	std::unordered_map<glm::ivec3, uint32_t, ObjVertexHash> vertexMap;
+	vertexMap.reserve(vertices.size());
+
+	for (const glm::ivec3& attribs : vertices) {
+		auto it = vertexMap.find(attribs);
+		if (it == vertexMap.end()) {
+			// Extract attributes from lists (except color), missing or out of range
+			// attributes are left at zero rather than reading past the end of our lists
+			glm::vec3 position = (size_t)attribs.x < positions.size() ? positions[attribs.x] : glm::vec3(0.0f);
+			glm::vec2 uv       = (size_t)attribs.y < uvs.size()       ? uvs[attribs.y]       : glm::vec2(0.0f);
+			glm::vec3 normal   = (size_t)attribs.z < normals.size()   ? normals[attribs.z]   : glm::vec3(0.0f);
+			glm::vec4 color    = glm::vec4(1.0f);
+
+			it = vertexMap.emplace(attribs, mesh.AddVertex(VertexPosNormTexCol(position, normal, uv, color))).first;
+		}
+		mesh.AddIndex(it->second);
 	}
-
-	// Create a vertex buffer and load all our vertex data
-	VertexBuffer::Sptr vertexBuffer = VertexBuffer::Create();
-	vertexBuffer->LoadData(vertexData.data(), vertexData.size());
-
-	// Create the VAO, and add the vertices
-	VertexArrayObject::Sptr result = VertexArrayObject::Create();
-	result->AddVertexBuffer(vertexBuffer, VertexPosNormTexCol::V_DECL);
-
-	result->SetVDecl(VertexPosNormTexCol::V_DECL);
-	
-	// Calculate and trace out how long it took us to load
-	float endTime = glfwGetTime();
-	LOG_TRACE("Loaded OBJ file \"{}\" in {} seconds ({} vertices, {} indices)", filename, endTime - startTime, vertexData.size(), 0);
-
-	return result;
-	//return VertexArrayObject::Create();
 }
@@ -8,6 +8,41 @@ class ObjLoader
 public:
 	static VertexArrayObject::Sptr LoadFromFile(const std::string& filename);
 
+	/// <summary>
+	/// Reads the raw attribute lists and faces out of an OBJ file with stream operators, without
+	/// touching OpenGL. OptimizedObjLoader::ParseAttributes produces the same output much faster,
+	/// this is kept as the reference it is checked against
+	/// </summary>
+	/// <param name="filename">The path to the OBJ file to parse</param>
+	/// <param name="positions">Receives the positions in the file (v)</param>
+	/// <param name="uvs">Receives the texture coordinates in the file (vt)</param>
+	/// <param name="normals">Receives the normals in the file (vn)</param>
+	/// <param name="vertices">Receives the 0-based position, uv and normal index for each corner of each face</param>
+	/// <returns>True if the file was found and parsed</returns>
+	static bool ParseAttributes(
+		const std::string& filename,
+		std::vector<glm::vec3>& positions,
+		std::vector<glm::vec2>& uvs,
+		std::vector<glm::vec3>& normals,
+		std::vector<glm::ivec3>& vertices);
+
+	/// <summary>
+	/// Builds an indexed mesh from the attribute lists of an OBJ file. Each unique
+	/// position/uv/normal combination becomes a single vertex. This does not touch
+	/// OpenGL, call Bake on the result to create the VAO
+	/// </summary>
+	/// <param name="positions">The positions loaded from the file (v)</param>
+	/// <param name="uvs">The texture coordinates loaded from the file (vt)</param>
+	/// <param name="normals">The normals loaded from the file (vn)</param>
+	/// <param name="vertices">The 0-based position, uv and normal index for each corner of each face</param>
+	/// <param name="mesh">The mesh builder to add the vertices and indices to</param>
+	static void BuildMesh(
+		const std::vector<glm::vec3>& positions,
+		const std::vector<glm::vec2>& uvs,
+		const std::vector<glm::vec3>& normals,
+		const std::vector<glm::ivec3>& vertices,
+		MeshBuilder<VertexPosNormTexCol>& mesh);
+
 protected:
 	ObjLoader() = default;
 	~ObjLoader() = default;
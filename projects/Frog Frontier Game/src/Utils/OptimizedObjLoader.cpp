@@ -0,0 +1,195 @@
+#include "OptimizedObjLoader.h"
+
+#include <string>
+#include <cstring>
+#include <charconv>
+#include <GLFW/glfw3.h>
+#include <filesystem>
+
+#include "Utils/MappedFile.h"
+#include "Utils/ObjLoader.h"
+
+// Skips over spaces and tabs, but not line endings
+static inline const char* SkipSpaces(const char* ptr, const char* end) {
+	while (ptr < end && (*ptr == ' ' || *ptr == '\t')) {
+		ptr++;
+	}
+	return ptr;
+}
+
+// Gets the end of the line starting at ptr, not including the newline
+static inline const char* FindLineEnd(const char* ptr, const char* end) {
+	const char* result = (const char*)memchr(ptr, '\n', end - ptr);
+	return result == nullptr ? end : result;
+}
+
+// Parses a float, returning a pointer to the first character after it. Like streaming in
+// a float, a value that fails to parse will be zero
+static inline const char* ParseFloat(const char* ptr, const char* end, float& result) {
+	ptr = SkipSpaces(ptr, end);
+	// from_chars does not accept a leading plus sign
+	if (ptr < end && *ptr == '+') {
+		ptr++;
+	}
+	std::from_chars_result parsed = std::from_chars(ptr, end, result);
+	if (parsed.ec != std::errc()) {
+		result = 0.0f;
+	}
+	return parsed.ptr;
+}
+
+// Parses an integer, returning a pointer to the first character after it
+static inline const char* ParseInt(const char* ptr, const char* end, int& result) {
+	std::from_chars_result parsed = std::from_chars(ptr, end, result);
+	if (parsed.ec != std::errc()) {
+		result = 0;
+	}
+	return parsed.ptr;
+}
+
+// Returns true if the line is the given command followed by whitespace
+static inline bool IsCommand(const char* line, const char* lineEnd, const char* command, size_t length) {
+	return (size_t)(lineEnd - line) > length && memcmp(line, command, length) == 0 && (line[length] == ' ' || line[length] == '\t');
+}
+
+VertexArrayObject::Sptr OptimizedObjLoader::LoadFromFile(const std::string& filename)
+{
+	float startTime = glfwGetTime();
+
+	MeshBuilder<VertexPosNormTexCol> mesh;
+	if (!ParseFile(filename, mesh)) {
+		return nullptr;
+	}
+	VertexArrayObject::Sptr result = mesh.Bake();
+
+	// Calculate and trace out how long it took us to load
+	float endTime = glfwGetTime();
+	LOG_TRACE("Loaded OBJ file \"{}\" in {} seconds ({} vertices, {} indices)", filename, endTime - startTime, mesh.GetVertexCount(), mesh.GetIndexCount());
+
+	return result;
+}
+
+bool OptimizedObjLoader::ParseFile(const std::string& filename, MeshBuilder<VertexPosNormTexCol>& mesh)
+{
+	std::vector<glm::vec3> positions;
+	std::vector<glm::vec3> normals;
+	std::vector<glm::vec2> uvs;
+	std::vector<glm::ivec3> vertices;
+	if (!ParseAttributes(filename, positions, uvs, normals, vertices)) {
+		return false;
+	}
+
+	// Generate an indexed mesh from the data we loaded, merging duplicate vertices
+	ObjLoader::BuildMesh(positions, uvs, normals, vertices, mesh);
+	return true;
+}
+
+bool OptimizedObjLoader::ParseAttributes(
+	const std::string& filename,
+	std::vector<glm::vec3>& positions,
+	std::vector<glm::vec2>& uvs,
+	std::vector<glm::vec3>& normals,
+	std::vector<glm::ivec3>& vertices)
+{
+	if (!std::filesystem::exists(filename)) {
+		LOG_WARN("Failed to find OBJ file: \"{}\"", filename);
+		return false;
+	}
+
+	// Map the whole file into memory
+	MappedFile file(filename);
+
+	// If our file fails to open, we will throw an error
+	if (!file.IsOpen()) {
+		throw std::runtime_error("Failed to open file");
+	}
+
+	const char* const begin = file.GetData();
+	const char* const end = begin + file.GetSize();
+
+	// Count up all our attributes first so we only need to allocate once
+	size_t numPositions = 0, numNormals = 0, numUvs = 0, numFaces = 0;
+	for (const char* line = begin; line < end;) {
+		const char* lineEnd = FindLineEnd(line, end);
+		line = SkipSpaces(line, lineEnd);
+		if (IsCommand(line, lineEnd, "v", 1))  { numPositions++; }
+		else if (IsCommand(line, lineEnd, "vn", 2)) { numNormals++; }
+		else if (IsCommand(line, lineEnd, "vt", 2)) { numUvs++; }
+		else if (IsCommand(line, lineEnd, "f", 1))  { numFaces++; }
+		line = lineEnd + 1;
+	}
+
+	positions.clear();
+	normals.clear();
+	uvs.clear();
+	vertices.clear();
+	positions.reserve(numPositions);
+	normals.reserve(numNormals);
+	uvs.reserve(numUvs);
+	vertices.reserve(numFaces * 3);
+
+	glm::vec3 vecData;
+	glm::ivec3 vertexIndices;
+
+	// Now we can go through and actually read the data, any other commands (comments,
+	// objects, materials, etc...) are skipped over
+	for (const char* line = begin; line < end;) {
+		const char* lineEnd = FindLineEnd(line, end);
+		const char* ptr = SkipSpaces(line, lineEnd);
+
+		// The v command defines a vertex's position
+		if (IsCommand(ptr, lineEnd, "v", 1)) {
+			ptr = ParseFloat(ptr + 1, lineEnd, vecData.x);
+			ptr = ParseFloat(ptr, lineEnd, vecData.y);
+			ParseFloat(ptr, lineEnd, vecData.z);
+			positions.push_back(vecData);
+		}
+		else if (IsCommand(ptr, lineEnd, "vn", 2)) {
+			ptr = ParseFloat(ptr + 2, lineEnd, vecData.x);
+			ptr = ParseFloat(ptr, lineEnd, vecData.y);
+			ParseFloat(ptr, lineEnd, vecData.z);
+			normals.push_back(vecData);
+		}
+		else if (IsCommand(ptr, lineEnd, "vt", 2)) {
+			ptr = ParseFloat(ptr + 2, lineEnd, vecData.x);
+			ParseFloat(ptr, lineEnd, vecData.y);
+			uvs.push_back(vecData);
+		}
+
+		// The f command defines a polygon in the mesh, like ObjLoader we only take the
+		// first 3 corners, so make sure to triangulate in blender
+		else if (IsCommand(ptr, lineEnd, "f", 1)) {
+			ptr++;
+			for (int ix = 0; ix < 3; ix++) {
+				// Read in the 3 attributes (position, UV, normal), either of the last
+				// two can be left out (ex: 1//2)
+				vertexIndices = glm::ivec3(0);
+				ptr = SkipSpaces(ptr, lineEnd);
+				ptr = ParseInt(ptr, lineEnd, vertexIndices.x);
+				if (ptr < lineEnd && *ptr == '/') {
+					ptr++;
+					if (ptr < lineEnd && *ptr != '/') {
+						ptr = ParseInt(ptr, lineEnd, vertexIndices.y);
+					}
+					if (ptr < lineEnd && *ptr == '/') {
+						ptr = ParseInt(ptr + 1, lineEnd, vertexIndices.z);
+					}
+				}
+
+				// The OBJ format can have negative values, which are a reference from the last added attributes
+				if (vertexIndices.x < 0) { vertexIndices.x = positions.size() + 1 + vertexIndices.x; }
+				if (vertexIndices.y < 0) { vertexIndices.y = uvs.size()       + 1 + vertexIndices.y; }
+				if (vertexIndices.z < 0) { vertexIndices.z = normals.size()   + 1 + vertexIndices.z; }
+
+				// OBJ format uses 1-based indices, missing attributes will end up as -1
+				vertexIndices -= glm::ivec3(1);
+
+				vertices.push_back(vertexIndices);
+			}
+		}
+
+		line = lineEnd + 1;
+	}
+
+	return true;
+}
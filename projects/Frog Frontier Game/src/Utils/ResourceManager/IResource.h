@@ -1,4 +1,5 @@
 #pragma once
+#include <functional>
 #include "Utils/GUID.hpp"
 #include "json.hpp"
 
@@ -12,6 +13,12 @@
 /// Resources must additionally define a static method as such:
 /// static std::shared_ptr<Type> FromJson(const nlohmann::json&);
 /// where Type is the Type of resource
+/// 
+/// Resources may also define:
+/// static ResourceFinalizer PrepareFromJson(const nlohmann::json&);
+/// which performs any work that does not touch OpenGL (ex: parsing files) and
+/// can be run on a worker thread, returning a function that finishes creating
+/// the resource on the main thread
 /// </summary>
 class IResource {
 public:
@@ -43,6 +50,11 @@ protected:
 	IResource() : _guid(Guid::New()){}
 };
 
+/// <summary>
+/// Finishes loading a resource on the main thread, see IResource
+/// </summary>
+typedef std::function<IResource::Sptr()> ResourceFinalizer;
+
 /// <summary>
 /// Returns true if the given type is a valid resource type
 /// IE it needs to extend from IResource and implement a static
@@ -3,9 +3,17 @@
 #include "Utils/ObjLoader.h"
 #include "Utils/FileHelpers.h"
 #include "Utils/StringUtils.h"
+#include "Utils/ThreadPool.h"
 
-std::map<std::type_index, std::map<Guid, IResource::Sptr>> ResourceManager::_resources;
-std::map<std::string, std::function<Guid(const nlohmann::json&)>> ResourceManager::_typeLoaders;
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <set>
+
+std::map<uint32_t, std::map<Guid, IResource::Sptr>> ResourceManager::_resources;
+std::map<uint32_t, ResourceManager::TypeLoader> ResourceManager::_typeLoaders;
+std::map<uint32_t, std::unordered_map<std::string, Guid>> ResourceManager::_sources;
+std::map<uint32_t, const char*> ResourceManager::_typeNames;
 
 nlohmann::json ResourceManager::_manifest;
 
@@ -21,16 +29,113 @@ const nlohmann::json& ResourceManager::GetManifest() {
 	return _manifest;
 }
 
+// Adds a type to the load order after all of it's dependencies
+template <typename TLoaders>
+static void AddToLoadOrder(uint32_t type, const TLoaders& loaders, std::set<uint32_t>& visited, std::vector<uint32_t>& order) {
+	if (!visited.insert(type).second) {
+		return;
+	}
+	auto it = loaders.find(type);
+	if (it != loaders.end()) {
+		for (uint32_t dependency : it->second.Dependencies) {
+			AddToLoadOrder(dependency, loaders, visited, order);
+		}
+	}
+	order.push_back(type);
+}
+
 void ResourceManager::LoadManifest(const std::string& path) {
+	typedef std::chrono::high_resolution_clock Clock;
+	typedef std::chrono::duration<double> Seconds;
+	Clock::time_point loadStart = Clock::now();
+
 	std::string contents = FileHelpers::ReadFile(path);
 	nlohmann::json blob = nlohmann::json::parse(contents);
 
+	// The manifest is sorted by type name, so we need to work out an order that loads
+	// dependencies (ex: shaders and textures) before the types that reference them
+	std::set<uint32_t> visited;
+	std::vector<uint32_t> loadOrder;
 	for (auto& [typeName, items] : blob.items()) {
-		auto& func = _typeLoaders[typeName];
-		if (func) {
-			for (auto& [guid, blob] : items.items()) {
-				func(blob);
+		uint32_t type = const_hash_fnv1a(typeName.c_str());
+		if (_typeLoaders.find(type) != _typeLoaders.end()) {
+			AddToLoadOrder(type, _typeLoaders, visited, loadOrder);
+		}
+	}
+
+	// The result of preparing a resource on a worker, and how long it took
+	struct PreparedResource {
+		ResourceFinalizer Finalize;
+		double            WorkerTime;
+	};
+
+	// Kick off all the worker jobs up front, so that files for later types are being read
+	// while we finish earlier types on the main thread. Note that the pool needs to be
+	// declared after the blob, so jobs are finished before the JSON goes out of scope
+	ThreadPool pool;
+	std::map<uint32_t, std::vector<std::future<PreparedResource>>> jobs;
+	for (uint32_t type : loadOrder) {
+		const TypeLoader& loader = _typeLoaders[type];
+		if (loader.Prepare && blob.contains(_typeNames[type])) {
+			std::vector<std::future<PreparedResource>>& typeJobs = jobs[type];
+			for (auto& [guid, data] : blob[_typeNames[type]].items()) {
+				const nlohmann::json* item = &data;
+				const std::function<ResourceFinalizer(const nlohmann::json&)>* prepare = &loader.Prepare;
+				typeJobs.push_back(pool.Submit([item, prepare]() {
+					Clock::time_point start = Clock::now();
+					ResourceFinalizer finalizer = (*prepare)(*item);
+					return PreparedResource{ finalizer, Seconds(Clock::now() - start).count() };
+				}));
+			}
+		}
+	}
+
+	// Finish each type in order on the main thread, creating any OpenGL objects
+	for (uint32_t type : loadOrder) {
+		// Dependencies may not have any entries in this manifest
+		if (!blob.contains(_typeNames[type])) {
+			continue;
+		}
+		const TypeLoader& loader = _typeLoaders[type];
+		const nlohmann::json& items = blob[_typeNames[type]];
+
+		size_t count = 0;
+		double workerTime = 0.0;
+		Clock::time_point mainStart = Clock::now();
+		if (loader.Prepare) {
+			auto itemIt = items.begin();
+			for (std::future<PreparedResource>& job : jobs[type]) {
+				PreparedResource prepared = job.get();
+				workerTime += prepared.WorkerTime;
+
+				IResource::Sptr res = prepared.Finalize();
+				res->OverrideGUID(Guid((*itemIt)["guid"]));
+				_resources[type][res->GetGUID()] = res;
+				_AddSource(type, *itemIt, res->GetGUID());
+				++itemIt;
+				count++;
 			}
+		} else {
+			for (auto& [guid, data] : items.items()) {
+				_AddSource(type, data, loader.Load(data));
+				count++;
+			}
+		}
+
+		// Note that main thread time includes time spent waiting on workers to finish
+		LOG_INFO("Loaded {} x {} in {:.3f}s on main thread ({:.3f}s on workers)",
+			count, _typeNames[type], Seconds(Clock::now() - mainStart).count(), workerTime);
+	}
+
+	LOG_INFO("Loaded manifest \"{}\" in {:.3f}s using {} workers", path, Seconds(Clock::now() - loadStart).count(), pool.GetThreadCount());
+}
+
+void ResourceManager::_AddSource(uint32_t type, const nlohmann::json& data, Guid id) {
+	const TypeLoader& loader = _typeLoaders[type];
+	if (loader.GetSource) {
+		std::string source = loader.GetSource(data);
+		if (!source.empty()) {
+			_sources[type].emplace(source, id);
 		}
 	}
 }
@@ -39,15 +144,97 @@ void ResourceManager::SaveManifest(const std::string& path) {
 	// Update all resources in the manifest so they match their current representation
 	for (auto& [type, map] : _resources) {
 		for (auto& [guid, res] : map) {
-			_manifest[StringTools::SanitizeClassName(type.name())][guid.str()] = res->ToJson();
+			nlohmann::json data = res->ToJson();
+			data["guid"] = guid.str();
+			_manifest[_typeNames[type]][guid.str()] = data;
 		}
 	}
 	FileHelpers::WriteContentsToFile(path, _manifest.dump(1,'\t'));
 }
 
+// Replaces any string values in the blob that have an entry in the remap table
+static void RemapGuids(nlohmann::json& blob, const std::unordered_map<std::string, std::string>& remap) {
+	if (blob.is_string()) {
+		auto it = remap.find(blob.get_ref<const std::string&>());
+		if (it != remap.end()) {
+			blob = it->second;
+		}
+	} else if (blob.is_structured()) {
+		for (auto& child : blob) {
+			RemapGuids(child, remap);
+		}
+	}
+}
+
+size_t ResourceManager::CompactManifest(const std::string& manifestPath, const std::vector<std::string>& sceneFiles) {
+	nlohmann::json manifest = nlohmann::json::parse(FileHelpers::ReadFile(manifestPath));
+
+	// Maps removed GUIDs to the GUID of the resource that replaces them
+	std::unordered_map<std::string, std::string> remap;
+	size_t removed = 0;
+
+	// Merging resources can make the resources that reference them identical as well (ex: two
+	// materials using two copies of the same texture), so keep going until nothing changes
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (auto& [typeName, items] : manifest.items()) {
+			if (!items.is_object()) {
+				continue;
+			}
+
+			// Resources are the same if everything but their GUID matches
+			std::unordered_map<std::string, std::string> firstByContents;
+			std::vector<std::string> duplicates;
+			for (auto& [guid, data] : items.items()) {
+				nlohmann::json contents = data;
+				contents.erase("guid");
+				auto [it, isFirst] = firstByContents.emplace(contents.dump(), guid);
+				if (!isFirst) {
+					remap[guid] = it->second;
+					duplicates.push_back(guid);
+				}
+			}
+
+			for (const std::string& guid : duplicates) {
+				items.erase(guid);
+			}
+			removed += duplicates.size();
+			changed |= !duplicates.empty();
+		}
+
+		if (changed) {
+			// A resource we kept in an earlier pass may have been merged in this one
+			for (auto& [from, to] : remap) {
+				auto it = remap.find(to);
+				while (it != remap.end()) {
+					to = it->second;
+					it = remap.find(to);
+				}
+			}
+			RemapGuids(manifest, remap);
+		}
+	}
+
+	if (removed > 0) {
+		FileHelpers::WriteContentsToFile(manifestPath, manifest.dump(1, '\t'));
+		for (const std::string& sceneFile : sceneFiles) {
+			if (!std::filesystem::exists(sceneFile)) {
+				continue;
+			}
+			nlohmann::json scene = nlohmann::json::parse(FileHelpers::ReadFile(sceneFile));
+			RemapGuids(scene, remap);
+			FileHelpers::WriteContentsToFile(sceneFile, scene.dump(1, '\t'));
+		}
+		LOG_INFO("Removed {} duplicate resources from \"{}\"", removed, manifestPath);
+	}
+	return removed;
+}
+
 void ResourceManager::Cleanup() {
 	for (auto& [type, map] : _resources) {
 		map.clear();
 	}
+	_sources.clear();
 }
 
@@ -2,7 +2,7 @@
 
 #include <json.hpp>
 #include <unordered_map>
-#include <typeindex>
+#include <map>
 
 #include "Graphics/Texture2D.h";
 #include "Graphics/VertexArrayObject.h";
@@ -26,6 +26,10 @@ public:
 
 	/// <summary>
 	/// Creates a new asset, and forwards the arguments to it's constructor
+	/// 
+	/// If the asset is created from a single path (ex: CreateAsset<Texture2D>("image.png")), and an
+	/// asset of the same type has already been created from that path, the existing asset is
+	/// returned instead, so each file is only loaded once
 	/// </summary>
 	/// <typeparam name="T">The type of asset to create</typeparam>
 	/// <typeparam name="...TArgs">The types for the arguments to forward to the constructor</typeparam>
@@ -33,9 +37,24 @@ public:
 	/// <returns>The GUID of the newly created asset</returns>
 	template <typename T, typename ... TArgs, typename = std::enable_if<is_valid_resource<T>()>::type>
 	static std::shared_ptr<T> CreateAsset(TArgs&&... args) {
+		// If we've already loaded this source, share the existing asset
+		std::string source = _GetSourceKey(args...);
+		if (!source.empty()) {
+			auto it = _sources[T::TypeHash].find(source);
+			if (it != _sources[T::TypeHash].end()) {
+				std::shared_ptr<T> existing = Get<T>(it->second);
+				if (existing != nullptr) {
+					return existing;
+				}
+			}
+		}
+
 		// Create and store the asset
 		std::shared_ptr<T> asset = std::make_shared<T>(std::forward<TArgs>(args)...);
-		_resources[std::type_index(typeid(T))][asset->IResource::GetGUID()] = asset;
+		_resources[T::TypeHash][asset->IResource::GetGUID()] = asset;
+		if (!source.empty()) {
+			_sources[T::TypeHash][source] = asset->IResource::GetGUID();
+		}
 
 		// Get the JSON representation of the asset so we can store it in the manifest
 		nlohmann::json data = asset->ToJson();
@@ -45,7 +64,8 @@ public:
 		data["guid"] = guid;
 
 		// Store the JSON data in the resource manifest (based on the type's name)
-		_manifest[StringTools::SanitizeClassName(typeid(T).name())][guid] = data;
+		_typeNames[T::TypeHash] = T::TypeName;
+		_manifest[T::TypeName][guid] = data;
 		return asset;
 	}
 
@@ -57,32 +77,53 @@ public:
 	/// <returns>The resource with the given GUID, or nullptr if none exists</returns>
 	template<typename T, typename = std::enable_if<is_valid_resource<T>()>::type>
 	static std::shared_ptr<T> Get(Guid id) {
-		return std::dynamic_pointer_cast<T>(_resources[std::type_index(typeid(T))][id]);
+		return std::dynamic_pointer_cast<T>(_resources[T::TypeHash][id]);
 	}
 
 	/// <summary>
 	/// Registers a resource type with the resource manager, only types that have been registered
 	/// can be loaded from JSON manifest files!
+	/// 
+	/// Any resource types listed as dependencies will be loaded before this type when loading
+	/// a manifest (ex: materials need their shaders and textures to exist first)
 	/// </summary>
 	/// <typeparam name="T">The type to register, must satisfy the is_valid_resource constraint</typeparam>
-	/// <typeparam name=""></typeparam>
-	template <typename T, typename = std::enable_if<is_valid_resource<T>()>::type>
+	/// <typeparam name="...TDependencies">The resource types that T references</typeparam>
+	template <typename T, typename ... TDependencies>
 	static void RegisterType() {
-		// Extract the type name from a sanitized version of they typeid name
-		std::string typeName = StringTools::SanitizeClassName(typeid(T).name());
+		static_assert(is_valid_resource<T>(), "Type is not a valid resource type!");
+
+		// Types are keyed on the hash of their declared name (see MAKE_STATIC_TYPENAME)
+		LOG_ASSERT(_typeNames.find(T::TypeHash) == _typeNames.end() || strcmp(_typeNames[T::TypeHash], T::TypeName) == 0, "Resource type name hash collision for {}!", T::TypeName);
+		_typeNames[T::TypeHash] = T::TypeName;
 
 		// Create the type loader for the type
-		_typeLoaders[typeName] = [](const nlohmann::json& data) {
+		TypeLoader loader;
+		loader.Load = [](const nlohmann::json& data) {
 			IResource::Sptr res = T::FromJson(data);
 			res->OverrideGUID(Guid(data["guid"]));
-			_resources[std::type_index(typeid(T))][res->GetGUID()] = res;
+			_resources[T::TypeHash][res->GetGUID()] = res;
 			return res->GetGUID();
 		};
+		// If the type can do some of it's loading off the main thread, store that as well
+		if constexpr (test_prepare_json<T, const nlohmann::json&>::value) {
+			loader.Prepare = [](const nlohmann::json& data) { return T::PrepareFromJson(data); };
+		}
+		// Types that can be created from a single path (see CreateAsset) save that path as their
+		// filename, so that assets loaded from a manifest can be shared the same way
+		if constexpr (std::is_constructible<T, const std::string&>::value) {
+			loader.GetSource = [](const nlohmann::json& data) {
+				auto it = data.find("filename");
+				return (it != data.end() && it->is_string() && *it != "null") ? it->get<std::string>() : std::string();
+			};
+		}
+		loader.Dependencies = { TDependencies::TypeHash... };
+		_typeLoaders[T::TypeHash] = loader;
 
 		// Make sure we haven't registered the type yet, then add an empty object
 		// to the manifest to ensure it can be saved
-		if (!_manifest.contains(typeName)) {
-			_manifest[typeName] = nlohmann::json();
+		if (!_manifest.contains(T::TypeName)) {
+			_manifest[T::TypeName] = nlohmann::json();
 		}
 	}
 
@@ -91,7 +132,9 @@ public:
 	/// </summary>
 	static const nlohmann::json& GetManifest();
 	/// <summary>
-	/// Loads a manifest file into the resource manager
+	/// Loads a manifest file into the resource manager. Types that can be prepared off the
+	/// main thread will have their files loaded on a pool of worker threads, while OpenGL
+	/// objects are still created on the calling thread
 	/// </summary>
 	/// <param name="path">The path to the JSON manifest file</param>
 	static void LoadManifest(const std::string& path);
@@ -101,22 +144,81 @@ public:
 	/// <param name="path">The path to the file to output</param>
 	static void SaveManifest(const std::string& path);
 
+	/// <summary>
+	/// Merges resources in a manifest file that have identical contents (ex: the same texture
+	/// created many times), keeping the first GUID for each. Any references to the removed GUIDs
+	/// in the manifest and the given scene files are replaced, and the files are re-written if
+	/// anything changed
+	/// </summary>
+	/// <param name="manifestPath">The path to the JSON manifest file</param>
+	/// <param name="sceneFiles">The paths to scene files that reference resources in the manifest</param>
+	/// <returns>The number of resources that were removed from the manifest</returns>
+	static size_t CompactManifest(const std::string& manifestPath, const std::vector<std::string>& sceneFiles = {});
+
 	/// <summary>
 	/// Releases all resources held by the resource manager
 	/// </summary>
 	static void Cleanup();
 
 protected:
+	/// <summary>
+	/// Stores the functions needed to load a resource type from a manifest
+	/// </summary>
+	struct TypeLoader {
+		// Loads a resource on the main thread, and stores it in the resource map
+		std::function<Guid(const nlohmann::json&)> Load;
+		// Optional, performs the thread safe part of loading a resource
+		std::function<ResourceFinalizer(const nlohmann::json&)> Prepare;
+		// Optional, gets the path that CreateAsset would have shared the resource on
+		std::function<std::string(const nlohmann::json&)> GetSource;
+		// The type hashes of the resource types that need to be loaded first
+		std::vector<uint32_t> Dependencies;
+	};
+
 	/// <summary>
 	/// This is a map of maps
-	/// The top level map uses type_index, so there's a map per resource type
+	/// The top level map uses the type's name hash, so there's a map per resource type
 	/// The inner map handles mapping GUIDs to the corresponding resource
 	/// </summary>
-	static std::map<std::type_index, std::map<Guid, IResource::Sptr>> _resources;
+	static std::map<uint32_t, std::map<Guid, IResource::Sptr>> _resources;
 	/// <summary>
 	/// This map stores registered types, so we can load them from JSON files
 	/// </summary>
-	static std::map<std::string, std::function<Guid(const nlohmann::json&)>> _typeLoaders;
+	static std::map<uint32_t, TypeLoader> _typeLoaders;
+	/// <summary>
+	/// Maps the paths that assets were created from to their GUIDs, per type, so that
+	/// CreateAsset can share assets that have already been loaded
+	/// </summary>
+	static std::map<uint32_t, std::unordered_map<std::string, Guid>> _sources;
+	/// <summary>
+	/// Maps type name hashes back to the names, for writing the manifest
+	/// </summary>
+	static std::map<uint32_t, const char*> _typeNames;
 
 	static nlohmann::json _manifest;
+
+	/// <summary>
+	/// Gets the key to share assets on for the given constructor arguments, this is the path
+	/// if the asset is created from a single string, otherwise empty
+	/// </summary>
+	static std::string _GetSourceKey() { return ""; }
+	template <typename TArg>
+	static std::string _GetSourceKey(const TArg& arg) {
+		if constexpr (std::is_convertible<const TArg&, std::string>::value) {
+			return std::string(arg);
+		} else {
+			return "";
+		}
+	}
+	template <typename TArg0, typename TArg1, typename ... TArgs>
+	static std::string _GetSourceKey(const TArg0&, const TArg1&, const TArgs&...) { return ""; }
+
+	/// <summary>
+	/// Records the path a resource loaded from a manifest was created from, so that CreateAsset
+	/// will share it. If several resources came from the same path, the first one is kept
+	/// </summary>
+	/// <param name="type">The type hash of the resource</param>
+	/// <param name="data">The resource's entry in the manifest</param>
+	/// <param name="id">The GUID of the loaded resource</param>
+	static void _AddSource(uint32_t type, const nlohmann::json& data, Guid id);
 };
\ No newline at end of file
@@ -0,0 +1,46 @@
+#include "Utils/ThreadPool.h"
+
+ThreadPool::ThreadPool(size_t threadCount) :
+	_workers(std::vector<std::thread>()),
+	_jobs(std::queue<std::function<void()>>()),
+	_isStopping(false)
+{
+	if (threadCount == 0) {
+		// Leave a core for the main thread, it'll be busy with the results
+		unsigned int hardwareThreads = std::thread::hardware_concurrency();
+		threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+	}
+
+	_workers.reserve(threadCount);
+	for (size_t ix = 0; ix < threadCount; ix++) {
+		_workers.emplace_back(&ThreadPool::_WorkerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_isStopping = true;
+	}
+	_jobAdded.notify_all();
+	for (std::thread& worker : _workers) {
+		worker.join();
+	}
+}
+
+void ThreadPool::_WorkerLoop() {
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_jobAdded.wait(lock, [this]() { return _isStopping || !_jobs.empty(); });
+			// Only stop once we've run out of work
+			if (_jobs.empty()) {
+				return;
+			}
+			job = std::move(_jobs.front());
+			_jobs.pop();
+		}
+		job();
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+
+/// <summary>
+/// A simple pool of worker threads that run jobs in the order they are submitted.
+/// The workers are joined when the pool is destroyed, after finishing any queued jobs
+/// </summary>
+class ThreadPool {
+public:
+	/// <summary>
+	/// Creates a new thread pool
+	/// </summary>
+	/// <param name="threadCount">The number of workers to create, or 0 to use one less than the number of hardware threads</param>
+	ThreadPool(size_t threadCount = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool& other) = delete;
+	ThreadPool(ThreadPool&& other) = delete;
+	ThreadPool& operator=(const ThreadPool& other) = delete;
+	ThreadPool& operator=(ThreadPool&& other) = delete;
+
+	/// <summary>
+	/// Queues a job to run on one of the workers, any exceptions thrown by the job will be
+	/// re-thrown when getting the result from the future
+	/// </summary>
+	/// <param name="job">The function to run</param>
+	/// <returns>A future that will hold the result of the job</returns>
+	template <typename Func>
+	auto Submit(Func&& job) -> std::future<decltype(job())> {
+		typedef decltype(job()) ResultType;
+		// packaged_task is move only, but std::function needs to be copyable
+		std::shared_ptr<std::packaged_task<ResultType()>> task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<Func>(job));
+		std::future<ResultType> result = task->get_future();
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_jobs.push([task]() { (*task)(); });
+		}
+		_jobAdded.notify_one();
+		return result;
+	}
+
+	/// <summary>
+	/// Gets the number of worker threads in the pool
+	/// </summary>
+	size_t GetThreadCount() const { return _workers.size(); }
+
+protected:
+	std::vector<std::thread>          _workers;
+	std::queue<std::function<void()>> _jobs;
+	std::mutex                        _mutex;
+	std::condition_variable           _jobAdded;
+	bool                              _isStopping;
+
+	/// <summary>
+	/// The main loop for each worker thread, runs jobs until the pool is stopped
+	/// </summary>
+	void _WorkerLoop();
+};
@@ -1,4 +1,6 @@
 #pragma once
+#include <cstdint>
+#include <type_traits>
 
 template<class>
 struct sfinae_true : std::true_type {};
@@ -11,4 +13,33 @@ namespace detail {
 } // detail::
 
 template<class T, class Arg>
-struct test_json : decltype(detail::test_json<T, Arg>(0)){};
\ No newline at end of file
+struct test_json : decltype(detail::test_json<T, Arg>(0)){};
+
+namespace detail {
+	template<class T, class A0>
+	static auto test_prepare_json(int)->sfinae_true<decltype(T::PrepareFromJson(std::declval<A0>()))>;
+	template<class, class A0>
+	static auto test_prepare_json(long)->std::false_type;
+} // detail::
+
+template<class T, class Arg>
+struct test_prepare_json : decltype(detail::test_prepare_json<T, Arg>(0)){};
+
+/// <summary>
+/// Computes the 32 bit FNV-1a hash of a null terminated string, can be evaluated at compile time
+/// </summary>
+/// <param name="str">The string to hash</param>
+/// <param name="hash">The hash so far, leave as default</param>
+constexpr uint32_t const_hash_fnv1a(const char* str, uint32_t hash = 2166136261u) {
+	return *str ? const_hash_fnv1a(str + 1, (hash ^ static_cast<uint8_t>(*str)) * 16777619u) : hash;
+}
+
+/// <summary>
+/// Declares a stable name and hash for a type, for use in serialization and type lookups.
+/// The name should be the fully qualified name of the type (ex: Gameplay::MeshResource),
+/// which matches what older versions saved to disk. Unlike typeid names, these are the same
+/// no matter which compiler we are building with
+/// </summary>
+#define MAKE_STATIC_TYPENAME(T) \
+	static constexpr const char* TypeName = #T; \
+	static constexpr uint32_t    TypeHash = const_hash_fnv1a(#T);
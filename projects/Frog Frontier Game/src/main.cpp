@@ -41,8 +41,11 @@
 
 // Gameplay
 #include "Gameplay/Material.h"
+#include "Gameplay/AnimatedMeshResource.h"
 #include "Gameplay/GameObject.h"
 #include "Gameplay/Scene.h"
+#include "Gameplay/SceneCache.h"
+#include "Gameplay/RenderQueue.h"
 
 // Components
 #include "Gameplay/Components/IComponent.h"
@@ -51,6 +54,7 @@
 //#include "Gameplay/Components/JumpBehaviour.h"
 #include "Gameplay/Components/RenderComponent.h"
 #include "Gameplay/Components/MaterialSwapBehaviour.h"
+#include "Gameplay/Components/Animator.h"
 
 // Physics
 #include "Gameplay/Physics/RigidBody.h"
@@ -61,6 +65,7 @@
 #include "Gameplay/Physics/TriggerVolume.h"
 #include "Graphics/DebugDraw.h"
 #include "Gameplay/Physics/CollisionRect.h"
+#include "Gameplay/Physics/CollisionWorld2D.h"
 
 #include "fmod.hpp"
 
@@ -115,8 +120,11 @@ glm::ivec2 windowSize = glm::ivec2(1422, 800);
 // The title of our GLFW window
 std::string windowTitle = "Frog Frontier";
 
-std::vector<CollisionRect> collisions;
+// All the collision rects for every level, the player and moving obstacles are dynamic bodies
+CollisionWorld2D collisionWorld;
 CollisionRect playerCollision;
+// The rects near the player this frame, kept around so we don't allocate every frame
+std::vector<CollisionRect*> nearbyCollisions;
 
 // using namespace should generally be avoided, and if used, make sure it's ONLY in cpp files
 using namespace Gameplay;
@@ -125,6 +133,40 @@ using namespace Gameplay::Physics;
 // The scene that we will be rendering
 Scene::Sptr scene = nullptr;
 
+// Handles to the objects we look up every frame, these cache the lookup and will
+// re-resolve themselves whenever a different scene is loaded
+ObjectHandle playerHandle("player");
+ObjectHandle mainCameraHandle("Main Camera");
+ObjectHandle filterHandle("Filter");
+// The frog and bush that play the menu transition
+ObjectHandle frogBodyHandle("FrogBody");
+ObjectHandle frogHeadTopHandle("FrogHeadTop");
+ObjectHandle frogHeadBotHandle("FrogHeadBot");
+ObjectHandle frogTongueHandle("FrogTongue");
+ObjectHandle bushTransitionHandle("BushTransition");
+// The pause, lose and win menus, and the progress bar that follow the player
+ObjectHandle pausePanelHandle("PanelPause");
+ObjectHandle buttonBack1Handle("ButtonBack1");
+ObjectHandle buttonBack2Handle("ButtonBack2");
+ObjectHandle buttonBack3Handle("ButtonBack3");
+ObjectHandle resumeTextHandle("ResumeText");
+ObjectHandle replayTextHandle("ReplayText");
+ObjectHandle levelSelectTextHandle("LSText");
+ObjectHandle mainMenuTextHandle("MainMenuText");
+ObjectHandle pauseLogoHandle("PauseLogo");
+ObjectHandle loserLogoHandle("LoserLogo");
+ObjectHandle winnerLogoHandle("WinnerLogo");
+ObjectHandle progressBarHandle("ProgressBarGO");
+ObjectHandle progressBarProgressHandle("ProgressBarProgress");
+ObjectHandle movingObstacleHandle("Trigger2");
+
+// Collects and sorts our draws each frame, kept around so it can re-use it's memory
+RenderQueue renderQueue;
+// Instanced variant of our base shader, and the buffer we stream instance transforms through
+Shader::Sptr instancedShader = nullptr;
+VertexBuffer::Sptr instanceBuffer = nullptr;
+std::vector<InstanceTransform> instanceData;
+
 MeshResource::Sptr planeMesh;
 MeshResource::Sptr cubeMesh;
 MeshResource::Sptr mushroomMesh;
@@ -178,72 +220,58 @@ MeshResource::Sptr ExitTreeMesh;
 MeshResource::Sptr BGRockMesh;
 MeshResource::Sptr ExitRockMesh;
 
-//Running Animation
-MeshResource::Sptr runningMesh1;
-MeshResource::Sptr runningMesh2;
-MeshResource::Sptr runningMesh3;
-MeshResource::Sptr runningMesh4;
-MeshResource::Sptr runningMesh5;
-MeshResource::Sptr runningMesh6;
-MeshResource::Sptr runningMesh7;
-MeshResource::Sptr runningMesh8;
-MeshResource::Sptr runningMesh9;
-MeshResource::Sptr runningMesh10;
-MeshResource::Sptr runningMesh11;
-MeshResource::Sptr runningMesh12;
-MeshResource::Sptr runningMesh13;
-MeshResource::Sptr runningMesh14;
-MeshResource::Sptr runningMesh15;
-MeshResource::Sptr runningMesh16;
-MeshResource::Sptr runningMesh17;
-MeshResource::Sptr runningMesh18;
-
-//Flying Animation
-MeshResource::Sptr flyingMesh1;
-MeshResource::Sptr flyingMesh2;
-MeshResource::Sptr flyingMesh3;
-MeshResource::Sptr flyingMesh4;
-MeshResource::Sptr flyingMesh5;
-MeshResource::Sptr flyingMesh6;
-MeshResource::Sptr flyingMesh7;
-MeshResource::Sptr flyingMesh8;
-
-//Running Animation
-MeshResource::Sptr slidingMesh1;
-MeshResource::Sptr slidingMesh2;
-MeshResource::Sptr slidingMesh3;
-MeshResource::Sptr slidingMesh4;
-MeshResource::Sptr slidingMesh5;
-MeshResource::Sptr slidingMesh6;
-MeshResource::Sptr slidingMesh7;
-MeshResource::Sptr slidingMesh8;
-MeshResource::Sptr slidingMesh9;
-MeshResource::Sptr slidingMesh10;
-MeshResource::Sptr slidingMesh11;
-MeshResource::Sptr slidingMesh12;
-MeshResource::Sptr slidingMesh13;
-MeshResource::Sptr slidingMesh14;
-MeshResource::Sptr slidingMesh15;
-MeshResource::Sptr slidingMesh16;
-MeshResource::Sptr slidingMesh17;
-MeshResource::Sptr slidingMesh18;
-MeshResource::Sptr slidingMesh19;
-MeshResource::Sptr slidingMesh20;
-MeshResource::Sptr slidingMesh21;
-MeshResource::Sptr slidingMesh22;
-MeshResource::Sptr slidingMesh23;
-MeshResource::Sptr slidingMesh24;
-MeshResource::Sptr slidingMesh25;
-MeshResource::Sptr slidingMesh26;
-MeshResource::Sptr slidingMesh27;
-MeshResource::Sptr slidingMesh28;
+//Player Animations
+AnimatedMeshResource::Sptr ladybugAnimations;
+AnimatedMeshResource::Sptr flyingAnimations;
+
+// Sets up the state graph for the player's animations, keyboard() drives it with the "flying"
+// and "sliding" parameters. Flying is a different model, so it can't crossfade with the others
+void SetupPlayerAnimator(const Animator::Sptr& animator) {
+	animator->States = {
+		{ "running", ladybugAnimations, "running" },
+		{ "sliding", ladybugAnimations, "sliding" },
+		{ "flying",  flyingAnimations,  "flying" }
+	};
+	animator->Transitions = {
+		{ Animator::ANY_STATE, "flying",  { { "flying", true } } },
+		{ Animator::ANY_STATE, "sliding", { { "flying", false }, { "sliding", true } }, 0.1f },
+		{ Animator::ANY_STATE, "running", { { "flying", false }, { "sliding", false } }, 0.1f }
+	};
+	animator->Play("running");
+}
+
+// Keeps the menus and recently played levels loaded, so switching back to them is instant
+SceneCache sceneCache;
+
+// The scene files that ship with the game
+const std::vector<std::string> sceneFiles = { "menu.json", "LS.json", "CS.json", "Level.json", "Level1.json", "Level3.json", "level4.json", "Level5.json", "Level6.json" };
+
+// Scenes converted with --convert-scene are loaded from their binary copy, as long as it's newer
+// than the file it was converted from. Saving over the JSON version makes the binary one stale
+std::string GetScenePathToLoad(const std::string& path) {
+	std::string binaryPath = Scene::GetBinaryPath(path);
+	std::error_code error;
+	std::filesystem::file_time_type binaryTime = std::filesystem::last_write_time(binaryPath, error);
+	if (error) {
+		return path;
+	}
+	std::filesystem::file_time_type sourceTime = std::filesystem::last_write_time(path, error);
+	if (!error && sourceTime > binaryTime) {
+		return path;
+	}
+	return binaryPath;
+}
 
 int SceneLoad(Scene::Sptr& scene, std::string& path)
 {
+	// If the scene can't be loaded we keep the one we have, the cache has already logged why
+	Scene::Sptr loaded = sceneCache.Activate(GetScenePathToLoad(path), window);
+	if (loaded == nullptr) {
+		return false;
+	}
 	// Since it's a reference to a ptr, this will
 		// overwrite the existing scene!
-	scene = nullptr;
-	scene = Scene::Load(path);
+	scene = loaded;
 	std::cout << scene << std::endl << path << std::endl;
 
 
@@ -323,15 +351,15 @@ bool DrawSaveLoadImGui(Scene::Sptr& scene, std::string& path) {
 	// Draw a save button, and save when pressed
 	if (ImGui::Button("Save")) {
 		scene->Save(path);
+		// Make sure we load the new version of the file next time
+		sceneCache.Remove(path);
 	}
 	ImGui::SameLine();
 	// Load scene from file button
 	if (ImGui::Button("Load")) {
 		// Since it's a reference to a ptr, this will
 		// overwrite the existing scene!
-		SceneLoad(scene, path);
-
-		return true;
+		return SceneLoad(scene, path);
 	}
 
 
@@ -345,18 +373,36 @@ bool DrawSaveLoadImGui(Scene::Sptr& scene, std::string& path) {
 	//when timer completes sets value to true
 	//transition scene
 
-	if (glfwGetKey(window, GLFW_KEY_ENTER) && DoTransition == false && scene->FindObjectByName("Main Camera") != NULL && scene->FindObjectByName("Filter") != NULL && enterclick == false && (scenevalue == 11 || scenevalue == 12 || scenevalue == 13)) //menu
+	// Resolve the objects the menus use up front, the scene doesn't change until one of the branches below loads a new one
+	GameObject::Sptr player         = playerHandle.Get(scene);
+	GameObject::Sptr mainCamera     = mainCameraHandle.Get(scene);
+	GameObject::Sptr filter         = filterHandle.Get(scene);
+	// Only the menus have the transition objects, so we only resolve them there or while a transition is playing
+	GameObject::Sptr frogBody       = nullptr;
+	GameObject::Sptr frogHeadTop    = nullptr;
+	GameObject::Sptr frogHeadBot    = nullptr;
+	GameObject::Sptr frogTongue     = nullptr;
+	GameObject::Sptr bushTransition = nullptr;
+	if (DoTransition == true || (mainCamera != nullptr && filter != nullptr && (scenevalue == 11 || scenevalue == 12 || scenevalue == 13))) {
+		frogBody       = frogBodyHandle.Get(scene);
+		frogHeadTop    = frogHeadTopHandle.Get(scene);
+		frogHeadBot    = frogHeadBotHandle.Get(scene);
+		frogTongue     = frogTongueHandle.Get(scene);
+		bushTransition = bushTransitionHandle.Get(scene);
+	}
+
+	if (glfwGetKey(window, GLFW_KEY_ENTER) && DoTransition == false && mainCamera != nullptr && filter != nullptr && enterclick == false && (scenevalue == 11 || scenevalue == 12 || scenevalue == 13)) //menu
 	{
 		DoTransition = true;
 		transitiontimer = glfwGetTime() + 2.0;
 		transitioncomplete = false;
 		//	scene->FindObjectByName("FrogBody")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x - 0.2f, scene->FindObjectByName("Main Camera")->GetPosition().y, scene->FindObjectByName("Main Camera")->GetPosition().z - 1.4));
 
-		scene->FindObjectByName("FrogBody")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x - 3.4, scene->FindObjectByName("Main Camera")->GetPosition().y - 1.05, scene->FindObjectByName("Main Camera")->GetPosition().z - 1.4));
-		scene->FindObjectByName("FrogHeadTop")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x - 3.4, scene->FindObjectByName("Main Camera")->GetPosition().y - 1.05, scene->FindObjectByName("Main Camera")->GetPosition().z - 1.38));
-		scene->FindObjectByName("FrogHeadBot")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x - 3.4, scene->FindObjectByName("Main Camera")->GetPosition().y - 1.05, scene->FindObjectByName("Main Camera")->GetPosition().z - 1.39));
-		scene->FindObjectByName("FrogTongue")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x - 3.4, scene->FindObjectByName("Main Camera")->GetPosition().y - 1.05, scene->FindObjectByName("Main Camera")->GetPosition().z - 1.41));
-		scene->FindObjectByName("BushTransition")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x + 5, scene->FindObjectByName("Main Camera")->GetPosition().y, scene->FindObjectByName("Main Camera")->GetPosition().z - 1.2));
+		frogBody->SetPostion(glm::vec3(mainCamera->GetPosition().x - 3.4, mainCamera->GetPosition().y - 1.05, mainCamera->GetPosition().z - 1.4));
+		frogHeadTop->SetPostion(glm::vec3(mainCamera->GetPosition().x - 3.4, mainCamera->GetPosition().y - 1.05, mainCamera->GetPosition().z - 1.38));
+		frogHeadBot->SetPostion(glm::vec3(mainCamera->GetPosition().x - 3.4, mainCamera->GetPosition().y - 1.05, mainCamera->GetPosition().z - 1.39));
+		frogTongue->SetPostion(glm::vec3(mainCamera->GetPosition().x - 3.4, mainCamera->GetPosition().y - 1.05, mainCamera->GetPosition().z - 1.41));
+		bushTransition->SetPostion(glm::vec3(mainCamera->GetPosition().x + 5, mainCamera->GetPosition().y, mainCamera->GetPosition().z - 1.2));
 	}
 	/*
 	if (glfwGetKey(window, GLFW_KEY_ENTER) && DoTransition == false && scene->FindObjectByName("Main Camera") != NULL && scene->FindObjectByName("Filter") != NULL && enterclick == false && (scenevalue == 1 || scenevalue == 2 || scenevalue == 3) && (index == 2|| index == 3) && (paused == true || playerLose == true || playerWin == true)) //menu
@@ -383,87 +429,87 @@ bool DrawSaveLoadImGui(Scene::Sptr& scene, std::string& path) {
 			transitionleft = transitiontimer - glfwGetTime();
 			if (transitionleft >= 1.68 && transitionleft <= 2.0) //start jump
 			{
-				scene->FindObjectByName("FrogBody")->SetPostion(glm::vec3(scene->FindObjectByName("FrogBody")->GetPosition().x + 0.04051f, scene->FindObjectByName("FrogBody")->GetPosition().y + 0.015625, scene->FindObjectByName("FrogBody")->GetPosition().z));
-				scene->FindObjectByName("FrogHeadTop")->SetPostion(glm::vec3(scene->FindObjectByName("FrogHeadTop")->GetPosition().x + 0.04051f, scene->FindObjectByName("FrogHeadTop")->GetPosition().y + 0.015625, scene->FindObjectByName("FrogHeadTop")->GetPosition().z));
-				scene->FindObjectByName("FrogHeadBot")->SetPostion(glm::vec3(scene->FindObjectByName("FrogHeadBot")->GetPosition().x + 0.04051f, scene->FindObjectByName("FrogHeadBot")->GetPosition().y + 0.015625, scene->FindObjectByName("FrogHeadBot")->GetPosition().z));
-				scene->FindObjectByName("FrogTongue")->SetPostion(glm::vec3(scene->FindObjectByName("FrogTongue")->GetPosition().x + 0.04051f, scene->FindObjectByName("FrogTongue")->GetPosition().y + 0.015625, scene->FindObjectByName("FrogTongue")->GetPosition().z));
+				frogBody->SetPostion(glm::vec3(frogBody->GetPosition().x + 0.04051f, frogBody->GetPosition().y + 0.015625, frogBody->GetPosition().z));
+				frogHeadTop->SetPostion(glm::vec3(frogHeadTop->GetPosition().x + 0.04051f, frogHeadTop->GetPosition().y + 0.015625, frogHeadTop->GetPosition().z));
+				frogHeadBot->SetPostion(glm::vec3(frogHeadBot->GetPosition().x + 0.04051f, frogHeadBot->GetPosition().y + 0.015625, frogHeadBot->GetPosition().z));
+				frogTongue->SetPostion(glm::vec3(frogTongue->GetPosition().x + 0.04051f, frogTongue->GetPosition().y + 0.015625, frogTongue->GetPosition().z));
 
-				scene->FindObjectByName("FrogBody")->SetScale(glm::vec3(1.5f, scene->FindObjectByName("FrogBody")->GetScale().y - 0.0052, 1.0f));
-				scene->FindObjectByName("FrogHeadTop")->SetScale(glm::vec3(1.5f, scene->FindObjectByName("FrogHeadTop")->GetScale().y - 0.0052, 1.0f));
-				scene->FindObjectByName("FrogHeadBot")->SetScale(glm::vec3(1.5f, scene->FindObjectByName("FrogHeadBot")->GetScale().y - 0.0052, 1.0f));
+				frogBody->SetScale(glm::vec3(1.5f, frogBody->GetScale().y - 0.0052, 1.0f));
+				frogHeadTop->SetScale(glm::vec3(1.5f, frogHeadTop->GetScale().y - 0.0052, 1.0f));
+				frogHeadBot->SetScale(glm::vec3(1.5f, frogHeadBot->GetScale().y - 0.0052, 1.0f));
 			}
 			else if (transitionleft >= 1.44) // start falling
 			{
-				scene->FindObjectByName("FrogBody")->SetPostion(glm::vec3(scene->FindObjectByName("FrogBody")->GetPosition().x + 0.04051f, scene->FindObjectByName("FrogBody")->GetPosition().y - 0.015625, scene->FindObjectByName("FrogBody")->GetPosition().z));
-				scene->FindObjectByName("FrogHeadTop")->SetPostion(glm::vec3(scene->FindObjectByName("FrogHeadTop")->GetPosition().x + 0.04051f, scene->FindObjectByName("FrogHeadTop")->GetPosition().y - 0.015625, scene->FindObjectByName("FrogHeadTop")->GetPosition().z));
-				scene->FindObjectByName("FrogHeadBot")->SetPostion(glm::vec3(scene->FindObjectByName("FrogHeadBot")->GetPosition().x + 0.04051f, scene->FindObjectByName("FrogHeadBot")->GetPosition().y - 0.015625, scene->FindObjectByName("FrogHeadBot")->GetPosition().z));
-				scene->FindObjectByName("FrogTongue")->SetPostion(glm::vec3(scene->FindObjectByName("FrogTongue")->GetPosition().x + 0.04051f, scene->FindObjectByName("FrogTongue")->GetPosition().y - 0.015625, scene->FindObjectByName("FrogTongue")->GetPosition().z));
+				frogBody->SetPostion(glm::vec3(frogBody->GetPosition().x + 0.04051f, frogBody->GetPosition().y - 0.015625, frogBody->GetPosition().z));
+				frogHeadTop->SetPostion(glm::vec3(frogHeadTop->GetPosition().x + 0.04051f, frogHeadTop->GetPosition().y - 0.015625, frogHeadTop->GetPosition().z));
+				frogHeadBot->SetPostion(glm::vec3(frogHeadBot->GetPosition().x + 0.04051f, frogHeadBot->GetPosition().y - 0.015625, frogHeadBot->GetPosition().z));
+				frogTongue->SetPostion(glm::vec3(frogTongue->GetPosition().x + 0.04051f, frogTongue->GetPosition().y - 0.015625, frogTongue->GetPosition().z));
 
-				scene->FindObjectByName("FrogBody")->SetScale(glm::vec3(1.5f, scene->FindObjectByName("FrogBody")->GetScale().y - 0.0052, 1.0f));
-				scene->FindObjectByName("FrogHeadTop")->SetScale(glm::vec3(1.5f, scene->FindObjectByName("FrogHeadTop")->GetScale().y - 0.0052, 1.0f));
-				scene->FindObjectByName("FrogHeadBot")->SetScale(glm::vec3(1.5f, scene->FindObjectByName("FrogHeadBot")->GetScale().y - 0.0052, 1.0f));
+				frogBody->SetScale(glm::vec3(1.5f, frogBody->GetScale().y - 0.0052, 1.0f));
+				frogHeadTop->SetScale(glm::vec3(1.5f, frogHeadTop->GetScale().y - 0.0052, 1.0f));
+				frogHeadBot->SetScale(glm::vec3(1.5f, frogHeadBot->GetScale().y - 0.0052, 1.0f));
 			}
 			else if (transitionleft >= 1.36) //squish land
 			{
-				scene->FindObjectByName("FrogBody")->SetPostion(glm::vec3(scene->FindObjectByName("FrogBody")->GetPosition().x, scene->FindObjectByName("FrogBody")->GetPosition().y - 0.015625, scene->FindObjectByName("FrogBody")->GetPosition().z));
-				scene->FindObjectByName("FrogHeadTop")->SetPostion(glm::vec3(scene->FindObjectByName("FrogHeadTop")->GetPosition().x, scene->FindObjectByName("FrogHeadTop")->GetPosition().y - 0.015625, scene->FindObjectByName("FrogHeadTop")->GetPosition().z));
-				scene->FindObjectByName("FrogHeadBot")->SetPostion(glm::vec3(scene->FindObjectByName("FrogHeadBot")->GetPosition().x, scene->FindObjectByName("FrogHeadBot")->GetPosition().y - 0.015625, scene->FindObjectByName("FrogHeadBot")->GetPosition().z));
-				scene->FindObjectByName("FrogTongue")->SetPostion(glm::vec3(scene->FindObjectByName("FrogTongue")->GetPosition().x, scene->FindObjectByName("FrogTongue")->GetPosition().y - 0.015625, scene->FindObjectByName("FrogTongue")->GetPosition().z));
+				frogBody->SetPostion(glm::vec3(frogBody->GetPosition().x, frogBody->GetPosition().y - 0.015625, frogBody->GetPosition().z));
+				frogHeadTop->SetPostion(glm::vec3(frogHeadTop->GetPosition().x, frogHeadTop->GetPosition().y - 0.015625, frogHeadTop->GetPosition().z));
+				frogHeadBot->SetPostion(glm::vec3(frogHeadBot->GetPosition().x, frogHeadBot->GetPosition().y - 0.015625, frogHeadBot->GetPosition().z));
+				frogTongue->SetPostion(glm::vec3(frogTongue->GetPosition().x, frogTongue->GetPosition().y - 0.015625, frogTongue->GetPosition().z));
 
-				scene->FindObjectByName("FrogBody")->SetScale(glm::vec3(1.5f, scene->FindObjectByName("FrogBody")->GetScale().y - 0.0052, 1.0f));
-				scene->FindObjectByName("FrogHeadTop")->SetScale(glm::vec3(1.5f, scene->FindObjectByName("FrogHeadTop")->GetScale().y - 0.0052, 1.0f));
-				scene->FindObjectByName("FrogHeadBot")->SetScale(glm::vec3(1.5f, scene->FindObjectByName("FrogHeadBot")->GetScale().y - 0.0052, 1.0f));
+				frogBody->SetScale(glm::vec3(1.5f, frogBody->GetScale().y - 0.0052, 1.0f));
+				frogHeadTop->SetScale(glm::vec3(1.5f, frogHeadTop->GetScale().y - 0.0052, 1.0f));
+				frogHeadBot->SetScale(glm::vec3(1.5f, frogHeadBot->GetScale().y - 0.0052, 1.0f));
 
 			}
 			else if (transitionleft >= 1.28) //standing
 			{
-				scene->FindObjectByName("FrogBody")->SetPostion(glm::vec3(scene->FindObjectByName("FrogBody")->GetPosition().x, scene->FindObjectByName("FrogBody")->GetPosition().y + 0.015625, scene->FindObjectByName("FrogBody")->GetPosition().z));
-				scene->FindObjectByName("FrogHeadTop")->SetPostion(glm::vec3(scene->FindObjectByName("FrogHeadTop")->GetPosition().x, scene->FindObjectByName("FrogHeadTop")->GetPosition().y + 0.015625, scene->FindObjectByName("FrogHeadTop")->GetPosition().z));
-				scene->FindObjectByName("FrogHeadBot")->SetPostion(glm::vec3(scene->FindObjectByName("FrogHeadBot")->GetPosition().x, scene->FindObjectByName("FrogHeadBot")->GetPosition().y + 0.015625, scene->FindObjectByName("FrogHeadBot")->GetPosition().z));
-				scene->FindObjectByName("FrogTongue")->SetPostion(glm::vec3(scene->FindObjectByName("FrogTongue")->GetPosition().x, scene->FindObjectByName("FrogTongue")->GetPosition().y + 0.015625, scene->FindObjectByName("FrogTongue")->GetPosition().z));
+				frogBody->SetPostion(glm::vec3(frogBody->GetPosition().x, frogBody->GetPosition().y + 0.015625, frogBody->GetPosition().z));
+				frogHeadTop->SetPostion(glm::vec3(frogHeadTop->GetPosition().x, frogHeadTop->GetPosition().y + 0.015625, frogHeadTop->GetPosition().z));
+				frogHeadBot->SetPostion(glm::vec3(frogHeadBot->GetPosition().x, frogHeadBot->GetPosition().y + 0.015625, frogHeadBot->GetPosition().z));
+				frogTongue->SetPostion(glm::vec3(frogTongue->GetPosition().x, frogTongue->GetPosition().y + 0.015625, frogTongue->GetPosition().z));
 				//scaleup
 
-				scene->FindObjectByName("FrogBody")->SetScale(glm::vec3(1.5f, scene->FindObjectByName("FrogBody")->GetScale().y + 0.046875, 1.0f));
-				scene->FindObjectByName("FrogHeadTop")->SetScale(glm::vec3(1.5f, scene->FindObjectByName("FrogHeadTop")->GetScale().y + 0.046875, 1.0f));
-				scene->FindObjectByName("FrogHeadBot")->SetScale(glm::vec3(1.5f, scene->FindObjectByName("FrogHeadBot")->GetScale().y + 0.046875, 1.0f));
+				frogBody->SetScale(glm::vec3(1.5f, frogBody->GetScale().y + 0.046875, 1.0f));
+				frogHeadTop->SetScale(glm::vec3(1.5f, frogHeadTop->GetScale().y + 0.046875, 1.0f));
+				frogHeadBot->SetScale(glm::vec3(1.5f, frogHeadBot->GetScale().y + 0.046875, 1.0f));
 			}
 			else if (transitionleft >= 1.2) //tongue out
 			{
-				scene->FindObjectByName("FrogHeadBot")->SetRotation(glm::vec3(0.0f, 0.0f, scene->FindObjectByName("FrogHeadBot")->GetRotation().z - 18));
-				scene->FindObjectByName("FrogTongue")->SetRotation(glm::vec3(0.0f, 0.0f, 18.0f));
-				scene->FindObjectByName("FrogTongue")->SetScale(glm::vec3(scene->FindObjectByName("FrogTongue")->GetScale().x + 4.5, 0.1, 1));
+				frogHeadBot->SetRotation(glm::vec3(0.0f, 0.0f, frogHeadBot->GetRotation().z - 18));
+				frogTongue->SetRotation(glm::vec3(0.0f, 0.0f, 18.0f));
+				frogTongue->SetScale(glm::vec3(frogTongue->GetScale().x + 4.5, 0.1, 1));
 				//mouth open
 				//tongue starts going
 			}
 			else if (transitionleft >= 1.0) //tongue grabbed
 			{
-				scene->FindObjectByName("FrogTongue")->SetScale(glm::vec3(scene->FindObjectByName("FrogTongue")->GetScale().x + 0.2375, 0.1, 1));
+				frogTongue->SetScale(glm::vec3(frogTongue->GetScale().x + 0.2375, 0.1, 1));
 				//body doesnt move
 				//tongue reaches other side of screen
 			}
 			else if (transitionleft >= 0.76) //tongue pulling
 			{
-				scene->FindObjectByName("BushTransition")->SetPostion(glm::vec3(scene->FindObjectByName("BushTransition")->GetPosition().x - 0.07, 0, 3.8));
+				bushTransition->SetPostion(glm::vec3(bushTransition->GetPosition().x - 0.07, 0, 3.8));
 				std::cout << "initial move";
 				//body doesnt move
 				//bush transition starts moving
 			}
 			else if (transitionleft >= 0.2) //tongue pulled
 			{
-				scene->FindObjectByName("FrogBody")->SetPostion(glm::vec3(scene->FindObjectByName("FrogBody")->GetPosition().x - 0.05, scene->FindObjectByName("FrogBody")->GetPosition().y, scene->FindObjectByName("FrogBody")->GetPosition().z));
-				scene->FindObjectByName("FrogHeadTop")->SetPostion(glm::vec3(scene->FindObjectByName("FrogHeadTop")->GetPosition().x - 0.05, scene->FindObjectByName("FrogHeadTop")->GetPosition().y, scene->FindObjectByName("FrogHeadTop")->GetPosition().z));
-				scene->FindObjectByName("FrogHeadBot")->SetPostion(glm::vec3(scene->FindObjectByName("FrogHeadBot")->GetPosition().x - 0.05, scene->FindObjectByName("FrogHeadBot")->GetPosition().y, scene->FindObjectByName("FrogHeadBot")->GetPosition().z));
-				scene->FindObjectByName("FrogTongue")->SetPostion(glm::vec3(scene->FindObjectByName("FrogTongue")->GetPosition().x - 0.05, scene->FindObjectByName("FrogTongue")->GetPosition().y, scene->FindObjectByName("FrogTongue")->GetPosition().z));
+				frogBody->SetPostion(glm::vec3(frogBody->GetPosition().x - 0.05, frogBody->GetPosition().y, frogBody->GetPosition().z));
+				frogHeadTop->SetPostion(glm::vec3(frogHeadTop->GetPosition().x - 0.05, frogHeadTop->GetPosition().y, frogHeadTop->GetPosition().z));
+				frogHeadBot->SetPostion(glm::vec3(frogHeadBot->GetPosition().x - 0.05, frogHeadBot->GetPosition().y, frogHeadBot->GetPosition().z));
+				frogTongue->SetPostion(glm::vec3(frogTongue->GetPosition().x - 0.05, frogTongue->GetPosition().y, frogTongue->GetPosition().z));
 
-				scene->FindObjectByName("FrogTongue")->SetScale(glm::vec3(scene->FindObjectByName("FrogTongue")->GetScale().x - 0.36, 0.1, 1));
-				scene->FindObjectByName("BushTransition")->SetPostion(glm::vec3(scene->FindObjectByName("BushTransition")->GetPosition().x - 0.12, 0, 3.8));
+				frogTongue->SetScale(glm::vec3(frogTongue->GetScale().x - 0.36, 0.1, 1));
+				bushTransition->SetPostion(glm::vec3(bushTransition->GetPosition().x - 0.12, 0, 3.8));
 				//body slides offscreen
 				//almost blackout
 				std::cout << "tongue pulled";
 			}
 			else if (transitionleft > 0.0) //finshing
 			{
-				scene->FindObjectByName("BushTransition")->SetPostion(glm::vec3(scene->FindObjectByName("BushTransition")->GetPosition().x - 0.05, 0, 3.8));
+				bushTransition->SetPostion(glm::vec3(bushTransition->GetPosition().x - 0.05, 0, 3.8));
 				std::cout << "finish";
 				//complete blackout
 			}
@@ -477,7 +523,7 @@ bool DrawSaveLoadImGui(Scene::Sptr& scene, std::string& path) {
 		}
 	}
 
-	if (DoTransition == true && transitioncomplete == true && scene->FindObjectByName("player") == NULL && scene->FindObjectByName("Filter") != NULL && enterclick == false && scenevalue == 11) //menu
+	if (DoTransition == true && transitioncomplete == true && player == nullptr && filter != nullptr && enterclick == false && scenevalue == 11) //menu
 	{
 		switch (index) {
 		case 1:
@@ -505,7 +551,7 @@ bool DrawSaveLoadImGui(Scene::Sptr& scene, std::string& path) {
 		enterclick = true;
 		return true;
 	}
-	else if (glfwGetKey(window, GLFW_KEY_ENTER) && scene->FindObjectByName("player") == NULL && scene->FindObjectByName("Filter") == NULL && enterclick == false && scenevalue == 12) //controls
+	else if (glfwGetKey(window, GLFW_KEY_ENTER) && player == nullptr && filter == nullptr && enterclick == false && scenevalue == 12) //controls
 	{
 		path = "menu.json";
 		SceneLoad(scene, path);
@@ -515,7 +561,7 @@ bool DrawSaveLoadImGui(Scene::Sptr& scene, std::string& path) {
 		DoTransition = false;
 		return true;
 	}
-	else if (glfwGetKey(window, GLFW_KEY_ENTER) && scene->FindObjectByName("player") == NULL && scene->FindObjectByName("Filter") != NULL && enterclick == false && scenevalue == 13) // level select
+	else if (glfwGetKey(window, GLFW_KEY_ENTER) && player == nullptr && filter != nullptr && enterclick == false && scenevalue == 13) // level select
 	{
 		switch (index) {
 		case 1:
@@ -579,7 +625,7 @@ bool DrawSaveLoadImGui(Scene::Sptr& scene, std::string& path) {
 		return true;
 	}
 
-	if (glfwGetKey(window, GLFW_KEY_ENTER) && scene->FindObjectByName("player") != NULL && (paused == true || playerLose == true || playerWin == true) && enterclick == false) //pause
+	if (glfwGetKey(window, GLFW_KEY_ENTER) && player != nullptr && (paused == true || playerLose == true || playerWin == true) && enterclick == false) //pause
 	{
 		if (index == 2)
 		{
@@ -682,8 +728,10 @@ GameObject::Sptr createCollision(std::string num, float x, float z, float xscale
 	MeshResource::Sptr cubeMesh = ResourceManager::CreateAsset<MeshResource>("cube.obj");
 	Texture2D::Sptr    BlankTex = ResourceManager::CreateAsset<Texture2D>("textures/blank.png");
 
-	Material::Sptr BlankMaterial = ResourceManager::CreateAsset<Material>();
-	{
+	// All the collision objects can share one material, we only need a new one if the scene's shader changed
+	static Material::Sptr BlankMaterial = nullptr;
+	if (BlankMaterial == nullptr || BlankMaterial->MatShader != scene->BaseShader) {
+		BlankMaterial = ResourceManager::CreateAsset<Material>();
 		BlankMaterial->Name = "Blank";
 		BlankMaterial->MatShader = scene->BaseShader;
 		BlankMaterial->Texture = BlankTex;
@@ -701,7 +749,7 @@ GameObject::Sptr createCollision(std::string num, float x, float z, float xscale
 		renderer->SetMesh(cubeMesh);
 		renderer->SetMaterial(BlankMaterial);
 
-		collisions.push_back(CollisionRect(nextObstacle->GetPosition(), xscale, yscale, std::stoi(num)));
+		collisionWorld.AddStatic(CollisionRect(nextObstacle->GetPosition(), xscale, yscale, std::stoi(num)));
 
 		return nextObstacle;
 	}
@@ -726,25 +774,15 @@ float JTemp = 0;
 float PTime = 0;
 float PTemp = 0;
 float PTemp2 = 0;
-float runAnimTemp2 = 0;
-float AnimTime = 0;
 float runLoopNumber = 1; //number of times run animation has looped, we multiply this by 1.05 so we can return runAnimTime to 0 and repeat the Animation
-float FPSIncrease = 0.0; //gradually will increase so we can continue to play animations
-float runAnimTemp = 0;
 float FTime = 0;
 float FTemp = 0;
 float FResetTime = 0;
 float FResetTemp = 0;
 float RemainingFTime = 0;
 bool playerJumping = false;
-bool runningAnim = true;
 bool loadMeshOnce = true;
 float animIntervals = 0;
-int animFrame = 0;
-
-bool running = true;
-bool sliding = false;
-bool flying = false;
 
 
 
@@ -753,6 +791,8 @@ bool flying = false;
 // currently used for testing
 void SceneChanger()
 {
+	GameObject::Sptr filter = filterHandle.Get(scene);
+
 	if (scenevalue == 11)
 	{
 		PTime = 0;
@@ -894,21 +934,21 @@ void SceneChanger()
 		performedtask = false;
 	}
 
-	if (scene->FindObjectByName("Filter") != NULL)
+	if (filter != nullptr)
 	{
 		if (scenevalue == 11)
 		{
 			if (index == 1)
 			{
-				scene->FindObjectByName("Filter")->SetPostion(glm::vec3(1.75f, 0.1f, 3.01f));
+				filter->SetPostion(glm::vec3(1.75f, 0.1f, 3.01f));
 			}
 			else if (index == 2)
 			{
-				scene->FindObjectByName("Filter")->SetPostion(glm::vec3(1.75f, -0.35f, 3.01f));
+				filter->SetPostion(glm::vec3(1.75f, -0.35f, 3.01f));
 			}
 			else if (index == 3)
 			{
-				scene->FindObjectByName("Filter")->SetPostion(glm::vec3(1.75f, -0.8f, 3.01f));
+				filter->SetPostion(glm::vec3(1.75f, -0.8f, 3.01f));
 			}
 		}
 
@@ -917,38 +957,38 @@ void SceneChanger()
 
 			if (index == 1)
 			{
-				scene->FindObjectByName("Filter")->SetPostion(glm::vec3(0.7f, 0.4f, 3.01f));
-				scene->FindObjectByName("Filter")->SetScale(glm::vec3(0.7f));
+				filter->SetPostion(glm::vec3(0.7f, 0.4f, 3.01f));
+				filter->SetScale(glm::vec3(0.7f));
 			}
 			else if (index == 2)
 			{
-				scene->FindObjectByName("Filter")->SetPostion(glm::vec3(0.7f, -0.4f, 3.01f));
-				scene->FindObjectByName("Filter")->SetScale(glm::vec3(0.7f));
+				filter->SetPostion(glm::vec3(0.7f, -0.4f, 3.01f));
+				filter->SetScale(glm::vec3(0.7f));
 			}
 			else if (index == 3)
 			{
-				scene->FindObjectByName("Filter")->SetPostion(glm::vec3(1.6f, 0.4f, 3.01f));
-				scene->FindObjectByName("Filter")->SetScale(glm::vec3(0.7f));
+				filter->SetPostion(glm::vec3(1.6f, 0.4f, 3.01f));
+				filter->SetScale(glm::vec3(0.7f));
 			}
 			else if (index == 4)
 			{
-				scene->FindObjectByName("Filter")->SetPostion(glm::vec3(1.6f, -0.4f, 3.01f));
-				scene->FindObjectByName("Filter")->SetScale(glm::vec3(0.7f));
+				filter->SetPostion(glm::vec3(1.6f, -0.4f, 3.01f));
+				filter->SetScale(glm::vec3(0.7f));
 			}
 			else if (index == 5)
 			{
-				scene->FindObjectByName("Filter")->SetPostion(glm::vec3(2.5f, 0.4f, 3.01f));
-				scene->FindObjectByName("Filter")->SetScale(glm::vec3(0.7f));
+				filter->SetPostion(glm::vec3(2.5f, 0.4f, 3.01f));
+				filter->SetScale(glm::vec3(0.7f));
 			}
 			else if (index == 6)
 			{
-				scene->FindObjectByName("Filter")->SetPostion(glm::vec3(2.5f, -0.4f, 3.01f));
-				scene->FindObjectByName("Filter")->SetScale(glm::vec3(0.7f));
+				filter->SetPostion(glm::vec3(2.5f, -0.4f, 3.01f));
+				filter->SetScale(glm::vec3(0.7f));
 			}
 			else if (index == 7)
 			{
-				scene->FindObjectByName("Filter")->SetPostion(glm::vec3(1.75f, -1.f, 3.01f));
-				scene->FindObjectByName("Filter")->SetScale(glm::vec3(2.f, 0.4, 0.5));
+				filter->SetPostion(glm::vec3(1.75f, -1.f, 3.01f));
+				filter->SetScale(glm::vec3(2.f, 0.4, 0.5));
 			}
 		}
 	}
@@ -995,6 +1035,8 @@ void quickSort(std::vector<float>& arrayToSort, int low, int high) { //low == fi
 
 void keyboard()
 {
+	GameObject::Sptr player = playerHandle.Get(scene);
+
 	//Loads Keyframes for animations
 	//if (loadMeshOnce) {
 	//}
@@ -1092,8 +1134,6 @@ void keyboard()
 
 	if (paused == false)
 	{
-		//runningAnim = true;
-
 		//to time the time the player took to beat the level (while ingame)
 		if (playerPlaying == true) {
 			PTime = glfwGetTime() - PTemp;
@@ -1110,19 +1150,16 @@ void keyboard()
 		{
 			if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS) {
 				playerSliding = true;
-				running = false;
-				flying = false;
-				sliding = true;
-				scene->FindObjectByName("player")->SetScale(glm::vec3(0.5f, 0.25f, 0.5f));
+				player->SetScale(glm::vec3(0.5f, 0.25f, 0.5f));
 			}
 			else {
 				playerSliding = false;
-				scene->FindObjectByName("player")->SetScale(glm::vec3(0.5f, 0.5f, 0.5f));
+				player->SetScale(glm::vec3(0.5f, 0.5f, 0.5f));
 			}
 		}
 
 		if (playerMove == true) {
-			scene->FindObjectByName("player")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 0.2f, scene->FindObjectByName("player")->GetPosition().y, scene->FindObjectByName("player")->GetPosition().z)); // makes the player move
+			player->SetPostion(glm::vec3(player->GetPosition().x - 0.2f, player->GetPosition().y, player->GetPosition().z)); // makes the player move
 		}
 
 		//Fly Code
@@ -1140,10 +1177,6 @@ void keyboard()
 
 			//Timer
 			if (playerFlying == true) {
-				running = false;
-				sliding = false;
-				flying = true;
-
 				FTime = glfwGetTime() - FTemp + RemainingFTime;
 				FTime = (FTime / 2.5) * 8;
 			}
@@ -1160,11 +1193,11 @@ void keyboard()
 				FResetTemp = glfwGetTime();
 			}
 
-			if (scene->FindObjectByName("player")->GetPosition().z < 10.1 && playerFlying == true) {
-				scene->FindObjectByName("player")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x, scene->FindObjectByName("player")->GetPosition().y, scene->FindObjectByName("player")->GetPosition().z + 0.6));
+			if (player->GetPosition().z < 10.1 && playerFlying == true) {
+				player->SetPostion(glm::vec3(player->GetPosition().x, player->GetPosition().y, player->GetPosition().z + 0.6));
 			}
-			else if (returnToGround == true && playerFlying == false && scene->FindObjectByName("player")->GetPosition().z > 0.3) {
-				scene->FindObjectByName("player")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x, scene->FindObjectByName("player")->GetPosition().y, scene->FindObjectByName("player")->GetPosition().z - 0.12));
+			else if (returnToGround == true && playerFlying == false && player->GetPosition().z > 0.3) {
+				player->SetPostion(glm::vec3(player->GetPosition().x, player->GetPosition().y, player->GetPosition().z - 0.12));
 			}
 
 			if (FTime > 5) {
@@ -1189,20 +1222,16 @@ void keyboard()
 			}
 
 			if (playerJumping == true) {
-				running = false;
-				sliding = false;
-				flying = true;
-
-				//scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(flyingMesh1);
+				//player->Get<RenderComponent>()->SetMesh(flyingMesh1);
 				JTime = glfwGetTime() - JTemp;
 				JTime = JTime / 2.5;
 
-				scene->FindObjectByName("player")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x, scene->FindObjectByName("player")->GetPosition().y, jumpheight));
+				player->SetPostion(glm::vec3(player->GetPosition().x, player->GetPosition().y, jumpheight));
 			}
 			else {
 				JTemp = glfwGetTime();
 				//animIntervals = 0;
-				//scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(ladybugMesh); //sets obj to default
+				//player->Get<RenderComponent>()->SetMesh(ladybugMesh); //sets obj to default
 			}
 
 			x = JTime * 12; //Multiply to increase speed of jump
@@ -1223,230 +1252,20 @@ void keyboard()
 		}
 	}
 
-	//Run Animations (still working on lerping them) ***SWITCHING BETWEEN TOO MANY KEYFRAMES IN TOO SHORT A TIME WILL CAUSE THE GAME TO CRASH***
-	if (runningAnim == true) {
-		AnimTime = glfwGetTime() - runAnimTemp;
-		AnimTime = AnimTime / 2.5;
-		AnimTime = AnimTime + runAnimTemp2;
-	}
-	else {
-		runAnimTemp2 = AnimTime;
-		runAnimTemp = glfwGetTime();
-	}
-	//std::cout << AnimTime << "\n" << FPSIncrease << "\n";
-
-	if (AnimTime >= (0.02 + FPSIncrease) && AnimTime < (0.04 + FPSIncrease)) {
-		animFrame = animFrame + 1;
-		FPSIncrease = FPSIncrease + 0.02;
-	}
-	else if (AnimTime < 0.02 || playerJumping == false) {
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh1); //sets obj to default
-	}
-	if (scene->FindObjectByName("player")->GetPosition().z <= 0.3) {
-		runningAnim = true;
-	}
-
-	if (playerJumping == false && playerFlying == false && playerSliding == false) {
-		running = true;
-		flying = false;
-	}
-
-	if (running == true) {
-		if (animFrame >= 18) {
-			animFrame = 0;
-		}
-	}
-	else if (flying == true) {
-		if (animFrame == 26) {
-			animFrame = 19;
-		}
-		if (animFrame <= 18) {
-			animFrame = 19;
-		}
-	}
-	else if (sliding == true) {
-		if (animFrame <= 26) {
-			animFrame = 27;
-		}
-		if (animFrame == 52) {
-			animFrame = 27;
-		}
-	}
-
-	if (playerPlaying) {
-		runningAnim = true;
-	}
-	else {
-		runningAnim = false;
-	}
-
-	//std::cout << animFrame << "\n" << AnimTime << "\n";
-
-	switch (animFrame) {
-	case 1:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh1); //running animation start
-		break;
-	case 2:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh2);
-		break;
-	case 3:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh3);
-		break;
-	case 4:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh4);
-		break;
-	case 5:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh5);
-		break;
-	case 6:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh6);
-		break;
-	case 7:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh7);
-		break;
-	case 8:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh8);
-		break;
-	case 9:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh9);
-		break;
-	case 10:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh10);
-		break;
-	case 11:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh11);
-		break;
-	case 12:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh12);
-		break;
-	case 13:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh13);
-		break;
-	case 14:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh14);
-		break;
-	case 15:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh15);
-		break;
-	case 16:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh16);
-		break;
-	case 17:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh17);
-		break;
-	case 18:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(runningMesh18); //running animation end
-		break;
-	case 19:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(flyingMesh1); //flying animation start
-		break;
-	case 20:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(flyingMesh2);
-		break;
-	case 21:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(flyingMesh3);
-		break;
-	case 22:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(flyingMesh4);
-		break;
-	case 23:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(flyingMesh5);
-		break;
-	case 24:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(flyingMesh6);
-		break;
-	case 25:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(flyingMesh7);
-		break;
-	case 26:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(flyingMesh8); //flying animation end
-		break;
-	case 27:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh1); //sliding animation start
-		break;
-	case 28:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh2);
-		break;
-	case 29:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh3);
-		break;
-	case 30:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh4);
-		break;
-	case 31:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh5);
-		break;
-	case 32:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh6);
-		break;
-	case 33:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh7);
-		break;
-	case 34:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh8); 
-		break;
-	case 35:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh9);
-		break;
-	case 36:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh10);
-		break;
-	case 37:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh11);
-		break;
-	case 38:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh12);
-		break;
-	case 39:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh13);
-		break;
-	case 40:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh14);
-		break;
-	case 41:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh15);
-		break;
-	case 42:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh16);
-		break;
-	case 43:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh17);
-		break;
-	case 44:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh18);
-		break;
-	case 45:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh19);
-		break;
-	case 46:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh20);
-		break;
-	case 47:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh21);
-		break;
-	case 48:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh22);
-		break;
-	case 49:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh23);
-		break;
-	case 50:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh24);
-		break;
-	case 51:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh25);
-		break;
-	case 52:
-		scene->FindObjectByName("player")->Get<RenderComponent>()->SetMesh(slidingMesh26); //Sliding Animation end
-		break;
+	// Let the player's animator know what they're doing, it's state graph picks the animation
+	Animator::Sptr animator = player->Get<Animator>();
+	if (animator != nullptr) {
+		animator->Paused = !playerPlaying;
+		animator->SetBool("flying", playerFlying || playerJumping);
+		animator->SetBool("sliding", playerSliding);
 	}
 
 
 	if (playerFlying == false) {
-		if (scene->FindObjectByName("player")->GetPosition().z > 0.3) {
-			scene->FindObjectByName("player")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x, scene->FindObjectByName("player")->GetPosition().y, scene->FindObjectByName("player")->GetPosition().z - 0.4));
+		if (player->GetPosition().z > 0.3) {
+			player->SetPostion(glm::vec3(player->GetPosition().x, player->GetPosition().y, player->GetPosition().z - 0.4));
 		}
-		else if (scene->FindObjectByName("player")->GetPosition().z <= 0.3)
+		else if (player->GetPosition().z <= 0.3)
 		{
 			isJumpPressed = false;
 		}
@@ -1454,38 +1273,38 @@ void keyboard()
 
 		if (scenevalue == 1)
 		{
-			if (scene->FindObjectByName("player")->GetPosition().x < -800.f) {
+			if (player->GetPosition().x < -800.f) {
 				playerMove = false;
 			}
 		}
 		else if (scenevalue == 2)
 		{
-			if (scene->FindObjectByName("player")->GetPosition().x < -400.f) {
+			if (player->GetPosition().x < -400.f) {
 				playerMove = false;
 			}
 		}
 		else if (scenevalue == 3)
 		{
-			if (scene->FindObjectByName("player")->GetPosition().x < -1200.f) {
+			if (player->GetPosition().x < -1200.f) {
 				playerMove = false;
 			}
 		}
 		else if (scenevalue == 4)
 		{
-			if (scene->FindObjectByName("player")->GetPosition().x < -1600.f)
+			if (player->GetPosition().x < -1600.f)
 			{
 				playerMove = false;
 			}
 		}
 		else if (scenevalue == 5)
 		{
-			if (scene->FindObjectByName("player")->GetPosition().x < -2000.f) {
+			if (player->GetPosition().x < -2000.f) {
 				playerMove = false;
 			}
 		}
 		else if (scenevalue == 6)
 		{
-			if (scene->FindObjectByName("player")->GetPosition().x < -2400.f) {
+			if (player->GetPosition().x < -2400.f) {
 				playerMove = false;
 			}
 		}
@@ -1592,9 +1411,34 @@ glm::vec3 useSEEK(glm::vec3 gameObject, glm::vec3 seekObject)//make pass by refe
 
 
 
-int main() {
+int main(int argc, char** argv) {
 	Logger::Init(); // We'll borrow the logger from the toolkit, but we need to initialize it
 
+	// Older manifests have a copy of an asset for every time it was created. Running with
+	// --compact-manifest merges those, and only needs to be done once after saving the levels
+	if (argc > 1 && std::string(argv[1]) == "--compact-manifest") {
+		size_t removed = ResourceManager::CompactManifest("manifest.json", sceneFiles);
+		LOG_INFO("Compacted \"manifest.json\", {} duplicate resources removed", removed);
+		Logger::Uninitialize();
+		return 0;
+	}
+
+	// --convert-scene writes a binary copy of each scene next to it, which SceneLoad will use
+	// instead of the JSON until the JSON is saved again. Scenes can be given after the flag,
+	// otherwise all of the game's scenes are converted
+	if (argc > 1 && std::string(argv[1]) == "--convert-scene") {
+		std::vector<std::string> paths = argc > 2 ? std::vector<std::string>(argv + 2, argv + argc) : sceneFiles;
+		int failed = 0;
+		for (const std::string& path : paths) {
+			if (!Scene::ConvertToBinary(path, Scene::GetBinaryPath(path))) {
+				failed++;
+			}
+		}
+		LOG_INFO("Converted {} of {} scenes", paths.size() - failed, paths.size());
+		Logger::Uninitialize();
+		return failed == 0 ? 0 : 1;
+	}
+
 	//Initialize GLFW
 	if (!initGLFW())
 		return 1;
@@ -1616,8 +1460,9 @@ int main() {
 
 	// Register all our resource types so we can load them from manifest files
 	ResourceManager::RegisterType<Texture2D>();
-	ResourceManager::RegisterType<Material>();
+	ResourceManager::RegisterType<Material, Shader, Texture2D>();
 	ResourceManager::RegisterType<MeshResource>();
+	ResourceManager::RegisterType<AnimatedMeshResource>();
 	ResourceManager::RegisterType<Shader>();
 
 	// Register all of our component types so we can load them from files
@@ -1628,6 +1473,7 @@ int main() {
 	ComponentManager::RegisterType<RotatingBehaviour>();
 	//ComponentManager::RegisterType<JumpBehaviour>();
 	ComponentManager::RegisterType<MaterialSwapBehaviour>();
+	ComponentManager::RegisterType<Animator>();
 
 	// GL states, we'll enable depth testing and backface fulling
 	glEnable(GL_DEPTH_TEST);
@@ -1672,8 +1518,9 @@ int main() {
 	bool loadScene = false;
 	// For now we can use a toggle to generate our scene vs load from file
 	if (loadScene) {
+		// Run with --compact-manifest first if the manifest has duplicate assets
 		ResourceManager::LoadManifest("manifest.json");
-		scene = Scene::Load("menu.json");
+		scene = sceneCache.Activate("menu.json", window);
 	}
 	else {
 
@@ -1830,6 +1677,36 @@ int main() {
 			{ ShaderPartType::Vertex, "shaders/vertex_shader.glsl" },
 			{ ShaderPartType::Fragment, "shaders/frag_blinn_phong_textured.glsl" }
 		});
+		// Blends between the keyframes of animated meshes, see Animator
+		Shader::Sptr morphShader = ResourceManager::CreateAsset<Shader>(std::unordered_map<ShaderPartType, std::string>{
+			{ ShaderPartType::Vertex, "shaders/vertex_shader_vat.glsl" },
+			{ ShaderPartType::Fragment, "shaders/frag_blinn_phong_textured.glsl" }
+		});
+
+		// The player's animations, baked into a single texture per model so that switching clips
+		// doesn't need to touch the mesh. Repeated frames are intentional, they hold the pose for an extra frame
+		ladybugAnimations = ResourceManager::CreateAsset<AnimatedMeshResource>(std::vector<AnimatedMeshResource::Clip>{
+			{ "running", {
+				"Running_000001.obj", "Running_000002.obj", "Running_000003.obj", "Running_000004.obj", "Running_000005.obj", "Running_000006.obj",
+				"Running_000007.obj", "Running_000008.obj", "Running_000009.obj", "Running_000010.obj", "Running_000011.obj", "Running_000012.obj",
+				"Running_000013.obj", "Running_000014.obj", "Running_000015.obj", "Running_000016.obj", "Running_000017.obj", "Running_000018.obj"
+			}, 20.0f },
+			{ "sliding", {
+				"RunToCrawl_000001.obj", "RunToCrawl_000002.obj", "RunToCrawl_000003.obj", "RunToCrawl_000004.obj",
+				"RunToCrawl_000005.obj", "RunToCrawl_000006.obj", "RunToCrawl_000007.obj", "RunToCrawl_000007.obj",
+				"Crawling_000001.obj", "Crawling_000002.obj", "Crawling_000003.obj", "Crawling_000004.obj", "Crawling_000005.obj",
+				"Crawling_000006.obj", "Crawling_000007.obj", "Crawling_000008.obj", "Crawling_000009.obj", "Crawling_000010.obj",
+				"CrawlToRun_000001.obj", "CrawlToRun_000002.obj", "CrawlToRun_000003.obj", "CrawlToRun_000004.obj",
+				"CrawlToRun_000005.obj", "CrawlToRun_000006.obj", "CrawlToRun_000007.obj", "CrawlToRun_000007.obj"
+			}, 20.0f }
+		});
+		// The flying ladybug is a different model, so it gets it's own texture
+		flyingAnimations = ResourceManager::CreateAsset<AnimatedMeshResource>(std::vector<AnimatedMeshResource::Clip>{
+			{ "flying", {
+				"NewLadybug_000001.obj", "NewLadybug_000002.obj", "NewLadybug_000003.obj", "NewLadybug_000004.obj",
+				"NewLadybug_000005.obj", "NewLadybug_000006.obj", "NewLadybug_000007.obj", "NewLadybug_000008.obj"
+			}, 20.0f }
+		});
 
 
 
@@ -1894,7 +1771,7 @@ int main() {
 			Material::Sptr ladybugMaterial = ResourceManager::CreateAsset<Material>();
 			{
 				ladybugMaterial->Name = "lbo";
-				ladybugMaterial->MatShader = scene->BaseShader;
+				ladybugMaterial->MatShader = morphShader;
 				ladybugMaterial->Texture = ladybugTexture;
 				ladybugMaterial->Shininess = 2.0f;
 			}
@@ -1904,6 +1781,7 @@ int main() {
 				monkeyMaterial->Name = "Monkey";
 				monkeyMaterial->MatShader = scene->BaseShader;
 				monkeyMaterial->Texture = monkeyTex;
+				monkeyMaterial->Transparent = true;
 				monkeyMaterial->Shininess = 256.0f;
 
 			}
@@ -1942,6 +1820,7 @@ int main() {
 				PanelMaterial->Name = "Panel";
 				PanelMaterial->MatShader = scene->BaseShader;
 				PanelMaterial->Texture = PanelTex;
+				PanelMaterial->Transparent = true;
 				PanelMaterial->Shininess = 2.0f;
 			}
 
@@ -1982,6 +1861,7 @@ int main() {
 				FilterMaterial->Name = "Button Filter";
 				FilterMaterial->MatShader = scene->BaseShader;
 				FilterMaterial->Texture = FilterTex;
+				FilterMaterial->Transparent = true;
 				FilterMaterial->Shininess = 2.0f;
 			}
 
@@ -2060,6 +1940,7 @@ int main() {
 				ForegroundMaterial->Name = "Foreground";
 				ForegroundMaterial->MatShader = scene->BaseShader;
 				ForegroundMaterial->Texture = ForegroundTex;
+				ForegroundMaterial->Transparent = true;
 				ForegroundMaterial->Shininess = 2.0f;
 			}
 			Material::Sptr rockMaterial = ResourceManager::CreateAsset<Material>();
@@ -2643,10 +2524,13 @@ int main() {
 				//player->Get<JumpBehaviour>(player->GetPosition());
 				// Create and attach a renderer for the monkey
 				RenderComponent::Sptr renderer = player->Add<RenderComponent>();
-				renderer->SetMesh(ladybugMesh);
 				renderer->SetMaterial(ladybugMaterial);
 
-				collisions.push_back(CollisionRect(player->GetPosition(), 1.0f, 1.0f, 0));
+				// The animator sets the renderer's mesh to whichever clip is playing
+				Animator::Sptr animator = player->Add<Animator>();
+				SetupPlayerAnimator(animator);
+
+				collisionWorld.AddDynamic(CollisionRect(player->GetPosition(), 1.0f, 1.0f, 0));
 
 				// Add a dynamic rigid body to this monkey
 				RigidBody::Sptr physics = player->Add<RigidBody>(RigidBodyType::Dynamic);
@@ -2670,7 +2554,7 @@ int main() {
 				renderer->SetMesh(cubeMesh);
 				renderer->SetMaterial(boxMaterial);
 
-				collisions.push_back(CollisionRect(jumpingObstacle->GetPosition(), 1.0f, 1.0f, 1));
+				collisionWorld.AddDynamic(CollisionRect(jumpingObstacle->GetPosition(), 1.0f, 1.0f, 1));
 
 				//// This is an example of attaching a component and setting some parameters
 				//RotatingBehaviour::Sptr behaviour = jumpingObstacle->Add<RotatingBehaviour>();
@@ -3047,7 +2931,7 @@ int main() {
 			Material::Sptr ladybugMaterial = ResourceManager::CreateAsset<Material>();
 			{
 				ladybugMaterial->Name = "lbo";
-				ladybugMaterial->MatShader = scene->BaseShader;
+				ladybugMaterial->MatShader = morphShader;
 				ladybugMaterial->Texture = ladybugTexture;
 				ladybugMaterial->Shininess = 2.0f;
 			}
@@ -3057,6 +2941,7 @@ int main() {
 				monkeyMaterial->Name = "Monkey";
 				monkeyMaterial->MatShader = scene->BaseShader;
 				monkeyMaterial->Texture = monkeyTex;
+				monkeyMaterial->Transparent = true;
 				monkeyMaterial->Shininess = 256.0f;
 
 			}
@@ -3084,6 +2969,7 @@ int main() {
 				PanelMaterial->Name = "Panel";
 				PanelMaterial->MatShader = scene->BaseShader;
 				PanelMaterial->Texture = PanelTex;
+				PanelMaterial->Transparent = true;
 				PanelMaterial->Shininess = 2.0f;
 			}
 
@@ -3124,6 +3010,7 @@ int main() {
 				FilterMaterial->Name = "Button Filter";
 				FilterMaterial->MatShader = scene->BaseShader;
 				FilterMaterial->Texture = FilterTex;
+				FilterMaterial->Transparent = true;
 				FilterMaterial->Shininess = 2.0f;
 			}
 
@@ -3202,6 +3089,7 @@ int main() {
 				ForegroundMaterial->Name = "Foreground";
 				ForegroundMaterial->MatShader = scene->BaseShader;
 				ForegroundMaterial->Texture = ForegroundTex;
+				ForegroundMaterial->Transparent = true;
 				ForegroundMaterial->Shininess = 2.0f;
 			}
 			Material::Sptr rockMaterial = ResourceManager::CreateAsset<Material>();
@@ -3517,63 +3405,6 @@ int main() {
 			BGMesh = ResourceManager::CreateAsset<MeshResource>("Background.obj");
 			ExitTreeMesh = ResourceManager::CreateAsset<MeshResource>("ExitTree.obj");
 
-			//Running Mesh
-			runningMesh1 = ResourceManager::CreateAsset<MeshResource>("Running_000001.obj");
-			runningMesh2 = ResourceManager::CreateAsset<MeshResource>("Running_000002.obj");
-			runningMesh3 = ResourceManager::CreateAsset<MeshResource>("Running_000003.obj");
-			runningMesh4 = ResourceManager::CreateAsset<MeshResource>("Running_000004.obj");
-			runningMesh5 = ResourceManager::CreateAsset<MeshResource>("Running_000005.obj");
-			runningMesh6 = ResourceManager::CreateAsset<MeshResource>("Running_000006.obj");
-			runningMesh7 = ResourceManager::CreateAsset<MeshResource>("Running_000007.obj");
-			runningMesh8 = ResourceManager::CreateAsset<MeshResource>("Running_000008.obj");
-			runningMesh9 = ResourceManager::CreateAsset<MeshResource>("Running_000009.obj");
-			runningMesh10 = ResourceManager::CreateAsset<MeshResource>("Running_000010.obj");
-			runningMesh11 = ResourceManager::CreateAsset<MeshResource>("Running_000011.obj");
-			runningMesh12 = ResourceManager::CreateAsset<MeshResource>("Running_000012.obj");
-			runningMesh13 = ResourceManager::CreateAsset<MeshResource>("Running_000013.obj");
-			runningMesh14 = ResourceManager::CreateAsset<MeshResource>("Running_000014.obj");
-			runningMesh15 = ResourceManager::CreateAsset<MeshResource>("Running_000015.obj");
-			runningMesh16 = ResourceManager::CreateAsset<MeshResource>("Running_000016.obj");
-			runningMesh17 = ResourceManager::CreateAsset<MeshResource>("Running_000017.obj");
-			runningMesh18 = ResourceManager::CreateAsset<MeshResource>("Running_000018.obj");
-
-			//Flying Mesh
-			flyingMesh1 = ResourceManager::CreateAsset<MeshResource>("NewLadybug_000001.obj");
-			flyingMesh2 = ResourceManager::CreateAsset<MeshResource>("NewLadybug_000002.obj");
-			flyingMesh3 = ResourceManager::CreateAsset<MeshResource>("NewLadybug_000003.obj");
-			flyingMesh4 = ResourceManager::CreateAsset<MeshResource>("NewLadybug_000004.obj");
-			flyingMesh5 = ResourceManager::CreateAsset<MeshResource>("NewLadybug_000005.obj");
-			flyingMesh6 = ResourceManager::CreateAsset<MeshResource>("NewLadybug_000006.obj");
-			flyingMesh7 = ResourceManager::CreateAsset<MeshResource>("NewLadybug_000007.obj");
-			flyingMesh8 = ResourceManager::CreateAsset<MeshResource>("NewLadybug_000008.obj");
-
-			//Sliding Mesh
-			slidingMesh1 = ResourceManager::CreateAsset<MeshResource>("RunToCrawl_000001.obj");
-			slidingMesh2 = ResourceManager::CreateAsset<MeshResource>("RunToCrawl_000002.obj");
-			slidingMesh3 = ResourceManager::CreateAsset<MeshResource>("RunToCrawl_000003.obj");
-			slidingMesh4 = ResourceManager::CreateAsset<MeshResource>("RunToCrawl_000004.obj");
-			slidingMesh5 = ResourceManager::CreateAsset<MeshResource>("RunToCrawl_000005.obj");
-			slidingMesh6 = ResourceManager::CreateAsset<MeshResource>("RunToCrawl_000006.obj");
-			slidingMesh7 = ResourceManager::CreateAsset<MeshResource>("RunToCrawl_000007.obj");
-			slidingMesh8 = ResourceManager::CreateAsset<MeshResource>("RunToCrawl_000007.obj");
-			slidingMesh9 = ResourceManager::CreateAsset<MeshResource>("Crawling_000001.obj");
-			slidingMesh10 = ResourceManager::CreateAsset<MeshResource>("Crawling_000002.obj");
-			slidingMesh11 = ResourceManager::CreateAsset<MeshResource>("Crawling_000003.obj");
-			slidingMesh12 = ResourceManager::CreateAsset<MeshResource>("Crawling_000004.obj");
-			slidingMesh13 = ResourceManager::CreateAsset<MeshResource>("Crawling_000005.obj");
-			slidingMesh14 = ResourceManager::CreateAsset<MeshResource>("Crawling_000006.obj");
-			slidingMesh15 = ResourceManager::CreateAsset<MeshResource>("Crawling_000007.obj");
-			slidingMesh16 = ResourceManager::CreateAsset<MeshResource>("Crawling_000008.obj");
-			slidingMesh17 = ResourceManager::CreateAsset<MeshResource>("Crawling_000009.obj");
-			slidingMesh18 = ResourceManager::CreateAsset<MeshResource>("Crawling_000010.obj");
-			slidingMesh19 = ResourceManager::CreateAsset<MeshResource>("CrawlToRun_000001.obj");
-			slidingMesh20 = ResourceManager::CreateAsset<MeshResource>("CrawlToRun_000002.obj");
-			slidingMesh21 = ResourceManager::CreateAsset<MeshResource>("CrawlToRun_000003.obj");
-			slidingMesh22 = ResourceManager::CreateAsset<MeshResource>("CrawlToRun_000004.obj");
-			slidingMesh23 = ResourceManager::CreateAsset<MeshResource>("CrawlToRun_000005.obj");
-			slidingMesh24 = ResourceManager::CreateAsset<MeshResource>("CrawlToRun_000006.obj");
-			slidingMesh25 = ResourceManager::CreateAsset<MeshResource>("CrawlToRun_000007.obj");
-			slidingMesh26 = ResourceManager::CreateAsset<MeshResource>("CrawlToRun_000007.obj");
 
 			planeMesh->AddParam(MeshBuilderParam::CreatePlane(ZERO, UNIT_Z, UNIT_X, glm::vec2(1.0f)));
 			planeMesh->GenerateMesh();
@@ -3782,10 +3613,13 @@ int main() {
 				//player->Get<JumpBehaviour>(player->GetPosition());
 				// Create and attach a renderer for the monkey
 				RenderComponent::Sptr renderer = player->Add<RenderComponent>();
-				renderer->SetMesh(ladybugMesh);
 				renderer->SetMaterial(ladybugMaterial);
 
-				collisions.push_back(CollisionRect(player->GetPosition(), 1.0f, 1.0f, 0));
+				// The animator sets the renderer's mesh to whichever clip is playing
+				Animator::Sptr animator = player->Add<Animator>();
+				SetupPlayerAnimator(animator);
+
+				collisionWorld.AddDynamic(CollisionRect(player->GetPosition(), 1.0f, 1.0f, 0));
 
 				// Add a dynamic rigid body to this monkey
 				RigidBody::Sptr physics = player->Add<RigidBody>(RigidBodyType::Dynamic);
@@ -3810,7 +3644,7 @@ int main() {
 				renderer->SetMesh(cubeMesh);
 				renderer->SetMaterial(boxMaterial);
 
-				collisions.push_back(CollisionRect(jumpingObstacle->GetPosition(), 1.0f, 1.0f, 1));
+				collisionWorld.AddDynamic(CollisionRect(jumpingObstacle->GetPosition(), 1.0f, 1.0f, 1));
 
 				//// This is an example of attaching a component and setting some parameters
 				//RotatingBehaviour::Sptr behaviour = jumpingObstacle->Add<RotatingBehaviour>();
@@ -4189,7 +4023,7 @@ int main() {
 			Material::Sptr ladybugMaterial = ResourceManager::CreateAsset<Material>();
 			{
 				ladybugMaterial->Name = "lbo";
-				ladybugMaterial->MatShader = scene->BaseShader;
+				ladybugMaterial->MatShader = morphShader;
 				ladybugMaterial->Texture = ladybugTexture;
 				ladybugMaterial->Shininess = 2.0f;
 			}
@@ -4199,6 +4033,7 @@ int main() {
 				monkeyMaterial->Name = "Monkey";
 				monkeyMaterial->MatShader = scene->BaseShader;
 				monkeyMaterial->Texture = monkeyTex;
+				monkeyMaterial->Transparent = true;
 				monkeyMaterial->Shininess = 256.0f;
 
 			}
@@ -4228,6 +4063,7 @@ int main() {
 				PanelMaterial->Name = "Panel";
 				PanelMaterial->MatShader = scene->BaseShader;
 				PanelMaterial->Texture = PanelTex;
+				PanelMaterial->Transparent = true;
 				PanelMaterial->Shininess = 2.0f;
 			}
 
@@ -4268,6 +4104,7 @@ int main() {
 				FilterMaterial->Name = "Button Filter";
 				FilterMaterial->MatShader = scene->BaseShader;
 				FilterMaterial->Texture = FilterTex;
+				FilterMaterial->Transparent = true;
 				FilterMaterial->Shininess = 2.0f;
 			}
 
@@ -4346,6 +4183,7 @@ int main() {
 				ForegroundMaterial->Name = "Foreground";
 				ForegroundMaterial->MatShader = scene->BaseShader;
 				ForegroundMaterial->Texture = ForegroundTex;
+				ForegroundMaterial->Transparent = true;
 				ForegroundMaterial->Shininess = 2.0f;
 			}
 			Material::Sptr rockMaterial = ResourceManager::CreateAsset<Material>();
@@ -4524,6 +4362,7 @@ int main() {
 				PuddleMaterial->Name = "Puddle";
 				PuddleMaterial->MatShader = scene->BaseShader;
 				PuddleMaterial->Texture = PuddleTex;
+				PuddleMaterial->Transparent = true;
 				PuddleMaterial->Shininess = 2.0f;
 			}
 
@@ -4946,10 +4785,13 @@ int main() {
 				//player->Get<JumpBehaviour>(player->GetPosition());
 				// Create and attach a renderer for the monkey
 				RenderComponent::Sptr renderer = player->Add<RenderComponent>();
-				renderer->SetMesh(ladybugMesh);
 				renderer->SetMaterial(ladybugMaterial);
 
-				collisions.push_back(CollisionRect(player->GetPosition(), 1.0f, 1.0f, 0));
+				// The animator sets the renderer's mesh to whichever clip is playing
+				Animator::Sptr animator = player->Add<Animator>();
+				SetupPlayerAnimator(animator);
+
+				collisionWorld.AddDynamic(CollisionRect(player->GetPosition(), 1.0f, 1.0f, 0));
 
 				// Add a dynamic rigid body to this monkey
 				RigidBody::Sptr physics = player->Add<RigidBody>(RigidBodyType::Dynamic);
@@ -4973,7 +4815,7 @@ int main() {
 				renderer->SetMesh(cubeMesh);
 				renderer->SetMaterial(boxMaterial);
 
-				collisions.push_back(CollisionRect(jumpingObstacle->GetPosition(), 1.0f, 1.0f, 1));
+				collisionWorld.AddDynamic(CollisionRect(jumpingObstacle->GetPosition(), 1.0f, 1.0f, 1));
 
 				//// This is an example of attaching a component and setting some parameters
 				//RotatingBehaviour::Sptr behaviour = jumpingObstacle->Add<RotatingBehaviour>();
@@ -5366,7 +5208,7 @@ int main() {
 		Material::Sptr ladybugMaterial = ResourceManager::CreateAsset<Material>();
 		{
 			ladybugMaterial->Name = "lbo";
-			ladybugMaterial->MatShader = scene->BaseShader;
+			ladybugMaterial->MatShader = morphShader;
 			ladybugMaterial->Texture = ladybugTexture;
 			ladybugMaterial->Shininess = 2.0f;
 		}
@@ -5376,6 +5218,7 @@ int main() {
 			monkeyMaterial->Name = "Monkey";
 			monkeyMaterial->MatShader = scene->BaseShader;
 			monkeyMaterial->Texture = monkeyTex;
+			monkeyMaterial->Transparent = true;
 			monkeyMaterial->Shininess = 256.0f;
 
 		}
@@ -5403,6 +5246,7 @@ int main() {
 			PanelMaterial->Name = "Panel";
 			PanelMaterial->MatShader = scene->BaseShader;
 			PanelMaterial->Texture = PanelTex;
+			PanelMaterial->Transparent = true;
 			PanelMaterial->Shininess = 2.0f;
 		}
 
@@ -5443,6 +5287,7 @@ int main() {
 			FilterMaterial->Name = "Button Filter";
 			FilterMaterial->MatShader = scene->BaseShader;
 			FilterMaterial->Texture = FilterTex;
+			FilterMaterial->Transparent = true;
 			FilterMaterial->Shininess = 2.0f;
 		}
 
@@ -5521,6 +5366,7 @@ int main() {
 			ForegroundMaterial->Name = "Foreground";
 			ForegroundMaterial->MatShader = scene->BaseShader;
 			ForegroundMaterial->Texture = ForegroundTex;
+			ForegroundMaterial->Transparent = true;
 			ForegroundMaterial->Shininess = 2.0f;
 		}
 		Material::Sptr rockMaterial = ResourceManager::CreateAsset<Material>();
@@ -5699,6 +5545,7 @@ int main() {
 			PuddleMaterial->Name = "Puddle";
 			PuddleMaterial->MatShader = scene->BaseShader;
 			PuddleMaterial->Texture = PuddleTex;
+			PuddleMaterial->Transparent = true;
 			PuddleMaterial->Shininess = 2.0f;
 		}
 
@@ -6179,10 +6026,13 @@ int main() {
 			//player->Get<JumpBehaviour>(player->GetPosition());
 			// Create and attach a renderer for the monkey
 			RenderComponent::Sptr renderer = player->Add<RenderComponent>();
-			renderer->SetMesh(ladybugMesh);
 			renderer->SetMaterial(ladybugMaterial);
 
-			collisions.push_back(CollisionRect(player->GetPosition(), 1.0f, 1.0f, 0));
+			// The animator sets the renderer's mesh to whichever clip is playing
+			Animator::Sptr animator = player->Add<Animator>();
+			SetupPlayerAnimator(animator);
+
+			collisionWorld.AddDynamic(CollisionRect(player->GetPosition(), 1.0f, 1.0f, 0));
 
 			// Add a dynamic rigid body to this monkey
 			RigidBody::Sptr physics = player->Add<RigidBody>(RigidBodyType::Dynamic);
@@ -6206,7 +6056,7 @@ int main() {
 			renderer->SetMesh(cubeMesh);
 			renderer->SetMaterial(boxMaterial);
 
-			collisions.push_back(CollisionRect(jumpingObstacle->GetPosition(), 1.0f, 1.0f, 1));
+			collisionWorld.AddDynamic(CollisionRect(jumpingObstacle->GetPosition(), 1.0f, 1.0f, 1));
 
 			//// This is an example of attaching a component and setting some parameters
 			//RotatingBehaviour::Sptr behaviour = jumpingObstacle->Add<RotatingBehaviour>();
@@ -6600,7 +6450,7 @@ int main() {
 			Material::Sptr ladybugMaterial = ResourceManager::CreateAsset<Material>();
 			{
 				ladybugMaterial->Name = "lbo";
-				ladybugMaterial->MatShader = scene->BaseShader;
+				ladybugMaterial->MatShader = morphShader;
 				ladybugMaterial->Texture = ladybugTexture;
 				ladybugMaterial->Shininess = 2.0f;
 			}
@@ -6610,6 +6460,7 @@ int main() {
 				monkeyMaterial->Name = "Monkey";
 				monkeyMaterial->MatShader = scene->BaseShader;
 				monkeyMaterial->Texture = monkeyTex;
+				monkeyMaterial->Transparent = true;
 				monkeyMaterial->Shininess = 256.0f;
 
 			}
@@ -6637,6 +6488,7 @@ int main() {
 				PanelMaterial->Name = "Panel";
 				PanelMaterial->MatShader = scene->BaseShader;
 				PanelMaterial->Texture = PanelTex;
+				PanelMaterial->Transparent = true;
 				PanelMaterial->Shininess = 2.0f;
 			}
 
@@ -6677,6 +6529,7 @@ int main() {
 				FilterMaterial->Name = "Button Filter";
 				FilterMaterial->MatShader = scene->BaseShader;
 				FilterMaterial->Texture = FilterTex;
+				FilterMaterial->Transparent = true;
 				FilterMaterial->Shininess = 2.0f;
 			}
 
@@ -6755,6 +6608,7 @@ int main() {
 				ForegroundMaterial->Name = "Foreground";
 				ForegroundMaterial->MatShader = scene->BaseShader;
 				ForegroundMaterial->Texture = ForegroundTex;
+				ForegroundMaterial->Transparent = true;
 				ForegroundMaterial->Shininess = 2.0f;
 			}
 			Material::Sptr rockMaterial = ResourceManager::CreateAsset<Material>();
@@ -6927,6 +6781,7 @@ int main() {
 				PuddleMaterial->Name = "Puddle";
 				PuddleMaterial->MatShader = scene->BaseShader;
 				PuddleMaterial->Texture = PuddleTex;
+				PuddleMaterial->Transparent = true;
 				PuddleMaterial->Shininess = 2.0f;
 			}
 
@@ -7445,10 +7300,13 @@ int main() {
 				//player->Get<JumpBehaviour>(player->GetPosition());
 				// Create and attach a renderer for the monkey
 				RenderComponent::Sptr renderer = player->Add<RenderComponent>();
-				renderer->SetMesh(ladybugMesh);
 				renderer->SetMaterial(ladybugMaterial);
 
-				collisions.push_back(CollisionRect(player->GetPosition(), 1.0f, 1.0f, 0));
+				// The animator sets the renderer's mesh to whichever clip is playing
+				Animator::Sptr animator = player->Add<Animator>();
+				SetupPlayerAnimator(animator);
+
+				collisionWorld.AddDynamic(CollisionRect(player->GetPosition(), 1.0f, 1.0f, 0));
 
 				// Add a dynamic rigid body to this monkey
 				RigidBody::Sptr physics = player->Add<RigidBody>(RigidBodyType::Dynamic);
@@ -7472,7 +7330,7 @@ int main() {
 				renderer->SetMesh(cubeMesh);
 				renderer->SetMaterial(boxMaterial);
 
-				collisions.push_back(CollisionRect(jumpingObstacle->GetPosition(), 1.0f, 1.0f, 1));
+				collisionWorld.AddDynamic(CollisionRect(jumpingObstacle->GetPosition(), 1.0f, 1.0f, 1));
 
 				//// This is an example of attaching a component and setting some parameters
 				//RotatingBehaviour::Sptr behaviour = jumpingObstacle->Add<RotatingBehaviour>();
@@ -7865,7 +7723,7 @@ int main() {
 		Material::Sptr ladybugMaterial = ResourceManager::CreateAsset<Material>();
 		{
 			ladybugMaterial->Name = "lbo";
-			ladybugMaterial->MatShader = scene->BaseShader;
+			ladybugMaterial->MatShader = morphShader;
 			ladybugMaterial->Texture = ladybugTexture;
 			ladybugMaterial->Shininess = 2.0f;
 		}
@@ -7875,6 +7733,7 @@ int main() {
 			monkeyMaterial->Name = "Monkey";
 			monkeyMaterial->MatShader = scene->BaseShader;
 			monkeyMaterial->Texture = monkeyTex;
+			monkeyMaterial->Transparent = true;
 			monkeyMaterial->Shininess = 256.0f;
 
 		}
@@ -7911,6 +7770,7 @@ int main() {
 			PanelMaterial->Name = "Panel";
 			PanelMaterial->MatShader = scene->BaseShader;
 			PanelMaterial->Texture = PanelTex;
+			PanelMaterial->Transparent = true;
 			PanelMaterial->Shininess = 2.0f;
 		}
 
@@ -7951,6 +7811,7 @@ int main() {
 			FilterMaterial->Name = "Button Filter";
 			FilterMaterial->MatShader = scene->BaseShader;
 			FilterMaterial->Texture = FilterTex;
+			FilterMaterial->Transparent = true;
 			FilterMaterial->Shininess = 2.0f;
 		}
 
@@ -8029,6 +7890,7 @@ int main() {
 			ForegroundMaterial->Name = "Foreground";
 			ForegroundMaterial->MatShader = scene->BaseShader;
 			ForegroundMaterial->Texture = ForegroundTex;
+			ForegroundMaterial->Transparent = true;
 			ForegroundMaterial->Shininess = 2.0f;
 		}
 		Material::Sptr rockMaterial = ResourceManager::CreateAsset<Material>();
@@ -8207,6 +8069,7 @@ int main() {
 			PuddleMaterial->Name = "Puddle";
 			PuddleMaterial->MatShader = scene->BaseShader;
 			PuddleMaterial->Texture = PuddleTex;
+			PuddleMaterial->Transparent = true;
 			PuddleMaterial->Shininess = 2.0f;
 		}
 
@@ -8812,10 +8675,13 @@ int main() {
 			//player->Get<JumpBehaviour>(player->GetPosition());
 			// Create and attach a renderer for the monkey
 			RenderComponent::Sptr renderer = player->Add<RenderComponent>();
-			renderer->SetMesh(ladybugMesh);
 			renderer->SetMaterial(ladybugMaterial);
 
-			collisions.push_back(CollisionRect(player->GetPosition(), 1.0f, 1.0f, 0));
+			// The animator sets the renderer's mesh to whichever clip is playing
+			Animator::Sptr animator = player->Add<Animator>();
+			SetupPlayerAnimator(animator);
+
+			collisionWorld.AddDynamic(CollisionRect(player->GetPosition(), 1.0f, 1.0f, 0));
 
 			// Add a dynamic rigid body to this monkey
 			RigidBody::Sptr physics = player->Add<RigidBody>(RigidBodyType::Dynamic);
@@ -8839,7 +8705,7 @@ int main() {
 			renderer->SetMesh(cubeMesh);
 			renderer->SetMaterial(boxMaterial);
 
-			collisions.push_back(CollisionRect(jumpingObstacle->GetPosition(), 1.0f, 1.0f, 1));
+			collisionWorld.AddDynamic(CollisionRect(jumpingObstacle->GetPosition(), 1.0f, 1.0f, 1));
 
 			//// This is an example of attaching a component and setting some parameters
 			//RotatingBehaviour::Sptr behaviour = jumpingObstacle->Add<RotatingBehaviour>();
@@ -9251,6 +9117,7 @@ int main() {
 				FilterMaterial->Name = "Button Filter";
 				FilterMaterial->MatShader = scene->BaseShader;
 				FilterMaterial->Texture = FilterTex;
+				FilterMaterial->Transparent = true;
 				FilterMaterial->Shininess = 2.0f;
 			}
 
@@ -9659,6 +9526,7 @@ int main() {
 				PanelMaterial->Name = "Panel";
 				PanelMaterial->MatShader = scene->BaseShader;
 				PanelMaterial->Texture = PanelTex;
+				PanelMaterial->Transparent = true;
 				PanelMaterial->Shininess = 2.0f;
 			}
 
@@ -9925,6 +9793,7 @@ int main() {
 				FilterMaterial->Name = "Button Filter";
 				FilterMaterial->MatShader = scene->BaseShader;
 				FilterMaterial->Texture = FilterTex;
+				FilterMaterial->Transparent = true;
 				FilterMaterial->Shininess = 2.0f;
 			}
 
@@ -10530,12 +10399,15 @@ int main() {
 		}
 
 
-		scene = Scene::Load("menu.json");
+		scene = sceneCache.Activate("menu.json", window);
 	}
 
-	// Call scene awake to start up all of our components
-	scene->Window = window;
-	scene->Awake();
+	if (scene == nullptr) {
+		LOG_ERROR("Could not load the main menu, exiting");
+		return 1;
+	}
+
+	// The scene cache has already set the scene's window and called awake on all of our components
 
 	// We'll use this to allow editing the save/load path
 	// via ImGui, note the reserve to allocate extra space
@@ -10553,7 +10425,7 @@ int main() {
 	BulletDebugMode physicsDebugMode = BulletDebugMode::None;
 	float playbackSpeed = 2.0f;
 
-	nlohmann::json editorSceneState;
+	SceneSnapshot::Sptr editorSceneState = nullptr;
 
 
 		//result = system->playSound(sound4, 0, false, &channel);
@@ -10576,6 +10448,13 @@ int main() {
 	PTemp2 = 0;
 	playerPlaying = false;
 
+	// Set up our instancing resources, these are shared between all scenes
+	instancedShader = std::make_shared<Shader>(std::unordered_map<ShaderPartType, std::string>{
+		{ ShaderPartType::Vertex, "shaders/vertex_shader_instanced.glsl" },
+		{ ShaderPartType::Fragment, "shaders/frag_blinn_phong_textured.glsl" }
+	});
+	instanceBuffer = VertexBuffer::Create(BufferUsage::StreamDraw);
+
 	///// Game loop /////
 	while (!glfwWindowShouldClose(window)) {
 		glfwPollEvents();
@@ -10605,63 +10484,81 @@ int main() {
 
 
 		/// with this change to the check, switching between scenes using scenePath no longer causes the game to crash since if the scene doesn't have a player it wont prompt commands
-		if (scene->FindObjectByName("player") != NULL)
-		{
+		// Resolve the objects we need every frame once, rather than per use
+		GameObject::Sptr player     = playerHandle.Get(scene);
+		GameObject::Sptr mainCamera = mainCameraHandle.Get(scene);
+		GameObject::Sptr filter     = filterHandle.Get(scene);
+
+		if (player != nullptr)
+		{
+			// Only levels have these, so they're resolved once we know we're in one
+			GameObject::Sptr pausePanel          = pausePanelHandle.Get(scene);
+			GameObject::Sptr buttonBack1         = buttonBack1Handle.Get(scene);
+			GameObject::Sptr buttonBack2         = buttonBack2Handle.Get(scene);
+			GameObject::Sptr buttonBack3         = buttonBack3Handle.Get(scene);
+			GameObject::Sptr resumeText          = resumeTextHandle.Get(scene);
+			GameObject::Sptr replayText          = replayTextHandle.Get(scene);
+			GameObject::Sptr levelSelectText     = levelSelectTextHandle.Get(scene);
+			GameObject::Sptr mainMenuText        = mainMenuTextHandle.Get(scene);
+			GameObject::Sptr pauseLogo           = pauseLogoHandle.Get(scene);
+			GameObject::Sptr loserLogo           = loserLogoHandle.Get(scene);
+			GameObject::Sptr winnerLogo          = winnerLogoHandle.Get(scene);
+			GameObject::Sptr progressBar         = progressBarHandle.Get(scene);
+			GameObject::Sptr progressBarProgress = progressBarProgressHandle.Get(scene);
+
 			if (paused == true)
 			{
 				playerPlaying = false;
-				scene->FindObjectByName("PanelPause")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6, 6.5));
-				scene->FindObjectByName("ButtonBack1")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.25, 6.0));
-				scene->FindObjectByName("ButtonBack2")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.5, 5.0));
-				scene->FindObjectByName("ButtonBack3")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.75, 4.0));
-				scene->FindObjectByName("ResumeText")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 8, 6.1));
-				scene->FindObjectByName("LSText")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 8, 5.4));
-				scene->FindObjectByName("MainMenuText")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 8.2, 4.7));
-				scene->FindObjectByName("PauseLogo")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 5.75, 8.0));
+				pausePanel->SetPostion(glm::vec3(player->GetPosition().x - 5, 6, 6.5));
+				buttonBack1->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.25, 6.0));
+				buttonBack2->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.5, 5.0));
+				buttonBack3->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.75, 4.0));
+				resumeText->SetPostion(glm::vec3(player->GetPosition().x - 5, 8, 6.1));
+				levelSelectText->SetPostion(glm::vec3(player->GetPosition().x - 5, 8, 5.4));
+				mainMenuText->SetPostion(glm::vec3(player->GetPosition().x - 5, 8.2, 4.7));
+				pauseLogo->SetPostion(glm::vec3(player->GetPosition().x - 5, 5.75, 8.0));
 				ProgressBarTempPaused = ProgressBarTime;
 
 
 				if (index == 1)
 				{
-					scene->FindObjectByName("Filter")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.26, 6.0));
+					filter->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.26, 6.0));
 				}
 				else if (index == 2)
 				{
-					scene->FindObjectByName("Filter")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.51, 5.0));
+					filter->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.51, 5.0));
 				}
 				else if (index == 3)
 				{
-					scene->FindObjectByName("Filter")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.76, 4.0));
+					filter->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.76, 4.0));
 				}
 
 			}
 
 			if (playerLose == true)
 			{
-				AnimTime = 0;
-				FPSIncrease = 0;
 				playerPlaying = false;
-				scene->FindObjectByName("PanelPause")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6, 6.5));
-				scene->FindObjectByName("ButtonBack1")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.25, 6.0));
-				scene->FindObjectByName("ButtonBack2")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.5, 5.0));
-				scene->FindObjectByName("ButtonBack3")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.75, 4.0));
-				scene->FindObjectByName("ReplayText")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 8, 6.1));
-				scene->FindObjectByName("MainMenuText")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 8.2, 4.7));
-				scene->FindObjectByName("LSText")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 8, 5.4));
-				scene->FindObjectByName("LoserLogo")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 5.75, 8.0));
+				pausePanel->SetPostion(glm::vec3(player->GetPosition().x - 5, 6, 6.5));
+				buttonBack1->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.25, 6.0));
+				buttonBack2->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.5, 5.0));
+				buttonBack3->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.75, 4.0));
+				replayText->SetPostion(glm::vec3(player->GetPosition().x - 5, 8, 6.1));
+				mainMenuText->SetPostion(glm::vec3(player->GetPosition().x - 5, 8.2, 4.7));
+				levelSelectText->SetPostion(glm::vec3(player->GetPosition().x - 5, 8, 5.4));
+				loserLogo->SetPostion(glm::vec3(player->GetPosition().x - 5, 5.75, 8.0));
 				ProgressBarTemp = glfwGetTime();
 
 				if (index == 1)
 				{
-					scene->FindObjectByName("Filter")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.26, 6.0));
+					filter->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.26, 6.0));
 				}
 				else if (index == 2)
 				{
-					scene->FindObjectByName("Filter")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.51, 5.0));
+					filter->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.51, 5.0));
 				}
 				else if (index == 3)
 				{
-					scene->FindObjectByName("Filter")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.76, 4.0));
+					filter->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.76, 4.0));
 				}
 			}
 
@@ -10695,27 +10592,27 @@ int main() {
 				PTemp = 0;
 
 				playerPlaying = false;
-				scene->FindObjectByName("PanelPause")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6, 6.5));
-				scene->FindObjectByName("ButtonBack1")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.25, 6.0));
-				scene->FindObjectByName("ButtonBack2")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.5, 5.0));
-				scene->FindObjectByName("ButtonBack3")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.75, 4.0));
-				scene->FindObjectByName("ReplayText")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 8, 6.1));
-				scene->FindObjectByName("MainMenuText")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 8.2, 4.7));
-				scene->FindObjectByName("LSText")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 8, 5.4));
-				scene->FindObjectByName("WinnerLogo")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 5.75, 8.0));
+				pausePanel->SetPostion(glm::vec3(player->GetPosition().x - 5, 6, 6.5));
+				buttonBack1->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.25, 6.0));
+				buttonBack2->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.5, 5.0));
+				buttonBack3->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.75, 4.0));
+				replayText->SetPostion(glm::vec3(player->GetPosition().x - 5, 8, 6.1));
+				mainMenuText->SetPostion(glm::vec3(player->GetPosition().x - 5, 8.2, 4.7));
+				levelSelectText->SetPostion(glm::vec3(player->GetPosition().x - 5, 8, 5.4));
+				winnerLogo->SetPostion(glm::vec3(player->GetPosition().x - 5, 5.75, 8.0));
 				ProgressBarTemp = glfwGetTime();
 
 				if (index == 1)
 				{
-					scene->FindObjectByName("Filter")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.26, 6.0));
+					filter->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.26, 6.0));
 				}
 				else if (index == 2)
 				{
-					scene->FindObjectByName("Filter")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.51, 5.0));
+					filter->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.51, 5.0));
 				}
 				else if (index == 3)
 				{
-					scene->FindObjectByName("Filter")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 6.76, 4.0));
+					filter->SetPostion(glm::vec3(player->GetPosition().x - 5, 6.76, 4.0));
 				}
 			}
 			else {
@@ -10726,18 +10623,18 @@ int main() {
 			{
 				playerPlaying = true;
 				//originally these were all back at -15 but idk if that makes the game more jank cause of overlap so i tried to spread em out
-				scene->FindObjectByName("PanelPause")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x, scene->FindObjectByName("Main Camera")->GetPosition().y + 1, 6.5));
-				scene->FindObjectByName("ButtonBack1")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x, scene->FindObjectByName("Main Camera")->GetPosition().y + 2, 6));
-				scene->FindObjectByName("ButtonBack2")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x, scene->FindObjectByName("Main Camera")->GetPosition().y + 3, 5));
-				scene->FindObjectByName("ButtonBack3")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x, scene->FindObjectByName("Main Camera")->GetPosition().y + 4, 4));
-				scene->FindObjectByName("ResumeText")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x, scene->FindObjectByName("Main Camera")->GetPosition().y + 5, 6.1));
-				scene->FindObjectByName("MainMenuText")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x, scene->FindObjectByName("Main Camera")->GetPosition().y + 6, 4.7));
-				scene->FindObjectByName("LSText")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x, scene->FindObjectByName("Main Camera")->GetPosition().y + 6, 5.4));
-				scene->FindObjectByName("PauseLogo")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x, scene->FindObjectByName("Main Camera")->GetPosition().y + 7, 8));
-				scene->FindObjectByName("Filter")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x, scene->FindObjectByName("Main Camera")->GetPosition().y + 8, 8));
-				scene->FindObjectByName("LoserLogo")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x, scene->FindObjectByName("Main Camera")->GetPosition().y + 9, 8));
-				scene->FindObjectByName("ReplayText")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x, scene->FindObjectByName("Main Camera")->GetPosition().y + 10, 6.1));
-				scene->FindObjectByName("WinnerLogo")->SetPostion(glm::vec3(scene->FindObjectByName("Main Camera")->GetPosition().x, scene->FindObjectByName("Main Camera")->GetPosition().y + 11, 6.1));
+				pausePanel->SetPostion(glm::vec3(mainCamera->GetPosition().x, mainCamera->GetPosition().y + 1, 6.5));
+				buttonBack1->SetPostion(glm::vec3(mainCamera->GetPosition().x, mainCamera->GetPosition().y + 2, 6));
+				buttonBack2->SetPostion(glm::vec3(mainCamera->GetPosition().x, mainCamera->GetPosition().y + 3, 5));
+				buttonBack3->SetPostion(glm::vec3(mainCamera->GetPosition().x, mainCamera->GetPosition().y + 4, 4));
+				resumeText->SetPostion(glm::vec3(mainCamera->GetPosition().x, mainCamera->GetPosition().y + 5, 6.1));
+				mainMenuText->SetPostion(glm::vec3(mainCamera->GetPosition().x, mainCamera->GetPosition().y + 6, 4.7));
+				levelSelectText->SetPostion(glm::vec3(mainCamera->GetPosition().x, mainCamera->GetPosition().y + 6, 5.4));
+				pauseLogo->SetPostion(glm::vec3(mainCamera->GetPosition().x, mainCamera->GetPosition().y + 7, 8));
+				filter->SetPostion(glm::vec3(mainCamera->GetPosition().x, mainCamera->GetPosition().y + 8, 8));
+				loserLogo->SetPostion(glm::vec3(mainCamera->GetPosition().x, mainCamera->GetPosition().y + 9, 8));
+				replayText->SetPostion(glm::vec3(mainCamera->GetPosition().x, mainCamera->GetPosition().y + 10, 6.1));
+				winnerLogo->SetPostion(glm::vec3(mainCamera->GetPosition().x, mainCamera->GetPosition().y + 11, 6.1));
 
 				if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS && soundprompt == false)
 				{
@@ -10785,33 +10682,40 @@ int main() {
 			}
 			//std::cout << ProgressBarTime << "\n";
 
-			scene->FindObjectByName("Main Camera")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 11.480, 6.290)); // makes the camera follow the player
-			scene->FindObjectByName("Main Camera")->SetRotation(glm::vec3(84, 0, -180)); //angled view (stops camera from rotating)
-			scene->FindObjectByName("player")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x, 0.f, scene->FindObjectByName("player")->GetPosition().z)); // makes the camera follow the player
+			mainCamera->SetPostion(glm::vec3(player->GetPosition().x - 5, 11.480, 6.290)); // makes the camera follow the player
+			mainCamera->SetRotation(glm::vec3(84, 0, -180)); //angled view (stops camera from rotating)
+			player->SetPostion(glm::vec3(player->GetPosition().x, 0.f, player->GetPosition().z)); // makes the camera follow the player
 
-			scene->FindObjectByName("ProgressBarGO")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x - 5, 1.620, 13)); //makes progress bar follow the player
-			scene->FindObjectByName("ProgressBarProgress")->SetPostion(glm::vec3(scene->FindObjectByName("player")->GetPosition().x + 2 - ProgressBarTime, 1.7, 12.75)); //Makes Progress of progress bar follow the player
+			progressBar->SetPostion(glm::vec3(player->GetPosition().x - 5, 1.620, 13)); //makes progress bar follow the player
+			progressBarProgress->SetPostion(glm::vec3(player->GetPosition().x + 2 - ProgressBarTime, 1.7, 12.75)); //Makes Progress of progress bar follow the player
 
 
 			//Stops the player from rotating
-			scene->FindObjectByName("player")->SetRotation(glm::vec3(90.f, scene->FindObjectByName("player")->GetRotation().y, 90.f));
+			player->SetRotation(glm::vec3(90.f, player->GetRotation().y, 90.f));
 
 			keyboard();
 			
 
 
 			//collisions system
-			for (std::vector<int>::size_type i = 0; i != collisions.size(); i++) {
-				if (collisions[i].id == 0) {
-					collisions[i].update(scene->FindObjectByName("player")->GetPosition());
+			GameObject::Sptr movingObstacle = nullptr;
+			for (size_t ix = 0; ix < collisionWorld.GetDynamicCount(); ix++) {
+				CollisionRect& body = collisionWorld.GetDynamic(ix);
+				if (body.id == 0) {
+					body.update(player->GetPosition());
 				}
-				if (collisions[i].id == 1) {
-					collisions[i].update(scene->FindObjectByName("Trigger2")->GetPosition());
+				if (body.id == 1) {
+					if (movingObstacle == nullptr) {
+						movingObstacle = movingObstacleHandle.Get(scene);
+					}
+					body.update(movingObstacle->GetPosition());
 				}
 			}
 
-			for (std::vector<int>::size_type i = 0; i != collisions.size(); i++) {
-				playerCollision.rectOverlap(playerCollision, collisions[i]); //changed ballcollision to playercollision
+			// Only test the rects near the player, instead of every rect in every level
+			collisionWorld.Query(playerCollision, nearbyCollisions);
+			for (CollisionRect* rect : nearbyCollisions) {
+				playerCollision.rectOverlap(playerCollision, *rect); //changed ballcollision to playercollision
 			}
 
 			if (playerCollision.hitEntered == true) {
@@ -10820,27 +10724,27 @@ int main() {
 
 				if (scenevalue == 1)
 				{
-					scene->FindObjectByName("player")->SetPostion(glm::vec3(-406.f, 0.f, scene->FindObjectByName("player")->GetPosition().z));
+					player->SetPostion(glm::vec3(-406.f, 0.f, player->GetPosition().z));
 				}
 				else if (scenevalue == 2)
 				{
-					scene->FindObjectByName("player")->SetPostion(glm::vec3(6.f, 0.f, scene->FindObjectByName("player")->GetPosition().z));
+					player->SetPostion(glm::vec3(6.f, 0.f, player->GetPosition().z));
 				}
 				else if (scenevalue == 3)
 				{
-					scene->FindObjectByName("player")->SetPostion(glm::vec3(-806.f, 0.f, scene->FindObjectByName("player")->GetPosition().z));
+					player->SetPostion(glm::vec3(-806.f, 0.f, player->GetPosition().z));
 				}
 				else if (scenevalue == 4)
 				{
-					scene->FindObjectByName("player")->SetPostion(glm::vec3(-1206.f, 0.f, scene->FindObjectByName("player")->GetPosition().z));
+					player->SetPostion(glm::vec3(-1206.f, 0.f, player->GetPosition().z));
 				}
 				else if (scenevalue == 5)
 				{
-					scene->FindObjectByName("player")->SetPostion(glm::vec3(-1606.f, 0.f, scene->FindObjectByName("player")->GetPosition().z));
+					player->SetPostion(glm::vec3(-1606.f, 0.f, player->GetPosition().z));
 				}
 				else if (scenevalue == 6)
 				{
-					scene->FindObjectByName("player")->SetPostion(glm::vec3(-2006.f, 0.f, scene->FindObjectByName("player")->GetPosition().z));
+					player->SetPostion(glm::vec3(-2006.f, 0.f, player->GetPosition().z));
 				}
 
 				std::cout << "colision detected";
@@ -10851,14 +10755,14 @@ int main() {
 			//JumpBehaviour test;
 			//test.Update();
 
-			playerCollision.update(scene->FindObjectByName("player")->GetPosition()); // to update
-			//scene->FindObjectByName("player")->Get<JumpBehaviour>()->getPlayerCoords(scene->FindObjectByName("player")->GetPosition()); //send the players coordinates to JumpBehavior so we know when the player is on the ground
+			playerCollision.update(player->GetPosition()); // to update
+			//player->Get<JumpBehaviour>()->getPlayerCoords(player->GetPosition()); //send the players coordinates to JumpBehavior so we know when the player is on the ground
 
 			if (scenevalue == 1)
 			{
-				if (scene->FindObjectByName("player")->GetPosition().x < -800)
+				if (player->GetPosition().x < -800)
 				{
-					scene->FindObjectByName("player")->SetPostion(glm::vec3(-406.f, 0.f, scene->FindObjectByName("player")->GetPosition().z));
+					player->SetPostion(glm::vec3(-406.f, 0.f, player->GetPosition().z));
 					playerMove = false;
 					playerWin = true;
 					result = system->playSound(sound11, 0, false, &channel);
@@ -10866,9 +10770,9 @@ int main() {
 			}
 			else if (scenevalue == 2)
 			{
-				if (scene->FindObjectByName("player")->GetPosition().x < -400)
+				if (player->GetPosition().x < -400)
 				{
-					scene->FindObjectByName("player")->SetPostion(glm::vec3(6.f, 0.f, scene->FindObjectByName("player")->GetPosition().z));
+					player->SetPostion(glm::vec3(6.f, 0.f, player->GetPosition().z));
 					playerMove = false;
 					playerWin = true;
 					result = system->playSound(sound11, 0, false, &channel);
@@ -10876,9 +10780,9 @@ int main() {
 			}
 			else if (scenevalue == 3)
 			{
-				if (scene->FindObjectByName("player")->GetPosition().x < -1200)
+				if (player->GetPosition().x < -1200)
 				{
-					scene->FindObjectByName("player")->SetPostion(glm::vec3(-806.f, 0.f, scene->FindObjectByName("player")->GetPosition().z));
+					player->SetPostion(glm::vec3(-806.f, 0.f, player->GetPosition().z));
 					playerMove = false;
 					playerWin = true;
 					result = system->playSound(sound11, 0, false, &channel);
@@ -10886,9 +10790,9 @@ int main() {
 			}
 			else if (scenevalue == 4)
 			{
-				if (scene->FindObjectByName("player")->GetPosition().x < -1600)
+				if (player->GetPosition().x < -1600)
 				{
-					scene->FindObjectByName("player")->SetPostion(glm::vec3(-1206.f, 0.f, scene->FindObjectByName("player")->GetPosition().z));
+					player->SetPostion(glm::vec3(-1206.f, 0.f, player->GetPosition().z));
 					playerMove = false;
 					playerWin = true;
 					result = system->playSound(sound11, 0, false, &channel);
@@ -10896,9 +10800,9 @@ int main() {
 			}
 			else if (scenevalue == 5)
 			{
-				if (scene->FindObjectByName("player")->GetPosition().x < -2000)
+				if (player->GetPosition().x < -2000)
 				{
-					scene->FindObjectByName("player")->SetPostion(glm::vec3(-1606.f, 0.f, scene->FindObjectByName("player")->GetPosition().z));
+					player->SetPostion(glm::vec3(-1606.f, 0.f, player->GetPosition().z));
 					playerMove = false;
 					playerWin = true;
 					result = system->playSound(sound11, 0, false, &channel);
@@ -10906,9 +10810,9 @@ int main() {
 			}
 			else if (scenevalue == 6)
 			{
-				if (scene->FindObjectByName("player")->GetPosition().x < -2400)
+				if (player->GetPosition().x < -2400)
 				{
-					scene->FindObjectByName("player")->SetPostion(glm::vec3(-2006.f, 0.f, scene->FindObjectByName("player")->GetPosition().z));
+					player->SetPostion(glm::vec3(-2006.f, 0.f, player->GetPosition().z));
 					playerMove = false;
 					playerWin = true;
 					result = system->playSound(sound11, 0, false, &channel);
@@ -10955,20 +10859,22 @@ int main() {
 				//if (glfwGetKey(window, GLFW_KEY_UP)){
 				// Save scene so it can be restored when exiting play mode
 				if (!scene->IsPlaying) {
-					editorSceneState = scene->ToJson();
+					editorSceneState = scene->TakeSnapshot();
 				}
 
 				// Toggle state
 				scene->IsPlaying = !scene->IsPlaying;
 
 				// If we've gone from playing to not playing, restore the state from before we started playing
-				if (!scene->IsPlaying) {
-					scene = nullptr;
-					// We reload to scene from our cached state
-					scene = Scene::FromJson(editorSceneState);
-					// Don't forget to reset the scene's window and wake all the objects!
-					scene->Window = window;
-					scene->Awake();
+				if (!scene->IsPlaying && !scene->RestoreSnapshot(editorSceneState)) {
+					// Objects were removed while playing, so we have to fall back to reloading the scene
+					LOG_WARN("Could not restore the scene in place, reloading from \"{}\"", scene->GetFilePath());
+					std::string path = scene->GetFilePath();
+					if (!path.empty()) {
+						// The cached copy is the scene we just played, so make sure the cache loads a fresh one
+						sceneCache.Remove(path);
+						SceneLoad(scene, path);
+					}
 				}
 			}
 
@@ -10987,9 +10893,11 @@ int main() {
 				scenePath.resize(strlen(scenePath.c_str()));
 
 				// We have loaded a new scene, call awake to set
-				// up all our components
+				// up all our components (scenes from the cache are already awake)
 				scene->Window = window;
-				scene->Awake();
+				if (!scene->GetIsAwake()) {
+					scene->Awake();
+				}
 			}
 			ImGui::Separator();
 			// Draw a dropdown to select our physics debug draw mode
@@ -11046,6 +10954,9 @@ int main() {
 		// Update our worlds physics!
 		scene->DoPhysics(dt);
 
+		// Recalculate the transforms for anything that moved this frame
+		scene->UpdateTransforms();
+
 		// Draw object GUIs
 		if (isDebugWindowOpen) {
 			scene->DrawAllGameObjectGUIs();
@@ -11055,32 +10966,104 @@ int main() {
 		Material::Sptr currentMat = nullptr;
 		Shader::Sptr shader = nullptr;
 
-		// Render all our objects
-		ComponentManager::Each<RenderComponent>([&](const RenderComponent::Sptr& renderable) {
+		// Collect all our objects into the render queue, and sort them to keep state changes down
+		glm::vec3 cameraPos = camera->GetGameObject()->GetPosition();
+		renderQueue.Clear();
+		ComponentManager::Each<RenderComponent>([&](RenderComponent* renderable) {
+			renderQueue.Submit(renderable, cameraPos);
+		});
+		renderQueue.Sort();
+
+		// Upload our camera data and bind the scene's lights, these are shared by all shaders
+		scene->PreRender();
+
+		// Render all our objects, batches of opaque objects sharing a mesh and material are
+		// drawn with a single instanced draw call
+		const std::vector<RenderQueue::DrawCall>& draws = renderQueue.GetDrawCalls();
+		const std::vector<RenderQueue::Batch>& batches = renderQueue.GetBatches();
+
+		// We only have an instanced variant of the scene's base shader
+		auto isInstanced = [&](const RenderQueue::Batch& batch) {
+			return batch.Count > 1 && draws[batch.First].Renderer->GetMaterial()->MatShader == scene->BaseShader;
+		};
+
+		// Gather the transforms for every instanced batch and stream them to the GPU in one
+		// upload, each batch then draws from it's own range of the buffer
+		instanceData.clear();
+		for (const RenderQueue::Batch& batch : batches) {
+			if (isInstanced(batch)) {
+				for (size_t ix = 0; ix < batch.Count; ix++) {
+					GameObject* object = draws[batch.First + ix].Renderer->GetGameObject();
+					instanceData.push_back(InstanceTransform(object->GetTransform(), object->GetNormalMatrix()));
+				}
+			}
+		}
+		if (!instanceData.empty()) {
+			instanceBuffer->LoadData(instanceData.data(), instanceData.size());
+		}
+
+		uint32_t baseInstance = 0;
+		size_t drawCallCount = 0;
+		size_t instancedBatchCount = 0;
+		for (const RenderQueue::Batch& batch : batches) {
+			RenderComponent* renderable = draws[batch.First].Renderer;
+			const Material::Sptr& material = renderable->GetMaterial();
+
+			bool instanced = isInstanced(batch);
+			const Shader::Sptr& batchShader = instanced ? instancedShader : material->MatShader;
 
-			// If the material has changed, we need to bind the new shader and set up our material and frame data
-			// Note: This is a good reason why we should be sorting the render components in ComponentManager
-			if (renderable->GetMaterial() != currentMat) {
-				currentMat = renderable->GetMaterial();
-				shader = currentMat->MatShader;
+			// If the shader has changed, we need to bind it
+			if (batchShader != shader) {
+				shader = batchShader;
 
 				shader->Bind();
-				shader->SetUniform("u_CamPos", scene->MainCamera->GetGameObject()->GetPosition());
-				currentMat->Apply();
+				currentMat = nullptr;
 			}
 
-			// Grab the game object so we can do some stuff with it
-			GameObject* object = renderable->GetGameObject();
+			// If the material has changed, we need to apply the new material's parameters
+			if (material != currentMat) {
+				currentMat = material;
+				currentMat->Apply(shader);
+			}
 
-			// Set vertex shader parameters
-			shader->SetUniformMatrix("u_ModelViewProjection", viewProj * object->GetTransform());
-			shader->SetUniformMatrix("u_Model", object->GetTransform());
-			shader->SetUniformMatrix("u_NormalMatrix", glm::mat3(glm::transpose(glm::inverse(object->GetTransform()))));
+			if (instanced) {
+				// Hook the instance buffer up to the mesh the first time we instance it
+				const VertexArrayObject::Sptr& mesh = renderable->GetMesh();
+				if (mesh->GetInstanceBuffer() != instanceBuffer) {
+					mesh->SetInstanceBuffer(instanceBuffer, InstanceTransform::V_DECL);
+				}
+				mesh->DrawInstanced((uint32_t)batch.Count, baseInstance);
+				baseInstance += (uint32_t)batch.Count;
+				drawCallCount++;
+				instancedBatchCount++;
+			} else {
+				for (size_t ix = 0; ix < batch.Count; ix++) {
+					// Grab the game object so we can do some stuff with it
+					GameObject* object = draws[batch.First + ix].Renderer->GetGameObject();
+
+					// Set vertex shader parameters, the camera comes from the frame uniform block
+					shader->SetUniformMatrix("u_Model", object->GetTransform());
+					shader->SetUniformMatrix("u_NormalMatrix", object->GetNormalMatrix());
+
+					// Animated objects need their current keyframes bound, the bit test keeps us from
+					// copying a shared pointer for every object that isn't animated
+					if (object->Has<Animator>()) {
+						object->Get<Animator>()->Apply(shader);
+					}
 
-			// Draw the object
-			renderable->GetMesh()->Draw();
-			});
+					// Draw the object
+					renderable->GetMesh()->Draw();
+					drawCallCount++;
+				}
+			}
+		}
 
+		// Show how well the queue batched this frame, so we can see if instancing is kicking in
+		if (isDebugWindowOpen) {
+			ImGui::Separator();
+			ImGui::Text("Draw calls: %d (%d objects)", (int)drawCallCount, (int)draws.size());
+			ImGui::Text("Instanced: %d batches, %d objects", (int)instancedBatchCount, (int)baseInstance);
+		}
 
 		// End our ImGui window
 		ImGui::End();